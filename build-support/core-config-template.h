@@ -15,6 +15,7 @@
 #cmakedefine01 HAVE_STDLIB_H
 #cmakedefine01 HAVE_GETENV
 #cmakedefine01 HAVE_SIGNAL_H
+#cmakedefine01 HAVE_SYS_MMAN_H
 #cmakedefine   HAVE_PTHREAD_H
 #cmakedefine   HAVE_RT
 
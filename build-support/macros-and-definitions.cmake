@@ -1072,6 +1072,7 @@ macro(process_options)
   check_include_file_cxx("signal.h" "HAVE_SIGNAL_H")
   check_include_file_cxx("netpacket/packet.h" "HAVE_PACKETH")
   check_include_file_cxx(semaphore.h HAVE_SEMAPHORE_H)
+  check_include_file_cxx("sys/mman.h" "HAVE_SYS_MMAN_H")
   check_function_exists("getenv" "HAVE_GETENV")
 
   configure_file(
@@ -0,0 +1,22 @@
+#ifndef NS3_CORE_CONFIG_H
+#define NS3_CORE_CONFIG_H
+
+/* #undef HAVE_UINT128_T */
+#define HAVE___UINT128_T 1
+#define   INT64X64_USE_128
+/* #undef INT64X64_USE_DOUBLE */
+/* #undef INT64X64_USE_CAIRO */
+#define HAVE_STDINT_H 1
+#define HAVE_INTTYPES_H 1
+/* #undef HAVE_SYS_INT_TYPES_H */
+#define HAVE_SYS_TYPES_H 1
+#define HAVE_SYS_STAT_H 0
+#define HAVE_DIRENT_H 1
+#define HAVE_STDLIB_H 1
+#define HAVE_GETENV 1
+#define HAVE_SIGNAL_H 1
+#define HAVE_SYS_MMAN_H 1
+#define   HAVE_PTHREAD_H
+#define   HAVE_RT
+
+#endif //NS3_CORE_CONFIG_H
@@ -0,0 +1,207 @@
+// -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*-
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef GLOBAL_NEXT_HOP_TABLE_H
+#define GLOBAL_NEXT_HOP_TABLE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "ns3/ipv4-address.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/mapped-file.h"
+#include "prefix-trie.h"
+
+namespace ns3 {
+
+class Ipv4RoutingTableEntry;
+
+/**
+ * \ingroup globalrouting
+ *
+ * \brief Next hops of all the routers to all the vertices of the link
+ * state graph, shared by the Ipv4GlobalRouting instances.
+ *
+ * Instead of a routing table entry per router and per destination, the
+ * global route manager can store the routes of all the routers in a single
+ * dense array, with one row per router and one column per vertex (router
+ * or transit network) of the link state database.  Each cell holds the
+ * first next hop (gateway and output interface) from the router to the
+ * vertex, in 8 bytes.  The destination networks and hosts advertised by
+ * the vertices are indexed once, in a PrefixTrie shared by all the routers.
+ *
+ * A lookup finds the destinations matching an address (host routes first,
+ * then the longest network prefix, then the AS-external routes) which are
+ * advertised by a vertex reachable from the router, and returns the next
+ * hop of the router to this vertex.
+ *
+ * The rows can be saved to a file, and later mapped from this file (see
+ * MappedFile) instead of being computed, if the key of the topology
+ * matches.
+ */
+class GlobalNextHopTable : public SimpleRefCount<GlobalNextHopTable>
+{
+public:
+  /**
+   * \brief Type of a destination
+   */
+  enum DestinationType
+  {
+    HOST = 0,     //!< host address of a point-to-point link
+    NETWORK = 1,  //!< stub or transit network
+    EXTERNAL = 2  //!< AS-external network
+  };
+
+  /**
+   * \brief Next hop from a router to a vertex
+   */
+  struct NextHop
+  {
+    uint32_t gateway;   //!< gateway address, 0 if directly connected
+    uint32_t interface; //!< output interface, NO_INTERFACE if unreachable
+  };
+
+  static const uint32_t NO_INTERFACE = 0xffffffff; //!< interface of the unreachable vertices
+
+  /**
+   * \brief Create a table, with no next hop.
+   * \param nVertices the number of vertices (columns)
+   * \param nRows the number of routers (rows)
+   */
+  GlobalNextHopTable (uint32_t nVertices, uint32_t nRows);
+  ~GlobalNextHopTable ();
+
+  /**
+   * \brief Add a destination
+   * \param network the network or host address
+   * \param mask the network mask
+   * \param type the type of the destination
+   * \param vertex the vertex which advertises the destination
+   */
+  void AddDestination (Ipv4Address network, Ipv4Mask mask, DestinationType type, uint32_t vertex);
+
+  /**
+   * \return the number of destinations
+   */
+  uint32_t GetNDestinations (void) const;
+
+  /**
+   * \return the number of vertices (columns)
+   */
+  uint32_t GetNVertices (void) const;
+
+  /**
+   * \return the number of routers (rows)
+   */
+  uint32_t GetNRows (void) const;
+
+  /**
+   * \brief Set the next hop of a router to a vertex.
+   *
+   * The next hops cannot be changed once the table has been loaded from
+   * a file.  Different rows can be set by different threads.
+   *
+   * \param row the row of the router
+   * \param vertex the vertex
+   * \param gateway the gateway
+   * \param interface the output interface
+   */
+  void SetNextHop (uint32_t row, uint32_t vertex, Ipv4Address gateway, uint32_t interface);
+
+  /**
+   * \brief Look up the next hop of a router to an address.
+   * \param row the row of the router
+   * \param dest the destination address
+   * \param gateway the gateway
+   * \param interface the output interface
+   * \return true if a route was found
+   */
+  bool Lookup (uint32_t row, Ipv4Address dest, Ipv4Address &gateway, uint32_t &interface) const;
+
+  /**
+   * \brief Get the route of a router to a destination, for printing.
+   * \param row the row of the router
+   * \param i the index of the destination
+   * \param route the route
+   * \return true if the destination is reachable from the router
+   */
+  bool GetRoute (uint32_t row, uint32_t i, Ipv4RoutingTableEntry &route) const;
+
+  /**
+   * \brief Save the next hops to a file.
+   * \param filename the name of the file
+   * \param key the key of the topology
+   * \return true if the file was written
+   */
+  bool Save (const std::string &filename, uint64_t key) const;
+
+  /**
+   * \brief Use the next hops saved in a file, if they were computed for
+   * the same topology.
+   * \param filename the name of the file
+   * \param key the key of the topology
+   * \return true if the next hops were loaded
+   */
+  bool Load (const std::string &filename, uint64_t key);
+
+  /**
+   * \return true if the next hops were loaded from a file
+   */
+  bool IsLoaded (void) const;
+
+private:
+  /**
+   * \brief A destination network or host
+   */
+  struct Destination
+  {
+    uint32_t network; //!< network or host address
+    uint32_t mask;    //!< network mask
+    uint32_t vertex;  //!< vertex which advertises the destination
+    uint32_t type;    //!< type of the destination
+  };
+
+  /**
+   * \brief Header of the files of next hops
+   */
+  struct FileHeader
+  {
+    char magic[8];      //!< file type and version
+    uint64_t key;       //!< key of the topology
+    uint32_t nVertices; //!< number of vertices
+    uint32_t nRows;     //!< number of rows
+  };
+
+  /**
+   * \brief Get the next hop of a router to a vertex
+   * \param row the row of the router
+   * \param vertex the vertex
+   * \return the next hop
+   */
+  const NextHop & GetNextHop (uint32_t row, uint32_t vertex) const;
+
+  uint32_t m_nVertices;                  //!< number of vertices
+  uint32_t m_nRows;                      //!< number of rows
+  std::vector<Destination> m_destinations; //!< destinations
+  PrefixTrie<uint32_t> m_destinationIndex; //!< index of the destinations
+  std::vector<NextHop> m_nextHops;       //!< next hops, unless loaded from a file
+  const NextHop *m_rows;                 //!< next hops, row by row
+  MappedFile m_file;                     //!< file of next hops, if loaded
+};
+
+} // namespace ns3
+
+#endif /* GLOBAL_NEXT_HOP_TABLE_H */
@@ -0,0 +1,24 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2021 NITK Surathkal
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * The purpose of this file is to have backwards compatibility with previous
+ * IPv4 Nix Vector Routing examples and usages.
+ *
+ * Authors: Ameya Deshpande <ameyanrd@outlook.com>
+ */
+#pragma GCC warning "NS_DEPRECATED_3_35 - Deprecated header, please use nix-vector-routing.h instead"
+#include "nix-vector-routing.h"
\ No newline at end of file
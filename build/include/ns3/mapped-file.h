@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::MappedFile declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ * \brief A read-only view of the contents of a file.
+ *
+ * On the systems which support it, the file is memory-mapped, so that
+ * opening a large file is immediate and its pages are only read when
+ * they are accessed (and shared with the other processes mapping the
+ * same file).  Otherwise, the whole file is read into memory.
+ */
+class MappedFile
+{
+public:
+  MappedFile ();
+  ~MappedFile ();
+
+  /**
+   * Open a file, closing the file previously opened, if any.
+   *
+   * \param filename the name of the file
+   * \return true if the file could be opened and read
+   */
+  bool Open (const std::string &filename);
+
+  /**
+   * Close the file.  The data previously returned by GetData () is no
+   * longer valid.
+   */
+  void Close (void);
+
+  /**
+   * \return true if a file is open
+   */
+  bool IsOpen (void) const;
+
+  /**
+   * \return the contents of the file, or 0 if no file is open or the file
+   * is empty
+   */
+  const uint8_t * GetData (void) const;
+
+  /**
+   * \return the size of the file, in bytes
+   */
+  uint64_t GetSize (void) const;
+
+  /**
+   * \return true if the file is memory-mapped, false if it was read into
+   * memory
+   */
+  bool IsMapped (void) const;
+
+private:
+  /**
+   * Copy constructor, disallowed.
+   * \param other the object to copy
+   */
+  MappedFile (const MappedFile &other);
+  /**
+   * Assignment operator, disallowed.
+   * \param other the object to copy
+   * \return this object
+   */
+  MappedFile & operator= (const MappedFile &other);
+
+  const uint8_t *m_data;         //!< contents of the file
+  uint64_t m_size;               //!< size of the file
+  bool m_open;                   //!< true if a file is open
+  bool m_mapped;                 //!< true if m_data is a memory mapping
+  std::vector<uint8_t> m_buffer; //!< contents of the file, if not memory-mapped
+};
+
+} // namespace ns3
+
+#endif /* MAPPED_FILE_H */
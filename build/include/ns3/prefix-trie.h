@@ -0,0 +1,617 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PREFIX_TRIE_H
+#define PREFIX_TRIE_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup ipv4Routing
+ *
+ * \brief Longest-prefix-match index of the routes of a routing table.
+ *
+ * A path-compressed binary (Patricia) trie keyed by IPv4 or IPv6 network
+ * prefixes.  Any number of values can be stored under the same prefix, and
+ * each value is tagged with its insertion order.
+ *
+ * Lookup returns the values of all the prefixes matching an address, in
+ * insertion order.  A routing protocol that inserts its routes in the
+ * order of its routing table can therefore apply its usual selection rules
+ * (longest mask, metric, ECMP) to these few candidates, instead of to the
+ * whole table, and get exactly the same result.
+ *
+ * Prefixes with a non-contiguous mask cannot be stored in the trie: they
+ * are kept in a list which is scanned at every lookup.
+ *
+ * Values are inserted and erased in place, in a time proportional to the
+ * length of the prefix, so that a routing table can be kept indexed while
+ * its routes change.  Erasing a value does not change the order of the
+ * others.
+ *
+ * \tparam T the type of the values
+ */
+template <typename T>
+class PrefixTrie
+{
+public:
+  PrefixTrie ();
+
+  /**
+   * \brief Insert a value for an IPv4 network.
+   * \param network the network address
+   * \param mask the network mask
+   * \param value the value
+   */
+  void Insert (Ipv4Address network, Ipv4Mask mask, T value);
+  /**
+   * \brief Insert a value for an IPv6 network.
+   * \param network the network address
+   * \param prefix the network prefix
+   * \param value the value
+   */
+  void Insert (Ipv6Address network, Ipv6Prefix prefix, T value);
+
+  /**
+   * \brief Get the values of all the IPv4 networks containing an address.
+   * \param address the address
+   * \param values the values, in insertion order (the vector is cleared first)
+   */
+  void Lookup (Ipv4Address address, std::vector<T> &values) const;
+  /**
+   * \brief Get the values of all the IPv6 networks containing an address.
+   * \param address the address
+   * \param values the values, in insertion order (the vector is cleared first)
+   */
+  void Lookup (Ipv6Address address, std::vector<T> &values) const;
+
+  /**
+   * \brief Get the values inserted for exactly an IPv4 network.
+   * \param network the network address
+   * \param mask the network mask
+   * \param values the values, in insertion order (the vector is cleared first)
+   */
+  void Find (Ipv4Address network, Ipv4Mask mask, std::vector<T> &values) const;
+  /**
+   * \brief Get the values inserted for exactly an IPv6 network.
+   * \param network the network address
+   * \param prefix the network prefix
+   * \param values the values, in insertion order (the vector is cleared first)
+   */
+  void Find (Ipv6Address network, Ipv6Prefix prefix, std::vector<T> &values) const;
+
+  /**
+   * \brief Erase a value inserted for an IPv4 network.
+   * \param network the network address
+   * \param mask the network mask
+   * \param value the value
+   * \return true if the value was found (only its first occurrence is erased)
+   */
+  bool Erase (Ipv4Address network, Ipv4Mask mask, T value);
+  /**
+   * \brief Erase a value inserted for an IPv6 network.
+   * \param network the network address
+   * \param prefix the network prefix
+   * \param value the value
+   * \return true if the value was found (only its first occurrence is erased)
+   */
+  bool Erase (Ipv6Address network, Ipv6Prefix prefix, T value);
+
+  /**
+   * \brief Remove all the values.
+   */
+  void Clear (void);
+
+  /**
+   * \return the number of values
+   */
+  uint32_t GetN (void) const;
+
+private:
+  /// Length in bytes of the keys, large enough for IPv6 addresses
+  static const uint8_t KEY_SIZE = 16;
+
+  /// A value and its insertion order
+  struct Entry
+  {
+    uint32_t seq; //!< insertion order
+    T value;      //!< the value
+  };
+
+  /// A node of the trie, i.e., the first len bits of a key
+  struct Node
+  {
+    uint8_t key[KEY_SIZE];          //!< the key (only the first len bits are relevant)
+    uint8_t len;                    //!< the prefix length
+    std::vector<Entry> entries;     //!< values stored for this prefix (empty for branch nodes)
+    std::unique_ptr<Node> child[2]; //!< subtries, by value of the bit after the prefix
+  };
+
+  /// A prefix with a non-contiguous mask
+  struct Irregular
+  {
+    uint8_t network[KEY_SIZE]; //!< the masked network address
+    uint8_t mask[KEY_SIZE];    //!< the mask
+    Entry entry;               //!< the value
+  };
+
+  /**
+   * \brief Insert a value for a network.
+   * \param network the network address
+   * \param mask the network mask
+   * \param value the value
+   */
+  void DoInsert (const uint8_t network[KEY_SIZE], const uint8_t mask[KEY_SIZE], T value);
+  /**
+   * \brief Get the values of all the networks containing an address.
+   * \param address the address
+   * \param values the values, in insertion order
+   */
+  void DoLookup (const uint8_t address[KEY_SIZE], std::vector<T> &values) const;
+  /**
+   * \brief Get the values inserted for exactly a network.
+   * \param network the network address
+   * \param mask the network mask
+   * \param values the values, in insertion order
+   */
+  void DoFind (const uint8_t network[KEY_SIZE], const uint8_t mask[KEY_SIZE], std::vector<T> &values) const;
+  /**
+   * \brief Erase a value inserted for a network, and the nodes left useless.
+   * \param network the network address
+   * \param mask the network mask
+   * \param value the value
+   * \return true if the value was found
+   */
+  bool DoErase (const uint8_t network[KEY_SIZE], const uint8_t mask[KEY_SIZE], T value);
+
+  /**
+   * \param mask a mask
+   * \param len the prefix length, if the mask is contiguous
+   * \return true if the mask is contiguous
+   */
+  static bool GetPrefixLength (const uint8_t mask[KEY_SIZE], uint8_t &len);
+  /**
+   * \param a a key
+   * \param b another key
+   * \param limit the maximum length to compare
+   * \return the length of the common prefix of a and b, at most limit
+   */
+  static uint8_t GetCommonLength (const uint8_t a[KEY_SIZE], const uint8_t b[KEY_SIZE], uint8_t limit);
+  /**
+   * \param key a key
+   * \param index the index of a bit
+   * \return the value of the bit, the first bit being the most significant bit of key[0]
+   */
+  static uint8_t GetBit (const uint8_t key[KEY_SIZE], uint8_t index);
+
+  std::unique_ptr<Node> m_root;            //!< root of the trie
+  std::vector<Irregular> m_irregular;      //!< prefixes with a non-contiguous mask
+  uint32_t m_nextSeq;                      //!< insertion order of the next value
+  uint32_t m_nValues;                      //!< number of values
+  mutable std::vector<const Entry *> m_matches; //!< scratch buffer of the lookups
+};
+
+
+/**
+ * Implementation of the templates declared above.
+ */
+
+template <typename T>
+PrefixTrie<T>::PrefixTrie ()
+  : m_nextSeq (0),
+    m_nValues (0)
+{
+}
+
+template <typename T>
+void
+PrefixTrie<T>::Insert (Ipv4Address network, Ipv4Mask mask, T value)
+{
+  uint8_t networkBytes[KEY_SIZE] = {};
+  uint8_t maskBytes[KEY_SIZE] = {};
+  network.Serialize (networkBytes);
+  Ipv4Address (mask.Get ()).Serialize (maskBytes);
+  DoInsert (networkBytes, maskBytes, value);
+}
+
+template <typename T>
+void
+PrefixTrie<T>::Insert (Ipv6Address network, Ipv6Prefix prefix, T value)
+{
+  uint8_t networkBytes[KEY_SIZE];
+  uint8_t maskBytes[KEY_SIZE];
+  network.GetBytes (networkBytes);
+  prefix.GetBytes (maskBytes);
+  DoInsert (networkBytes, maskBytes, value);
+}
+
+template <typename T>
+void
+PrefixTrie<T>::Lookup (Ipv4Address address, std::vector<T> &values) const
+{
+  uint8_t addressBytes[KEY_SIZE] = {};
+  address.Serialize (addressBytes);
+  DoLookup (addressBytes, values);
+}
+
+template <typename T>
+void
+PrefixTrie<T>::Lookup (Ipv6Address address, std::vector<T> &values) const
+{
+  uint8_t addressBytes[KEY_SIZE];
+  address.GetBytes (addressBytes);
+  DoLookup (addressBytes, values);
+}
+
+template <typename T>
+void
+PrefixTrie<T>::Find (Ipv4Address network, Ipv4Mask mask, std::vector<T> &values) const
+{
+  uint8_t networkBytes[KEY_SIZE] = {};
+  uint8_t maskBytes[KEY_SIZE] = {};
+  network.Serialize (networkBytes);
+  Ipv4Address (mask.Get ()).Serialize (maskBytes);
+  DoFind (networkBytes, maskBytes, values);
+}
+
+template <typename T>
+void
+PrefixTrie<T>::Find (Ipv6Address network, Ipv6Prefix prefix, std::vector<T> &values) const
+{
+  uint8_t networkBytes[KEY_SIZE];
+  uint8_t maskBytes[KEY_SIZE];
+  network.GetBytes (networkBytes);
+  prefix.GetBytes (maskBytes);
+  DoFind (networkBytes, maskBytes, values);
+}
+
+template <typename T>
+bool
+PrefixTrie<T>::Erase (Ipv4Address network, Ipv4Mask mask, T value)
+{
+  uint8_t networkBytes[KEY_SIZE] = {};
+  uint8_t maskBytes[KEY_SIZE] = {};
+  network.Serialize (networkBytes);
+  Ipv4Address (mask.Get ()).Serialize (maskBytes);
+  return DoErase (networkBytes, maskBytes, value);
+}
+
+template <typename T>
+bool
+PrefixTrie<T>::Erase (Ipv6Address network, Ipv6Prefix prefix, T value)
+{
+  uint8_t networkBytes[KEY_SIZE];
+  uint8_t maskBytes[KEY_SIZE];
+  network.GetBytes (networkBytes);
+  prefix.GetBytes (maskBytes);
+  return DoErase (networkBytes, maskBytes, value);
+}
+
+template <typename T>
+void
+PrefixTrie<T>::Clear (void)
+{
+  m_root.reset ();
+  m_irregular.clear ();
+  m_nextSeq = 0;
+  m_nValues = 0;
+}
+
+template <typename T>
+uint32_t
+PrefixTrie<T>::GetN (void) const
+{
+  return m_nValues;
+}
+
+template <typename T>
+void
+PrefixTrie<T>::DoInsert (const uint8_t network[KEY_SIZE], const uint8_t mask[KEY_SIZE], T value)
+{
+  Entry entry = { m_nextSeq++, value };
+  m_nValues++;
+  uint8_t len;
+  if (!GetPrefixLength (mask, len))
+    {
+      Irregular irregular;
+      for (uint8_t i = 0; i < KEY_SIZE; i++)
+        {
+          irregular.network[i] = network[i] & mask[i];
+          irregular.mask[i] = mask[i];
+        }
+      irregular.entry = entry;
+      m_irregular.push_back (irregular);
+      return;
+    }
+
+  uint8_t key[KEY_SIZE];
+  for (uint8_t i = 0; i < KEY_SIZE; i++)
+    {
+      key[i] = network[i] & mask[i];
+    }
+
+  std::unique_ptr<Node> *link = &m_root;
+  while (true)
+    {
+      Node *node = link->get ();
+      if (node == 0)
+        {
+          link->reset (new Node);
+          std::memcpy ((*link)->key, key, KEY_SIZE);
+          (*link)->len = len;
+          (*link)->entries.push_back (entry);
+          return;
+        }
+      uint8_t common = GetCommonLength (key, node->key, std::min (len, node->len));
+      if (common == node->len)
+        {
+          // the node is a prefix of the key
+          if (node->len == len)
+            {
+              node->entries.push_back (entry);
+              return;
+            }
+          link = &node->child[GetBit (key, node->len)];
+          continue;
+        }
+      // The key is a prefix of the node, or they diverge after common bits:
+      // a new node of length common becomes the parent of the node
+      std::unique_ptr<Node> parent (new Node);
+      std::memcpy (parent->key, key, KEY_SIZE);
+      parent->len = common;
+      parent->child[GetBit (node->key, common)] = std::move (*link);
+      if (common == len)
+        {
+          parent->entries.push_back (entry);
+        }
+      else
+        {
+          std::unique_ptr<Node> leaf (new Node);
+          std::memcpy (leaf->key, key, KEY_SIZE);
+          leaf->len = len;
+          leaf->entries.push_back (entry);
+          parent->child[GetBit (key, common)] = std::move (leaf);
+        }
+      *link = std::move (parent);
+      return;
+    }
+}
+
+template <typename T>
+void
+PrefixTrie<T>::DoLookup (const uint8_t address[KEY_SIZE], std::vector<T> &values) const
+{
+  values.clear ();
+  m_matches.clear ();
+  const Node *node = m_root.get ();
+  while (node != 0 && GetCommonLength (address, node->key, node->len) == node->len)
+    {
+      for (typename std::vector<Entry>::const_iterator it = node->entries.begin (); it != node->entries.end (); it++)
+        {
+          m_matches.push_back (&(*it));
+        }
+      if (node->len == KEY_SIZE * 8)
+        {
+          break;
+        }
+      node = node->child[GetBit (address, node->len)].get ();
+    }
+  for (typename std::vector<Irregular>::const_iterator it = m_irregular.begin (); it != m_irregular.end (); it++)
+    {
+      bool match = true;
+      for (uint8_t i = 0; i < KEY_SIZE && match; i++)
+        {
+          match = (address[i] & it->mask[i]) == it->network[i];
+        }
+      if (match)
+        {
+          m_matches.push_back (&it->entry);
+        }
+    }
+
+  // Matches are found by increasing prefix length: restore the insertion order
+  std::sort (m_matches.begin (), m_matches.end (),
+             [] (const Entry *a, const Entry *b) { return a->seq < b->seq; });
+  for (typename std::vector<const Entry *>::const_iterator it = m_matches.begin (); it != m_matches.end (); it++)
+    {
+      values.push_back ((*it)->value);
+    }
+}
+
+template <typename T>
+void
+PrefixTrie<T>::DoFind (const uint8_t network[KEY_SIZE], const uint8_t mask[KEY_SIZE], std::vector<T> &values) const
+{
+  values.clear ();
+  uint8_t len;
+  if (!GetPrefixLength (mask, len))
+    {
+      for (typename std::vector<Irregular>::const_iterator it = m_irregular.begin (); it != m_irregular.end (); it++)
+        {
+          bool match = true;
+          for (uint8_t i = 0; i < KEY_SIZE && match; i++)
+            {
+              match = it->mask[i] == mask[i] && it->network[i] == (network[i] & mask[i]);
+            }
+          if (match)
+            {
+              values.push_back (it->entry.value);
+            }
+        }
+      return;
+    }
+
+  const Node *node = m_root.get ();
+  while (node != 0 && node->len <= len && GetCommonLength (network, node->key, node->len) == node->len)
+    {
+      if (node->len == len)
+        {
+          for (typename std::vector<Entry>::const_iterator it = node->entries.begin (); it != node->entries.end (); it++)
+            {
+              values.push_back (it->value);
+            }
+          return;
+        }
+      node = node->child[GetBit (network, node->len)].get ();
+    }
+}
+
+template <typename T>
+bool
+PrefixTrie<T>::DoErase (const uint8_t network[KEY_SIZE], const uint8_t mask[KEY_SIZE], T value)
+{
+  uint8_t len;
+  if (!GetPrefixLength (mask, len))
+    {
+      for (typename std::vector<Irregular>::iterator it = m_irregular.begin (); it != m_irregular.end (); it++)
+        {
+          bool match = it->entry.value == value;
+          for (uint8_t i = 0; i < KEY_SIZE && match; i++)
+            {
+              match = it->mask[i] == mask[i] && it->network[i] == (network[i] & mask[i]);
+            }
+          if (match)
+            {
+              m_irregular.erase (it);
+              m_nValues--;
+              return true;
+            }
+        }
+      return false;
+    }
+
+  // Find the node of the prefix, and the link to its parent
+  std::unique_ptr<Node> *parentLink = 0;
+  std::unique_ptr<Node> *link = &m_root;
+  while (*link && (*link)->len < len && GetCommonLength (network, (*link)->key, (*link)->len) == (*link)->len)
+    {
+      parentLink = link;
+      link = &(*link)->child[GetBit (network, (*link)->len)];
+    }
+  Node *node = link->get ();
+  if (node == 0 || node->len != len || GetCommonLength (network, node->key, len) != len)
+    {
+      return false;
+    }
+  typename std::vector<Entry>::iterator it = node->entries.begin ();
+  while (it != node->entries.end () && !(it->value == value))
+    {
+      it++;
+    }
+  if (it == node->entries.end ())
+    {
+      return false;
+    }
+  node->entries.erase (it);
+  m_nValues--;
+  if (!node->entries.empty ())
+    {
+      return true;
+    }
+
+  // A node without values is only needed to branch to two subtries
+  if (node->child[0] && node->child[1])
+    {
+      return true;
+    }
+  std::unique_ptr<Node> remaining = std::move (node->child[node->child[0] ? 0 : 1]);
+  *link = std::move (remaining);
+  if (parentLink != 0)
+    {
+      Node *parent = parentLink->get ();
+      if (parent->entries.empty () && !(parent->child[0] && parent->child[1]))
+        {
+          remaining = std::move (parent->child[parent->child[0] ? 0 : 1]);
+          *parentLink = std::move (remaining);
+        }
+    }
+  return true;
+}
+
+template <typename T>
+bool
+PrefixTrie<T>::GetPrefixLength (const uint8_t mask[KEY_SIZE], uint8_t &len)
+{
+  len = 0;
+  uint8_t i = 0;
+  while (i < KEY_SIZE && mask[i] == 0xff)
+    {
+      len += 8;
+      i++;
+    }
+  if (i == KEY_SIZE)
+    {
+      return true;
+    }
+  uint8_t byte = mask[i];
+  while (byte & 0x80)
+    {
+      len++;
+      byte <<= 1;
+    }
+  if (byte != 0)
+    {
+      return false;
+    }
+  for (i++; i < KEY_SIZE; i++)
+    {
+      if (mask[i] != 0)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+template <typename T>
+uint8_t
+PrefixTrie<T>::GetCommonLength (const uint8_t a[KEY_SIZE], const uint8_t b[KEY_SIZE], uint8_t limit)
+{
+  for (uint8_t i = 0; i * 8 < limit; i++)
+    {
+      uint8_t diff = a[i] ^ b[i];
+      if (diff != 0)
+        {
+          uint8_t len = i * 8;
+          while ((diff & 0x80) == 0)
+            {
+              len++;
+              diff <<= 1;
+            }
+          return std::min (len, limit);
+        }
+    }
+  return limit;
+}
+
+template <typename T>
+uint8_t
+PrefixTrie<T>::GetBit (const uint8_t key[KEY_SIZE], uint8_t index)
+{
+  return (key[index >> 3] >> (7 - (index & 7))) & 1;
+}
+
+} // namespace ns3
+
+#endif /* PREFIX_TRIE_H */
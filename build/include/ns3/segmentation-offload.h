@@ -0,0 +1,256 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SEGMENTATION_OFFLOAD_H
+#define SEGMENTATION_OFFLOAD_H
+
+#include "ns3/tag.h"
+#include "ns3/packet.h"
+#include "ns3/address.h"
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include <list>
+#include <map>
+
+namespace ns3 {
+
+/**
+ * \ingroup packet
+ *
+ * \brief Tag of a super-segment
+ *
+ * A super-segment is a transport segment larger than the MTU, handed down
+ * by a transport protocol which offloads its segmentation (e.g., TCP
+ * segmentation offload). The devices which support it (see
+ * NetDevice::SupportsSegmentationOffload) split it into frames when they
+ * transmit it, carrying up to the given number of bytes of payload each;
+ * otherwise, the network layer splits it before the device.
+ *
+ * The tag is also found on the packets coalesced by a ReceiveCoalescer.
+ */
+class SegmentationTag : public Tag
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer buf) const;
+  virtual void Deserialize (TagBuffer buf);
+  virtual void Print (std::ostream &os) const;
+
+  SegmentationTag ();
+  /**
+   * Constructor
+   * \param segmentSize the payload size of the segments
+   */
+  SegmentationTag (uint16_t segmentSize);
+
+  /**
+   * \return the payload size of the segments
+   */
+  uint16_t GetSegmentSize (void) const;
+
+private:
+  uint16_t m_segmentSize; //!< Payload size of the segments
+};
+
+/**
+ * \ingroup packet
+ *
+ * \brief Tag of a frame obtained by splitting a super-segment
+ *
+ * It identifies the super-segment and the position of the frame, so that
+ * the receiving device can coalesce the frames again.
+ */
+class CoalescingTag : public Tag
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer buf) const;
+  virtual void Deserialize (TagBuffer buf);
+  virtual void Print (std::ostream &os) const;
+
+  CoalescingTag ();
+  /**
+   * Constructor
+   * \param superSegment the identifier of the super-segment
+   * \param index the index of the frame
+   * \param count the number of frames of the super-segment
+   */
+  CoalescingTag (uint64_t superSegment, uint16_t index, uint16_t count);
+
+  /**
+   * \return the identifier of the super-segment
+   */
+  uint64_t GetSuperSegment (void) const;
+  /**
+   * \return the index of the frame
+   */
+  uint16_t GetIndex (void) const;
+  /**
+   * \return the number of frames of the super-segment
+   */
+  uint16_t GetCount (void) const;
+
+private:
+  uint64_t m_superSegment; //!< Identifier of the super-segment
+  uint16_t m_index;        //!< Index of the frame
+  uint16_t m_count;        //!< Number of frames
+};
+
+/**
+ * \ingroup packet
+ *
+ * \brief Functions which split and coalesce super-segments
+ *
+ * The protocols which know the format of the super-segments register the
+ * functions, by protocol number (EtherType) of the network layer, in the
+ * same way as the offloads of the protocol handlers of Linux. The devices
+ * call them through Segment () and Coalesce () without knowing the headers.
+ */
+class SegmentationOffload
+{
+public:
+  /**
+   * Callback which splits a packet of the network layer into packets
+   * carrying up to the given number of bytes of transport payload
+   */
+  typedef Callback<std::list<Ptr<Packet> >, Ptr<Packet>, uint16_t> SegmentCallback;
+  /**
+   * Callback which coalesces the consecutive packets of the network layer
+   * of a transport flow, returning the resulting packets
+   */
+  typedef Callback<std::list<Ptr<Packet> >, const std::list<Ptr<Packet> > &> CoalesceCallback;
+
+  /**
+   * Register the functions of a protocol of the network layer
+   * \param protocol the protocol number
+   * \param segment the function which splits a super-segment
+   * \param coalesce the function which coalesces frames
+   */
+  static void Register (uint16_t protocol, SegmentCallback segment, CoalesceCallback coalesce);
+
+  /**
+   * Split a super-segment into frames
+   *
+   * The frames carry a CoalescingTag and no SegmentationTag. A packet
+   * without SegmentationTag, or of a protocol which is not registered, is
+   * returned as is.
+   *
+   * \param packet the packet of the network layer
+   * \param protocol the protocol number
+   * \return the frames
+   */
+  static std::list<Ptr<Packet> > Segment (Ptr<const Packet> packet, uint16_t protocol);
+
+  /**
+   * Coalesce frames
+   * \param frames the packets of the network layer, in order of reception
+   * \param protocol the protocol number
+   * \return the coalesced packets, or the frames if the protocol is not
+   *         registered
+   */
+  static std::list<Ptr<Packet> > Coalesce (const std::list<Ptr<Packet> > &frames, uint16_t protocol);
+
+private:
+  /**
+   * \return the registered functions, by protocol number
+   */
+  static std::map<uint16_t, std::pair<SegmentCallback, CoalesceCallback> > &GetRegistry (void);
+};
+
+/**
+ * \ingroup packet
+ *
+ * \brief Coalescing of the received frames of super-segments
+ *
+ * A device passes the packets it receives through the coalescer, which
+ * holds the frames of a super-segment (see CoalescingTag) until its last
+ * frame is received or lost, then coalesces them with
+ * SegmentationOffload::Coalesce and delivers the result, like the generic
+ * receive offload of Linux. The other packets are delivered at once. The
+ * frames of a super-segment are sent back-to-back, so a single
+ * super-segment is held at a time: a frame of another super-segment, or a
+ * packet without tag, flushes the frames held. The devices on which a frame
+ * of a super-segment can be lost without notice (e.g., aborted by the
+ * sender) set a flush timeout: if the next frame is not received within it, the
+ * frames held are delivered anyway.
+ */
+class ReceiveCoalescer
+{
+public:
+  /**
+   * Callback which delivers a packet, with its protocol number and the
+   * address of the sender
+   */
+  typedef Callback<void, Ptr<Packet>, uint16_t, const Address &> DeliverCallback;
+
+  ReceiveCoalescer ();
+
+  /**
+   * \param deliver the callback which delivers the packets
+   */
+  void SetDeliverCallback (DeliverCallback deliver);
+
+  /**
+   * \param timeout the maximum time to wait for the next frame of a
+   *        super-segment, or zero (the default) for no limit
+   */
+  void SetFlushTimeout (Time timeout);
+
+  /**
+   * Receive a packet of the network layer
+   * \param packet the packet
+   * \param protocol the protocol number
+   * \param from the address of the sender
+   */
+  void Receive (Ptr<Packet> packet, uint16_t protocol, const Address &from);
+
+  /**
+   * Notify that a frame has been lost on reception
+   * \param packet the frame
+   */
+  void NotifyDrop (Ptr<const Packet> packet);
+
+  /**
+   * Deliver the frames held
+   */
+  void Flush (void);
+
+private:
+  DeliverCallback m_deliver;       //!< Callback which delivers the packets
+  std::list<Ptr<Packet> > m_frames; //!< Frames held
+  uint64_t m_superSegment;         //!< Super-segment of the frames held
+  uint16_t m_protocol;             //!< Protocol number of the frames held
+  Address m_from;                  //!< Sender of the frames held
+  Time m_timeout;                  //!< Flush timeout
+  EventId m_flushEvent;            //!< Flush timeout event
+};
+
+} // namespace ns3
+
+#endif /* SEGMENTATION_OFFLOAD_H */
@@ -0,0 +1,219 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef SQLITE_BATCH_INSERT_H
+#define SQLITE_BATCH_INSERT_H
+
+#include "sqlite-output.h"
+#include "ns3/assert.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup stats
+ *
+ * \brief Buffered insertion of rows into an SQLite table
+ *
+ * Inserting rows one at a time with SQLiteOutput::SpinExec pays the cost of
+ * preparing the statement and of an implicit transaction (with its journal
+ * sync) for every row. This class prepares the INSERT statement once, buffers
+ * the rows in memory, and writes them in transactions of a configurable
+ * number of rows, resetting and re-binding the same prepared statement for
+ * every row.
+ *
+ * Optionally, full batches are written by a background thread, so that the
+ * simulation only pays for copying the values into the buffer. In that case,
+ * the database connection must not be used by the caller until Flush () has
+ * been called; Flush () blocks until every buffered row has been committed.
+ *
+ * \code
+ *   Ptr<SQLiteOutput> db = Create<SQLiteOutput> ("results.db", "sem");
+ *   db->SetWalMode ();
+ *   db->SpinExec ("CREATE TABLE IF NOT EXISTS rx (time, node, bytes)");
+ *   SQLiteBatchInsert rx (db, "INSERT INTO rx VALUES (?, ?, ?)", 10000, true);
+ *   rx.Insert (Simulator::Now (), nodeId, bytes);
+ *   ...
+ *   rx.Flush ();
+ * \endcode
+ *
+ * Supported value types are the integer types, double, std::string and
+ * Time (stored as seconds, as in SQLiteOutput::Bind).
+ */
+class SQLiteBatchInsert
+{
+public:
+  /**
+   * \brief SQLiteBatchInsert constructor
+   * \param db database to write to
+   * \param cmd INSERT command, with one '?' placeholder per column
+   * \param batchSize number of rows written in each transaction
+   * \param background if true, transactions are committed by a worker thread
+   */
+  SQLiteBatchInsert (const Ptr<SQLiteOutput> &db, const std::string &cmd,
+                     uint32_t batchSize, bool background = false);
+  /**
+   * Destructor; flushes the remaining rows
+   */
+  ~SQLiteBatchInsert ();
+
+  // Delete copy constructor and assignment operator to avoid misuse
+  SQLiteBatchInsert (const SQLiteBatchInsert &) = delete;
+  SQLiteBatchInsert &operator = (const SQLiteBatchInsert &) = delete;
+
+  /**
+   * \brief Buffer a row; the number of values must match the placeholders
+   * of the INSERT command.
+   * \param values the column values, in order
+   */
+  template <typename... Ts>
+  void Insert (const Ts &... values);
+
+  /**
+   * \brief Write all the buffered rows, and wait until they are committed
+   */
+  void Flush ();
+
+  /**
+   * \return the number of rows committed to the database so far
+   */
+  uint64_t GetCommittedRows () const;
+
+  /**
+   * \return the number of columns (placeholders) of the INSERT command
+   */
+  uint32_t GetNColumns () const;
+
+private:
+  /**
+   * \brief A single column value of a buffered row
+   */
+  struct Field
+  {
+    /// Field type
+    enum Type
+    {
+      INTEGER,
+      REAL,
+      TEXT
+    };
+    Type type;          //!< Type of the stored value
+    int64_t integer;    //!< Value, if INTEGER
+    double real;        //!< Value, if REAL
+    std::string text;   //!< Value, if TEXT
+  };
+
+  /// A batch of rows, stored as a flat array of fields
+  typedef std::vector<Field> Batch;
+
+  /**
+   * \brief Append a value to the row being built
+   * \param value the value
+   */
+  template <typename T>
+  void Append (const T &value);
+  /**
+   * \brief Append an integer value to the row being built
+   * \param value the value
+   */
+  void AppendInteger (int64_t value);
+  /**
+   * \brief Append a floating point value to the row being built
+   * \param value the value
+   */
+  void AppendReal (double value);
+  /**
+   * \brief Append a text value to the row being built
+   * \param value the value
+   */
+  void AppendText (const std::string &value);
+
+  /// Close the current row, and hand the batch over if it is full
+  void EndRow ();
+
+  /**
+   * \brief Write a batch inside a single transaction
+   * \param batch the rows to write
+   */
+  void Write (const Batch &batch);
+
+  /// Body of the worker thread
+  void DoWork ();
+
+  Ptr<SQLiteOutput> m_db;                //!< Database
+  sqlite3_stmt *m_stmt {nullptr};        //!< Prepared INSERT statement
+  uint32_t m_nColumns {0};               //!< Placeholders in the statement
+  uint32_t m_batchSize {0};              //!< Rows per transaction
+  uint32_t m_rows {0};                   //!< Rows in m_current
+  Batch m_current;                       //!< Batch being filled
+  uint64_t m_committed {0};              //!< Rows committed so far
+
+  bool m_background {false};             //!< Use the worker thread
+  std::thread m_worker;                  //!< Worker thread
+  mutable std::mutex m_mutex;            //!< Protects the members below
+  std::condition_variable m_cv;          //!< Signals pending work or idleness
+  std::deque<Batch> m_pending;           //!< Batches waiting to be written
+  bool m_busy {false};                   //!< Worker is writing a batch
+  bool m_stop {false};                   //!< Worker must exit
+};
+
+template <typename... Ts>
+void
+SQLiteBatchInsert::Insert (const Ts &... values)
+{
+  NS_ASSERT_MSG (sizeof... (values) == m_nColumns,
+                 "Expected " << m_nColumns << " values, got " << sizeof... (values));
+  (Append (values), ...);
+  EndRow ();
+}
+
+template <typename T>
+void
+SQLiteBatchInsert::Append (const T &value)
+{
+  if constexpr (std::is_integral<T>::value)
+    {
+      AppendInteger (static_cast<int64_t> (value));
+    }
+  else if constexpr (std::is_floating_point<T>::value)
+    {
+      AppendReal (static_cast<double> (value));
+    }
+  else if constexpr (std::is_same<T, Time>::value)
+    {
+      AppendReal (value.GetSeconds ());
+    }
+  else
+    {
+      static_assert (std::is_convertible<T, std::string>::value,
+                     "Unsupported column type");
+      AppendText (value);
+    }
+}
+
+} // namespace ns3
+
+#endif /* SQLITE_BATCH_INSERT_H */
@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TCP_OFFLOAD_H
+#define TCP_OFFLOAD_H
+
+#include "ns3/packet.h"
+#include <list>
+
+namespace ns3 {
+
+/**
+ * \ingroup tcp
+ *
+ * \brief Segmentation and coalescing of TCP super-segments
+ *
+ * The functions split a TCP super-segment (see SegmentationTag), with its
+ * IPv4 or IPv6 header, into segments of the given payload size, and
+ * coalesce the consecutive segments of a connection back, as the TCP
+ * segmentation offload and generic receive offload of Linux do. They are
+ * registered with SegmentationOffload by TcpL4Protocol, and called by the
+ * devices and by the network layer.
+ *
+ * A super-segment is split into segments with consecutive sequence numbers
+ * and the header of the super-segment; the PSH and FIN flags are only set
+ * on the last segment, and the CWR flag on the first. Only data segments
+ * with the ACK, PSH, ECE and CWR flags are coalesced; the coalesced
+ * segment has the header of the last segment, the sequence number of the
+ * first one and the flags of all of them.
+ */
+class TcpOffload
+{
+public:
+  /**
+   * \brief Register the functions with SegmentationOffload
+   */
+  static void Register (void);
+
+  /**
+   * \brief Split an IPv4 TCP super-segment
+   * \param packet the super-segment, with its IPv4 header
+   * \param segmentSize the payload size of the segments
+   * \return the segments, with their IPv4 headers
+   */
+  static std::list<Ptr<Packet> > SegmentIpv4 (Ptr<Packet> packet, uint16_t segmentSize);
+
+  /**
+   * \brief Coalesce IPv4 TCP segments
+   * \param packets the packets, with their IPv4 headers
+   * \return the coalesced packets
+   */
+  static std::list<Ptr<Packet> > CoalesceIpv4 (const std::list<Ptr<Packet> > &packets);
+
+  /**
+   * \brief Split an IPv6 TCP super-segment
+   * \param packet the super-segment, with its IPv6 header
+   * \param segmentSize the payload size of the segments
+   * \return the segments, with their IPv6 headers
+   */
+  static std::list<Ptr<Packet> > SegmentIpv6 (Ptr<Packet> packet, uint16_t segmentSize);
+
+  /**
+   * \brief Coalesce IPv6 TCP segments
+   * \param packets the packets, with their IPv6 headers
+   * \return the coalesced packets
+   */
+  static std::list<Ptr<Packet> > CoalesceIpv6 (const std::list<Ptr<Packet> > &packets);
+};
+
+} // namespace ns3
+
+#endif /* TCP_OFFLOAD_H */
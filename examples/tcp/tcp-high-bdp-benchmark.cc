@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Network topology
+//
+//       n0 ----------- n1
+//            1 Gbps
+//             50 ms
+//
+// This program measures the simulation speed of a bulk transfer over a
+// path with a large bandwidth-delay product, where the TCP buffers hold
+// thousands of segments.  Random losses on the link to n1 keep the sender
+// in SACK loss recovery for a good part of the run, with a large
+// scoreboard, and the receiver with a large out-of-order buffer.
+//
+// Example:
+//
+//     ./ns3 run "tcp-high-bdp-benchmark --dataRate=1Gbps --delay=50ms --errorRate=0.00001 --duration=10"
+//
+// With --tso, the sender hands super-segments of up to 64 KB down to the
+// device, which splits them into frames on the wire, and the receiving
+// device coalesces the frames back (TCP segmentation offload and generic
+// receive offload).
+//
+// The program reports the bytes received, the goodput, the number of
+// simulation events, the wall clock time of the run and the number of
+// simulated segments per wall clock second.
+
+#include <iomanip>
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TcpHighBdpBenchmark");
+
+int
+main (int argc, char *argv[])
+{
+  std::string dataRate = "1Gbps";
+  std::string delay = "50ms";
+  double errorRate = 0.00001;
+  double duration = 10;
+  uint32_t segmentSize = 1448;
+  bool sack = true;
+  bool tso = false;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("dataRate", "Data rate of the link", dataRate);
+  cmd.AddValue ("delay", "One way delay of the link", delay);
+  cmd.AddValue ("errorRate", "Packet error rate of the link to the receiver", errorRate);
+  cmd.AddValue ("duration", "Duration of the transfer, in seconds", duration);
+  cmd.AddValue ("segmentSize", "TCP segment size", segmentSize);
+  cmd.AddValue ("sack", "Enable SACK", sack);
+  cmd.AddValue ("tso", "Enable segmentation offload", tso);
+  cmd.Parse (argc, argv);
+
+  // Size the buffers to twice the bandwidth-delay product
+  DataRate rate (dataRate);
+  Time oneWayDelay (delay);
+  uint64_t bdp = rate.GetBitRate () / 8 * 2 * oneWayDelay.GetSeconds ();
+  uint32_t bufferSize = static_cast<uint32_t> (std::min<uint64_t> (2 * bdp, 1u << 30));
+
+  Config::SetDefault ("ns3::TcpSocket::SegmentSize", UintegerValue (segmentSize));
+  Config::SetDefault ("ns3::TcpSocket::SndBufSize", UintegerValue (bufferSize));
+  Config::SetDefault ("ns3::TcpSocket::RcvBufSize", UintegerValue (bufferSize));
+  Config::SetDefault ("ns3::TcpSocketBase::Sack", BooleanValue (sack));
+  Config::SetDefault ("ns3::TcpSocketBase::SegmentationOffloadSize", UintegerValue (tso ? 65000 : 0));
+
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper pointToPoint;
+  pointToPoint.SetDeviceAttribute ("DataRate", StringValue (dataRate));
+  pointToPoint.SetChannelAttribute ("Delay", StringValue (delay));
+  pointToPoint.SetQueue ("ns3::DropTailQueue", "MaxSize",
+                         QueueSizeValue (QueueSize (QueueSizeUnit::PACKETS, bdp / segmentSize + 1)));
+  NetDeviceContainer devices = pointToPoint.Install (nodes);
+
+  Ptr<RateErrorModel> errorModel = CreateObject<RateErrorModel> ();
+  errorModel->SetUnit (RateErrorModel::ERROR_UNIT_PACKET);
+  errorModel->SetRate (errorRate);
+  devices.Get (1)->SetAttribute ("ReceiveErrorModel", PointerValue (errorModel));
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = ipv4.Assign (devices);
+
+  uint16_t port = 9;
+  BulkSendHelper source ("ns3::TcpSocketFactory", InetSocketAddress (interfaces.GetAddress (1), port));
+  source.SetAttribute ("SendSize", UintegerValue (segmentSize));
+  ApplicationContainer sourceApps = source.Install (nodes.Get (0));
+  sourceApps.Start (Seconds (0.0));
+  sourceApps.Stop (Seconds (duration));
+
+  PacketSinkHelper sink ("ns3::TcpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port));
+  ApplicationContainer sinkApps = sink.Install (nodes.Get (1));
+  sinkApps.Start (Seconds (0.0));
+  sinkApps.Stop (Seconds (duration));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (duration));
+  Simulator::Run ();
+  int64_t ms = clock.End ();
+
+  uint64_t received = DynamicCast<PacketSink> (sinkApps.Get (0))->GetTotalRx ();
+  uint64_t segments = received / segmentSize;
+  std::cout << "Buffers:      " << bufferSize << " bytes" << std::endl;
+  std::cout << "Received:     " << received << " bytes" << std::endl;
+  std::cout << "Goodput:      " << std::fixed << std::setprecision (1)
+            << received * 8 / duration / 1e6 << " Mbps" << std::endl;
+  std::cout << "Events:       " << Simulator::GetEventCount () << std::endl;
+  std::cout << "Wall clock:   " << ms << " ms" << std::endl;
+  std::cout << "Segments/s:   " << std::setprecision (0)
+            << (ms > 0 ? segments * 1000.0 / ms : 0) << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This example measures the latency under load of a bottleneck link managed
+// by FqCoDel or FqCobalt, with and without byte queue limits (BQL) on the
+// bottleneck device.
+//
+// Network topology
+//
+//        access link                    bottleneck link
+// n0 ---------------------- n1 ---------------------------------- n2
+//    10 x bottleneck rate,      bandwidth [1Gbps], delay [10us]
+//    delay [10us]               queue disc in {FqCoDel, FqCobalt} [FqCoDel]
+//                               device queue of netdevicesQueueSize packets [100]
+//                               BQL [false]
+//
+// nFlows bulk TCP flows [4] saturate the bottleneck from n0 to n2, while n0
+// pings n2 every pingInterval [1ms]. Pings are isolated by the flow queueing
+// of the queue disc, so their RTT mostly measures the time spent in the
+// device queue, which BQL is expected to reduce.
+//
+// The output is a single line with the RTT statistics of the pings received
+// after the warmup period, in milliseconds, and the average goodput of the
+// bulk flows:
+//
+//   FqCoDel bql=0 1Gbps pings=<n> mean=<ms> p50=<ms> p99=<ms> max=<ms> goodput=<Mbps>
+//
+// With --csv, the same values and the RngRun value are printed as a
+// comma-separated line, preceded by a line with the names of the columns.
+// utils/bql-benchmark.py runs this program for several queue discs and rates
+// and collects these lines.
+//
+// Example:
+//
+//   ./ns3 run "bql-latency-benchmark --bandwidth=10Gbps --bql=1 --simDuration=0.5"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/internet-apps-module.h"
+#include "ns3/traffic-control-module.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("BqlLatencyBenchmark");
+
+static std::vector<double> g_rtts; //!< RTT of the pings, in ms
+static Time g_warmup;              //!< Pings received before are ignored
+
+static void
+PingRtt (Time rtt)
+{
+  if (Simulator::Now () >= g_warmup)
+    {
+      g_rtts.push_back (rtt.GetSeconds () * 1000);
+    }
+}
+
+/**
+ * Get a percentile of sorted samples.
+ * \param sorted the samples, in increasing order
+ * \param p the percentile, between 0 and 100
+ * \return the percentile
+ */
+static double
+Percentile (const std::vector<double> &sorted, double p)
+{
+  if (sorted.empty ())
+    {
+      return 0;
+    }
+  std::size_t index = static_cast<std::size_t> (p / 100 * (sorted.size () - 1) + 0.5);
+  return sorted[index];
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string bandwidth = "1Gbps";
+  std::string delay = "10us";
+  std::string queueDiscType = "FqCoDel";
+  uint32_t netdevicesQueueSize = 100;
+  bool bql = false;
+  uint32_t nFlows = 4;
+  Time pingInterval = MilliSeconds (1);
+  double warmup = 0.2;
+  double simDuration = 2;
+  bool csv = false;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("bandwidth", "Bottleneck bandwidth", bandwidth);
+  cmd.AddValue ("delay", "Delay of each link", delay);
+  cmd.AddValue ("queueDiscType", "Bottleneck queue disc type in {FqCoDel, FqCobalt}", queueDiscType);
+  cmd.AddValue ("netdevicesQueueSize", "Bottleneck netdevices queue size in packets", netdevicesQueueSize);
+  cmd.AddValue ("bql", "Enable byte queue limits on the bottleneck netdevices", bql);
+  cmd.AddValue ("nFlows", "Number of bulk TCP flows", nFlows);
+  cmd.AddValue ("pingInterval", "Interval between pings", pingInterval);
+  cmd.AddValue ("warmup", "Time in seconds before which the pings are ignored", warmup);
+  cmd.AddValue ("simDuration", "Simulation duration in seconds", simDuration);
+  cmd.AddValue ("csv", "Print the results as a comma-separated line", csv);
+  cmd.Parse (argc, argv);
+
+  g_warmup = Seconds (warmup);
+  DataRate bottleneckRate (bandwidth);
+  DataRate accessRate (bottleneckRate.GetBitRate () * 10);
+
+  // Large enough buffers to fill the fastest links
+  Config::SetDefault ("ns3::TcpSocket::SegmentSize", UintegerValue (1448));
+  Config::SetDefault ("ns3::TcpSocket::SndBufSize", UintegerValue (1 << 25));
+  Config::SetDefault ("ns3::TcpSocket::RcvBufSize", UintegerValue (1 << 25));
+
+  NodeContainer nodes;
+  nodes.Create (3);
+
+  PointToPointHelper accessLink;
+  accessLink.SetDeviceAttribute ("DataRate", DataRateValue (accessRate));
+  accessLink.SetChannelAttribute ("Delay", StringValue (delay));
+
+  PointToPointHelper bottleneckLink;
+  bottleneckLink.SetDeviceAttribute ("DataRate", DataRateValue (bottleneckRate));
+  bottleneckLink.SetChannelAttribute ("Delay", StringValue (delay));
+  bottleneckLink.SetQueue ("ns3::DropTailQueue", "MaxSize",
+                           QueueSizeValue (QueueSize (QueueSizeUnit::PACKETS, netdevicesQueueSize)));
+
+  InternetStackHelper stack;
+  stack.Install (nodes);
+
+  NetDeviceContainer accessDevices = accessLink.Install (nodes.Get (0), nodes.Get (1));
+  NetDeviceContainer bottleneckDevices = bottleneckLink.Install (nodes.Get (1), nodes.Get (2));
+
+  TrafficControlHelper tchBottleneck;
+  if (queueDiscType == "FqCoDel")
+    {
+      tchBottleneck.SetRootQueueDisc ("ns3::FqCoDelQueueDisc");
+    }
+  else if (queueDiscType == "FqCobalt")
+    {
+      tchBottleneck.SetRootQueueDisc ("ns3::FqCobaltQueueDisc");
+    }
+  else
+    {
+      NS_ABORT_MSG ("--queueDiscType not valid");
+    }
+  if (bql)
+    {
+      tchBottleneck.SetQueueLimits ("ns3::DynamicQueueLimits");
+    }
+  tchBottleneck.Install (bottleneckDevices);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  address.Assign (accessDevices);
+  address.SetBase ("10.1.2.0", "255.255.255.0");
+  Ipv4InterfaceContainer bottleneckInterfaces = address.Assign (bottleneckDevices);
+
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  uint16_t port = 50000;
+  PacketSinkHelper sinkHelper ("ns3::TcpSocketFactory",
+                               InetSocketAddress (Ipv4Address::GetAny (), port));
+  ApplicationContainer sinkApp = sinkHelper.Install (nodes.Get (2));
+  sinkApp.Start (Seconds (0));
+
+  BulkSendHelper bulkHelper ("ns3::TcpSocketFactory",
+                             InetSocketAddress (bottleneckInterfaces.GetAddress (1), port));
+  ApplicationContainer bulkApps;
+  for (uint32_t i = 0; i < nFlows; i++)
+    {
+      bulkApps.Add (bulkHelper.Install (nodes.Get (0)));
+    }
+  bulkApps.Start (Seconds (0.01));
+
+  V4PingHelper ping (bottleneckInterfaces.GetAddress (1));
+  ping.SetAttribute ("Interval", TimeValue (pingInterval));
+  ApplicationContainer pingApp = ping.Install (nodes.Get (0));
+  pingApp.Start (Seconds (0.01));
+  pingApp.Get (0)->TraceConnectWithoutContext ("Rtt", MakeCallback (&PingRtt));
+
+  Simulator::Stop (Seconds (simDuration));
+  Simulator::Run ();
+
+  double goodput = DynamicCast<PacketSink> (sinkApp.Get (0))->GetTotalRx () * 8 / simDuration / 1e6;
+
+  std::sort (g_rtts.begin (), g_rtts.end ());
+  double mean = g_rtts.empty () ? 0 : std::accumulate (g_rtts.begin (), g_rtts.end (), 0.0) / g_rtts.size ();
+  double max = g_rtts.empty () ? 0 : g_rtts.back ();
+
+  std::cout << std::fixed << std::setprecision (3);
+  if (csv)
+    {
+      std::cout << "queueDisc,bql,bandwidth,run,pings,meanMs,p50Ms,p99Ms,maxMs,goodputMbps" << std::endl;
+      std::cout << queueDiscType << "," << bql << "," << bandwidth << "," << RngSeedManager::GetRun ()
+                << "," << g_rtts.size () << "," << mean << "," << Percentile (g_rtts, 50) << "," << Percentile (g_rtts, 99)
+                << "," << max << "," << goodput << std::endl;
+    }
+  else
+    {
+      std::cout << queueDiscType << " bql=" << bql << " " << bandwidth
+                << " pings=" << g_rtts.size () << " mean=" << mean
+                << " p50=" << Percentile (g_rtts, 50) << " p99=" << Percentile (g_rtts, 99)
+                << " max=" << max << " goodput=" << goodput << "Mbps" << std::endl;
+    }
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -12,6 +12,8 @@ cpp_examples = [
     ("red-vs-nlred", "True", "True"),
     ("red-vs-fengadaptive", "True", "True"),
     ("queue-discs-benchmark --simDuration=10", "True", "True"),
+    ("bql-latency-benchmark --simDuration=0.2 --warmup=0.05", "True", "False"),
+    ("bql-latency-benchmark --simDuration=0.2 --warmup=0.05 --bql=1 --queueDiscType=FqCobalt", "True", "False"),
 ]
 
 # A list of Python examples to run in order to ensure that they remain
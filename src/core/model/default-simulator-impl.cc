@@ -399,6 +399,12 @@ DefaultSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+void
+DefaultSimulatorImpl::SetContext (uint32_t context)
+{
+  m_currentContext = context;
+}
+
 uint64_t
 DefaultSimulatorImpl::GetEventCount (void) const
 {
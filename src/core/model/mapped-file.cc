@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mapped-file.h"
+#include "log.h"
+#include "ns3/core-config.h"
+
+#include <fstream>
+
+#if HAVE_SYS_MMAN_H
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* HAVE_SYS_MMAN_H */
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::MappedFile implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MappedFile");
+
+MappedFile::MappedFile ()
+  : m_data (0),
+    m_size (0),
+    m_open (false),
+    m_mapped (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MappedFile::~MappedFile ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+bool
+MappedFile::Open (const std::string &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Close ();
+#if HAVE_SYS_MMAN_H
+  int fd = open (filename.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      NS_LOG_LOGIC ("Cannot open " << filename);
+      return false;
+    }
+  struct stat st;
+  if (fstat (fd, &st) < 0)
+    {
+      close (fd);
+      return false;
+    }
+  m_size = st.st_size;
+  if (m_size > 0)
+    {
+      void *data = mmap (0, m_size, PROT_READ, MAP_SHARED, fd, 0);
+      if (data != MAP_FAILED)
+        {
+          m_data = static_cast<const uint8_t *> (data);
+          m_mapped = true;
+        }
+    }
+  close (fd);
+  if (m_size == 0 || m_mapped)
+    {
+      m_open = true;
+      return true;
+    }
+  NS_LOG_LOGIC ("Cannot map " << filename << ", reading it");
+#endif /* HAVE_SYS_MMAN_H */
+  std::ifstream file (filename.c_str (), std::ios::in | std::ios::binary);
+  if (!file)
+    {
+      NS_LOG_LOGIC ("Cannot open " << filename);
+      return false;
+    }
+  file.seekg (0, std::ios::end);
+  m_size = file.tellg ();
+  file.seekg (0, std::ios::beg);
+  m_buffer.resize (m_size);
+  if (m_size > 0 && !file.read (reinterpret_cast<char *> (&m_buffer[0]), m_size))
+    {
+      m_buffer.clear ();
+      m_size = 0;
+      return false;
+    }
+  m_data = m_size > 0 ? &m_buffer[0] : 0;
+  m_open = true;
+  return true;
+}
+
+void
+MappedFile::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+#if HAVE_SYS_MMAN_H
+  if (m_mapped)
+    {
+      munmap (const_cast<uint8_t *> (m_data), m_size);
+    }
+#endif /* HAVE_SYS_MMAN_H */
+  std::vector<uint8_t> ().swap (m_buffer);
+  m_data = 0;
+  m_size = 0;
+  m_open = false;
+  m_mapped = false;
+}
+
+bool
+MappedFile::IsOpen (void) const
+{
+  return m_open;
+}
+
+const uint8_t *
+MappedFile::GetData (void) const
+{
+  return m_data;
+}
+
+uint64_t
+MappedFile::GetSize (void) const
+{
+  return m_size;
+}
+
+bool
+MappedFile::IsMapped (void) const
+{
+  return m_mapped;
+}
+
+} // namespace ns3
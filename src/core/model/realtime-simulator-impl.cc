@@ -805,6 +805,12 @@ RealtimeSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+void
+RealtimeSimulatorImpl::SetContext (uint32_t context)
+{
+  m_currentContext = context;
+}
+
 uint64_t
 RealtimeSimulatorImpl::GetEventCount (void) const
 {
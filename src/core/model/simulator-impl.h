@@ -99,6 +99,18 @@ public:
   virtual uint32_t GetSystemId () const = 0;
   /** \copydoc Simulator::GetContext */
   virtual uint32_t GetContext (void) const = 0;
+  /**
+   * Set the current simulation context.
+   *
+   * This is meant for models which, in a single event, act on behalf of
+   * several nodes (for instance a channel delivering a packet to all its
+   * devices), so that each part of the event runs, and schedules its own
+   * events, in the context of its node. The caller is responsible for
+   * restoring the context of the event afterwards.
+   *
+   * \param [in] context The new simulation context.
+   */
+  virtual void SetContext (uint32_t context) = 0;
   /** \copydoc Simulator::GetEventCount */
   virtual uint64_t GetEventCount (void) const = 0;
 
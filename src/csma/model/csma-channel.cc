@@ -22,7 +22,10 @@
 #include "csma-net-device.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/simulator-impl.h"
 #include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/ethernet-header.h"
 
 namespace ns3 {
 
@@ -46,6 +49,13 @@ CsmaChannel::GetTypeId (void)
                    TimeValue (Seconds (0)),
                    MakeTimeAccessor (&CsmaChannel::m_delay),
                    MakeTimeChecker ())
+    .AddAttribute ("SharedDelivery",
+                   "Deliver each packet to all the attached devices in a single "
+                   "event, instead of scheduling one reception event per device. "
+                   "Each reception still runs in the context of its node.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&CsmaChannel::m_sharedDelivery),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -56,6 +66,7 @@ CsmaChannel::CsmaChannel ()
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_state = IDLE;
+  m_sharedDelivery = false;
   m_deviceList.clear ();
 }
 
@@ -219,6 +230,12 @@ CsmaChannel::TransmitEnd ()
 
   NS_LOG_LOGIC ("Schedule event in " << m_delay.As (Time::S));
 
+  if (m_sharedDelivery)
+    {
+      // a single event delivers the packet and releases the channel
+      Simulator::Schedule (m_delay, &CsmaChannel::SharedDeliveryEvent, this);
+      return retVal;
+    }
 
   NS_LOG_LOGIC ("Receive");
 
@@ -243,6 +260,50 @@ CsmaChannel::TransmitEnd ()
   return retVal;
 }
 
+bool
+CsmaChannel::IsReceiver (CsmaDeviceRec &rec, Mac48Address destination)
+{
+  return rec.IsActive ()
+         && rec.devicePtr != m_deviceList[m_currentSrc].devicePtr
+         && rec.devicePtr->IsInterested (destination);
+}
+
+void
+CsmaChannel::SharedDeliveryEvent (void)
+{
+  NS_LOG_FUNCTION (this << m_currentPkt);
+  NS_ASSERT (m_state == PROPAGATING);
+
+  //
+  // Devices are filtered on the destination address before the packet is
+  // copied for them.
+  //
+  EthernetHeader header (false);
+  m_currentPkt->PeekHeader (header);
+  Mac48Address destination = header.GetDestination ();
+
+  //
+  // Each reception runs in the context of the node of the receiving device,
+  // as it would in its own event.  Receivers may attach new devices to the
+  // channel, hence the index.  Each receiver gets a copy-on-write copy of the
+  // packet, since devices remove the headers of the packets they receive.
+  //
+  Ptr<SimulatorImpl> simulator = Simulator::GetImplementation ();
+  uint32_t context = simulator->GetContext ();
+  Ptr<CsmaNetDevice> sender = m_deviceList[m_currentSrc].devicePtr;
+  for (std::size_t i = 0; i < m_deviceList.size (); i++)
+    {
+      if (IsReceiver (m_deviceList[i], destination))
+        {
+          simulator->SetContext (m_deviceList[i].devicePtr->GetNode ()->GetId ());
+          m_deviceList[i].devicePtr->Receive (m_currentPkt->Copy (), sender);
+        }
+    }
+  simulator->SetContext (context);
+
+  PropagationCompleteEvent ();
+}
+
 void
 CsmaChannel::PropagationCompleteEvent ()
 {
@@ -25,6 +25,7 @@
 #include "ns3/ptr.h"
 #include "ns3/nstime.h"
 #include "ns3/data-rate.h"
+#include "ns3/mac48-address.h"
 
 namespace ns3 {
 
@@ -86,6 +87,14 @@ enum WireState
  * flag to indicate if the channel is currently in use. It does not
  * take into account the distances between stations or the speed of
  * light to determine collisions.
+ *
+ * At the end of a transmission, a reception event is scheduled for each
+ * active device, with its own copy of the packet. If the SharedDelivery
+ * attribute is set, a single event delivers the packet, when the propagation
+ * is complete, to the devices that may process it, in the context of the
+ * node of each device: the sender and the devices for which a frame sent to
+ * another unicast address would have no visible effect are skipped (see
+ * CsmaNetDevice::IsInterested).
  */
 class CsmaChannel : public Channel 
 {
@@ -308,6 +317,28 @@ private:
    */
   CsmaChannel &operator = (CsmaChannel const &o);
 
+  /**
+   * \brief Deliver the current packet to all the attached net devices
+   * and release the channel.
+   *
+   * This is the single event scheduled by TransmitEnd for each packet when
+   * shared delivery is enabled.
+   *
+   * Each device is switched to in turn, with the simulation context of its
+   * node, as if it received the packet in its own event.
+   */
+  void SharedDeliveryEvent (void);
+
+  /**
+   * \brief Check whether a packet must be handed to a device.
+   *
+   * \param rec the device record
+   * \param destination the destination address of the packet
+   * \return true if the device is active, is not the sender of the packet
+   * and may process a packet for this destination
+   */
+  bool IsReceiver (CsmaDeviceRec &rec, Mac48Address destination);
+
   /**
    * The assigned data rate of the channel
    */
@@ -318,6 +349,11 @@ private:
    */
   Time          m_delay;
 
+  /**
+   * Deliver each packet to all the devices in a single event
+   */
+  bool          m_sharedDelivery;
+
   /**
    * List of the net devices that have been or are currently connected
    * to the channel.
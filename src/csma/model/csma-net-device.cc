@@ -20,6 +20,8 @@
 
 #include "ns3/log.h"
 #include "ns3/queue.h"
+#include "ns3/fluid-queue.h"
+#include "ns3/net-device-queue-interface.h"
 #include "ns3/simulator.h"
 #include "ns3/ethernet-header.h"
 #include "ns3/ethernet-trailer.h"
@@ -72,6 +74,13 @@ CsmaNetDevice::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&CsmaNetDevice::m_receiveEnable),
                    MakeBooleanChecker ())
+    .AddAttribute ("ReceiveCoalescing",
+                   "Whether the received frames of a super-segment are "
+                   "coalesced before being forwarded up the stack, like "
+                   "the generic receive offload of Linux.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&CsmaNetDevice::m_receiveCoalescing),
+                   MakeBooleanChecker ())
     .AddAttribute ("ReceiveErrorModel", 
                    "The receiver error model used to simulate packet loss",
                    PointerValue (),
@@ -190,6 +199,9 @@ CsmaNetDevice::CsmaNetDevice ()
   m_txMachineState = READY;
   m_tInterframeGap = Seconds (0);
   m_channel = 0;
+  m_fluidQueueCheck = 0;
+  m_receiveCoalescing = true;
+  m_rxCoalescer.SetDeliverCallback (MakeCallback (&CsmaNetDevice::ForwardUp, this));
 
   // 
   // We would like to let the attribute system take care of initializing the 
@@ -218,9 +230,52 @@ CsmaNetDevice::DoDispose ()
   m_channel = 0;
   m_node = 0;
   m_queue = 0;
+  m_fluidQueue = 0;
+  m_fluidQueueCheck = 0;
+  m_netDeviceQueue = 0;
+  m_txFrames.clear ();
+  m_txSuperSegment = 0;
   NetDevice::DoDispose ();
 }
 
+void
+CsmaNetDevice::NotifyNewAggregate (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  if (m_netDeviceQueue == 0)
+    {
+      Ptr<NetDeviceQueueInterface> ndqi = GetObject<NetDeviceQueueInterface> ();
+      if (ndqi != 0)
+        {
+          m_netDeviceQueue = ndqi->GetTxQueue (0);
+          m_netDeviceQueue->SetTxCompletionByDevice (true);
+        }
+    }
+  NetDevice::NotifyNewAggregate ();
+}
+
+void
+CsmaNetDevice::NotifyTxCompletion (Ptr<const Packet> p)
+{
+  //
+  // The queue limits account for the super-segment dequeued, so report it
+  // once the device is done with its last frame.
+  //
+  if (m_txSuperSegment != 0)
+    {
+      if (!m_txFrames.empty ())
+        {
+          return;
+        }
+      p = m_txSuperSegment;
+      m_txSuperSegment = 0;
+    }
+  if (m_netDeviceQueue != 0)
+    {
+      m_netDeviceQueue->NotifyTransmittedBytes (p->GetSize ());
+    }
+}
+
 void
 CsmaNetDevice::SetEncapsulationMode (enum EncapsulationMode mode)
 {
@@ -456,6 +511,7 @@ CsmaNetDevice::TransmitStart (void)
   if (IsSendEnabled () == false)
     {
       m_phyTxDropTrace (m_currentPkt);
+      NotifyTxCompletion (m_currentPkt);
       m_currentPkt = 0;
       return;
     }
@@ -469,6 +525,20 @@ CsmaNetDevice::TransmitStart (void)
   NS_ASSERT_MSG ((m_txMachineState == READY) || (m_txMachineState == BACKOFF), 
                  "Must be READY to transmit. Tx state is: " << m_txMachineState);
 
+  //
+  // With a FluidQueue, the packet cannot leave before the background traffic
+  // queued ahead of it has been drained.  Wait in the BACKOFF state, without
+  // counting a retry, and sense the medium afterwards.
+  //
+  if (m_fluidQueue && m_fluidQueue->GetReadyTime () > Simulator::Now ())
+    {
+      Time wait = m_fluidQueue->GetReadyTime () - Simulator::Now ();
+      NS_LOG_LOGIC ("Background backlog, wait for " << wait.As (Time::S));
+      m_txMachineState = BACKOFF;
+      Simulator::Schedule (wait, &CsmaNetDevice::TransmitStart, this);
+      return;
+    }
+
   //
   // Now we have to sense the state of the medium and either start transmitting
   // if it is idle, or backoff our transmission if someone else is on the wire.
@@ -510,6 +580,7 @@ CsmaNetDevice::TransmitStart (void)
         {
           NS_LOG_WARN ("Channel TransmitStart returns an error");
           m_phyTxDropTrace (m_currentPkt);
+          NotifyTxCompletion (m_currentPkt);
           m_currentPkt = 0;
           m_txMachineState = READY;
         } 
@@ -543,6 +614,7 @@ CsmaNetDevice::TransmitAbort (void)
   NS_LOG_LOGIC ("Pkt UID is " << m_currentPkt->GetUid () << ")");
 
   m_phyTxDropTrace (m_currentPkt);
+  NotifyTxCompletion (m_currentPkt);
   m_currentPkt = 0;
 
   NS_ASSERT_MSG (m_txMachineState == BACKOFF, "Must be in BACKOFF state to abort.  Tx state is: " << m_txMachineState);
@@ -559,13 +631,13 @@ CsmaNetDevice::TransmitAbort (void)
   // get that out.  If the queue is empty we just wait until someone puts one
   // in.
   //
-  if (m_queue->IsEmpty ())
+  if (m_txFrames.empty () && m_queue->IsEmpty ())
     {
       return;
     }
   else
     {
-      Ptr<Packet> packet = m_queue->Dequeue ();
+      Ptr<Packet> packet = DequeueFrame ();
       NS_ASSERT_MSG (packet != 0, "CsmaNetDevice::TransmitAbort(): IsEmpty false but no Packet on queue?");
       m_currentPkt = packet;
       m_snifferTrace (m_currentPkt);
@@ -599,6 +671,7 @@ CsmaNetDevice::TransmitCompleteEvent (void)
 
   m_channel->TransmitEnd (); 
   m_phyTxEndTrace (m_currentPkt);
+  NotifyTxCompletion (m_currentPkt);
   m_currentPkt = 0;
 
   NS_LOG_LOGIC ("Schedule TransmitReadyEvent in " << m_tInterframeGap.As (Time::S));
@@ -628,13 +701,13 @@ CsmaNetDevice::TransmitReadyEvent (void)
   //
   // Get the next packet from the queue for transmitting
   //
-  if (m_queue->IsEmpty ())
+  if (m_txFrames.empty () && m_queue->IsEmpty ())
     {
       return;
     }
   else
     {
-      Ptr<Packet> packet = m_queue->Dequeue ();
+      Ptr<Packet> packet = DequeueFrame ();
       NS_ASSERT_MSG (packet != 0, "CsmaNetDevice::TransmitReadyEvent(): IsEmpty false but no Packet on queue?");
       m_currentPkt = packet;
       m_snifferTrace (m_currentPkt);
@@ -662,6 +735,18 @@ CsmaNetDevice::Attach (Ptr<CsmaChannel> ch)
   //
   m_tInterframeGap = m_bps.CalculateBytesTxTime (96/8);
 
+  //
+  // The frames of a super-segment follow each other once the channel is
+  // idle again, i.e., after the propagation delay and the interframe gap,
+  // unless another device seizes the channel meanwhile.  Do not wait for
+  // the next frame for more than a few frame times, in case the sender
+  // aborts it.
+  //
+  m_rxCoalescer.SetFlushTimeout (4 * (m_bps.CalculateBytesTxTime (GetMtu () + 26)
+                                      + m_channel->GetDelay () + m_tInterframeGap));
+
+  UpdateFluidQueue ();
+
   //
   // This device is up whenever a channel is attached to it.
   //
@@ -674,6 +759,25 @@ CsmaNetDevice::SetQueue (Ptr<Queue<Packet> > q)
 {
   NS_LOG_FUNCTION (q);
   m_queue = q;
+  UpdateFluidQueue ();
+}
+
+void
+CsmaNetDevice::UpdateFluidQueue (void)
+{
+  //
+  // The queue may also have been replaced through the TxQueue attribute, so
+  // look again for a FluidQueue whenever it changes.
+  //
+  if (PeekPointer (m_queue) != m_fluidQueueCheck)
+    {
+      m_fluidQueueCheck = PeekPointer (m_queue);
+      m_fluidQueue = DynamicCast<FluidQueue<Packet> > (m_queue);
+    }
+  if (m_fluidQueue)
+    {
+      m_fluidQueue->SetLinkRate (m_bps);
+    }
 }
 
 void
@@ -710,6 +814,7 @@ CsmaNetDevice::Receive (Ptr<Packet> packet, Ptr<CsmaNetDevice> senderDevice)
   if (IsReceiveEnabled () == false)
     {
       m_phyRxDropTrace (packet);
+      m_rxCoalescer.NotifyDrop (packet);
       return;
     }
 
@@ -717,6 +822,7 @@ CsmaNetDevice::Receive (Ptr<Packet> packet, Ptr<CsmaNetDevice> senderDevice)
     {
       NS_LOG_LOGIC ("Dropping pkt due to error model ");
       m_phyRxDropTrace (packet);
+      m_rxCoalescer.NotifyDrop (packet);
       return;
     }
 
@@ -738,6 +844,7 @@ CsmaNetDevice::Receive (Ptr<Packet> packet, Ptr<CsmaNetDevice> senderDevice)
     {
       NS_LOG_INFO ("CRC error on Packet " << packet);
       m_phyRxDropTrace (packet);
+      m_rxCoalescer.NotifyDrop (packet);
       return;
     }
 
@@ -816,10 +923,80 @@ CsmaNetDevice::Receive (Ptr<Packet> packet, Ptr<CsmaNetDevice> senderDevice)
     {
       m_snifferTrace (originalPacket);
       m_macRxTrace (originalPacket);
-      m_rxCallback (this, packet, protocol, header.GetSource ());
+      if (m_receiveCoalescing)
+        {
+          m_rxCoalescer.Receive (packet, protocol, header.GetSource ());
+        }
+      else
+        {
+          CoalescingTag tag;
+          packet->RemovePacketTag (tag);
+          m_rxCallback (this, packet, protocol, header.GetSource ());
+        }
     }
 }
 
+void
+CsmaNetDevice::ForwardUp (Ptr<Packet> packet, uint16_t protocol, const Address &from)
+{
+  NS_LOG_FUNCTION (packet << protocol << from);
+  m_rxCallback (this, packet, protocol, from);
+}
+
+Ptr<Packet>
+CsmaNetDevice::DequeueFrame (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  if (!m_txFrames.empty ())
+    {
+      Ptr<Packet> frame = m_txFrames.front ();
+      m_txFrames.pop_front ();
+      return frame;
+    }
+
+  Ptr<Packet> p = m_queue->Dequeue ();
+  SegmentationTag tag;
+  if (p == 0 || !p->PeekPacketTag (tag))
+    {
+      return p;
+    }
+
+  //
+  // Split the super-segment below the Ethernet header and trailer, and
+  // encapsulate every frame the same way.  Super-segments are only handed
+  // to devices in DIX mode, so there is no LLC/SNAP header.
+  //
+  NS_ASSERT (m_encapMode == DIX);
+  Ptr<Packet> packet = p->Copy ();
+  EthernetTrailer trailer;
+  packet->RemoveTrailer (trailer);
+  EthernetHeader header (false);
+  packet->RemoveHeader (header);
+  std::list<Ptr<Packet> > frames = SegmentationOffload::Segment (packet, header.GetLengthType ());
+  for (std::list<Ptr<Packet> >::iterator it = frames.begin (); it != frames.end (); it++)
+    {
+      AddHeader (*it, header.GetSource (), header.GetDestination (), header.GetLengthType ());
+      m_txFrames.push_back (*it);
+    }
+  NS_LOG_LOGIC ("Super-segment " << p->GetUid () << " split into " << m_txFrames.size () << " frames");
+  m_txSuperSegment = p;
+  Ptr<Packet> frame = m_txFrames.front ();
+  m_txFrames.pop_front ();
+  return frame;
+}
+
+bool
+CsmaNetDevice::IsInterested (Mac48Address destination) const
+{
+  return destination == m_address
+         || destination.IsGroup ()
+         || !m_promiscRxCallback.IsNull ()
+         || m_receiveErrorModel
+         || !m_phyRxEndTrace.IsEmpty ()
+         || !m_phyRxDropTrace.IsEmpty ()
+         || !m_promiscSnifferTrace.IsEmpty ();
+}
+
 Ptr<Queue<Packet> >
 CsmaNetDevice::GetQueue (void) const 
 { 
@@ -971,6 +1148,7 @@ CsmaNetDevice::SendFrom (Ptr<Packet> packet, const Address& src, const Address&
   // Place the packet to be sent on the send queue.  Note that the 
   // queue may fire a drop trace, but we will too.
   //
+  UpdateFluidQueue ();
   if (m_queue->Enqueue (packet) == false)
     {
       m_macTxDropTrace (packet);
@@ -984,9 +1162,9 @@ CsmaNetDevice::SendFrom (Ptr<Packet> packet, const Address& src, const Address&
   //
   if (m_txMachineState == READY) 
     {
-      if (m_queue->IsEmpty () == false)
+      if (m_txFrames.empty () == false || m_queue->IsEmpty () == false)
         {
-          Ptr<Packet> packet = m_queue->Dequeue ();
+          Ptr<Packet> packet = DequeueFrame ();
           NS_ASSERT_MSG (packet != 0, "CsmaNetDevice::SendFrom(): IsEmpty false but no Packet on queue?");
           m_currentPkt = packet;
           m_promiscSnifferTrace (m_currentPkt);
@@ -1041,6 +1219,13 @@ CsmaNetDevice::SetPromiscReceiveCallback (NetDevice::PromiscReceiveCallback cb)
   m_promiscRxCallback = cb;
 }
 
+bool
+CsmaNetDevice::SupportsSegmentationOffload (void) const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return m_encapMode == DIX;
+}
+
 bool
 CsmaNetDevice::SupportsSendFrom () const
 {
@@ -33,10 +33,14 @@
 #include "ns3/data-rate.h"
 #include "ns3/ptr.h"
 #include "ns3/mac48-address.h"
+#include "ns3/segmentation-offload.h"
+#include <deque>
 
 namespace ns3 {
 
 template <typename Item> class Queue;
+template <typename Item> class FluidQueue;
+class NetDeviceQueue;
 class CsmaChannel;
 class ErrorModel;
 
@@ -168,6 +172,22 @@ public:
    */
   void Receive (Ptr<Packet> p, Ptr<CsmaNetDevice> sender);
 
+  /**
+   * Check whether receiving a packet sent to the given address may have a
+   * visible effect on this device.
+   *
+   * This is the case for broadcast, multicast and unicast packets sent to
+   * this device, and for all packets if the device is promiscuous, has a
+   * receive error model (which may draw random numbers), or has sinks
+   * connected to the PhyRxEnd, PhyRxDrop or PromiscSniffer trace sources.
+   * With shared delivery (see CsmaChannel), the channel does not hand the
+   * other packets to the device.
+   *
+   * \param destination the destination address of the packet
+   * \return true if the packet must be handed to this device
+   */
+  bool IsInterested (Mac48Address destination) const;
+
   /**
    * Is the send side of the network device enabled?
    *
@@ -327,6 +347,12 @@ public:
   virtual void SetPromiscReceiveCallback (PromiscReceiveCallback cb);
   virtual bool SupportsSendFrom (void) const;
 
+  /**
+   * \return true if the encapsulation mode is DIX, false otherwise: the
+   *         LLC encapsulation cannot carry the length of a super-segment.
+   */
+  virtual bool SupportsSegmentationOffload (void) const;
+
  /**
   * Assign a fixed random variable stream number to the random variables
   * used by this model.  Return the number of streams (possibly zero) that
@@ -344,6 +370,13 @@ protected:
    */
   virtual void DoDispose (void);
 
+  /**
+   * Get the transmission queue of the NetDeviceQueueInterface aggregated to
+   * this device, if any, whose queue limits are notified of the completed
+   * (or aborted) transmissions.
+   */
+  virtual void NotifyNewAggregate (void);
+
   /**
    * Adds the necessary headers and trailers to a packet of data in order to
    * respect the packet type
@@ -442,11 +475,43 @@ private:
    */
   void TransmitAbort (void);
 
+  /**
+   * Look for a FluidQueue in the transmit queue, if the queue changed, and
+   * keep its link rate in sync with the data rate of the device.
+   */
+  void UpdateFluidQueue (void);
+
   /**
    * Notify any interested parties that the link has come up.
    */
   void NotifyLinkUp (void);
 
+  /**
+   * Report to the queue limits, if any, that the device is done with a
+   * packet dequeued from the transmit queue, whether it was sent or dropped.
+   *
+   * \param p the packet
+   */
+  void NotifyTxCompletion (Ptr<const Packet> p);
+
+  /**
+   * Get the next frame to transmit.  The frames of the last super-segment
+   * (see SegmentationTag) dequeued come first.  A super-segment dequeued is
+   * split into frames, which are transmitted one after the other.
+   *
+   * \return the frame, or 0 if there is none
+   */
+  Ptr<Packet> DequeueFrame (void);
+
+  /**
+   * Forward a received packet up the protocol stack.
+   *
+   * \param packet the packet
+   * \param protocol the protocol number
+   * \param from the address of the sender
+   */
+  void ForwardUp (Ptr<Packet> packet, uint16_t protocol, const Address &from);
+
   /** 
    * Device ID returned by the attached functions. It is used by the
    * mp-channel to identify each net device to make sure that only
@@ -532,6 +597,43 @@ private:
    */
   Ptr<Queue<Packet> > m_queue;
 
+  /**
+   * The transmit queue, if it is a FluidQueue, whose background traffic
+   * delays the transmissions.
+   */
+  Ptr<FluidQueue<Packet> > m_fluidQueue;
+
+  /**
+   * The transmit queue last looked at by UpdateFluidQueue.
+   */
+  Queue<Packet> *m_fluidQueueCheck;
+
+  /**
+   * The transmission queue of the NetDeviceQueueInterface aggregated to this
+   * device, if any.
+   */
+  Ptr<NetDeviceQueue> m_netDeviceQueue;
+
+  /**
+   * The frames of the super-segment being transmitted, not transmitted yet.
+   */
+  std::deque<Ptr<Packet> > m_txFrames;
+
+  /**
+   * The super-segment being transmitted, if any.
+   */
+  Ptr<Packet> m_txSuperSegment;
+
+  /**
+   * Whether the received frames of super-segments are coalesced.
+   */
+  bool m_receiveCoalescing;
+
+  /**
+   * The coalescer of the received frames.
+   */
+  ReceiveCoalescer m_rxCoalescer;
+
   /**
    * Error model for receive packet events.  When active this model will be
    * used to model transmission errors by marking some of the packets 
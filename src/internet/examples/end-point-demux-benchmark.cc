@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures the end point demultiplexing rate of a server
+// with many accepted connections (by default 1000, 10000 and 100000), as
+// TCP and UDP do for every received packet.
+//
+// Example:
+//
+//     ./ns3 run "end-point-demux-benchmark --connections=1000,10000,100000 --lookups=1000000"
+//
+// The server listens on 10.0.0.1:80 (and [2001:db8::1]:80), and each
+// connection has a distinct client address and port.  Each run reports the
+// time taken to accept the connections, to look up the end points of
+// established connections and of new connections (which match the
+// listener), and, for reference, to look up established connections by a
+// linear scan of the end points, as the demultiplexers did before they
+// hashed them (run on --linearLookups lookups only, as it is slow).  The
+// last line is the rate of ephemeral port allocations of a client that
+// opens and closes connections while holding --connections of them.
+//
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Print the rate of a run.
+ * \param label description of the run
+ * \param connections number of connections
+ * \param operations number of operations
+ * \param ms elapsed wall clock time, in milliseconds
+ */
+static void
+Report (const std::string &label, uint32_t connections, uint32_t operations, int64_t ms)
+{
+  double rate = ms > 0 ? operations * 1000.0 / ms : 0;
+  std::cout << std::left << std::setw (20) << label
+            << std::right << std::setw (8) << connections << " connections "
+            << std::setw (9) << operations << " operations "
+            << std::setw (7) << ms << " ms "
+            << std::setw (12) << std::fixed << std::setprecision (0) << rate
+            << " operations/s" << std::endl;
+}
+
+/**
+ * Linear scan of the end points for an exact match.
+ * \param endPoints the end points
+ * \param daddr destination address
+ * \param dport destination port
+ * \param saddr source address
+ * \param sport source port
+ * \return the matching end point, or 0
+ */
+static Ipv4EndPoint *
+LinearLookup (const Ipv4EndPointDemux::EndPoints &endPoints, Ipv4Address daddr, uint16_t dport,
+              Ipv4Address saddr, uint16_t sport)
+{
+  for (Ipv4EndPointDemux::EndPoints::const_iterator it = endPoints.begin (); it != endPoints.end (); it++)
+    {
+      if ((*it)->GetLocalPort () == dport && (*it)->GetLocalAddress () == daddr
+          && (*it)->GetPeerPort () == sport && (*it)->GetPeerAddress () == saddr)
+        {
+          return *it;
+        }
+    }
+  return 0;
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string connectionsList = "1000,10000,100000";
+  uint32_t lookups = 1000000;
+  uint32_t linearLookups = 1000;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("connections", "Comma-separated numbers of connections", connectionsList);
+  cmd.AddValue ("lookups", "Number of lookups per run", lookups);
+  cmd.AddValue ("linearLookups", "Number of lookups of the linear scan reference", linearLookups);
+  cmd.Parse (argc, argv);
+
+  Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+  Ipv4Address server4 ("10.0.0.1");
+  Ptr<Ipv4Interface> interface4 = CreateObject<Ipv4Interface> ();
+  interface4->SetDevice (device);
+  interface4->AddAddress (Ipv4InterfaceAddress (server4, Ipv4Mask ("255.0.0.0")));
+  Ipv6Address server6 ("2001:db8::1");
+  Ptr<Ipv6Interface> interface6 = CreateObject<Ipv6Interface> ();
+  interface6->SetDevice (device);
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  SystemWallClockMs clock;
+
+  std::istringstream connectionsStream (connectionsList);
+  std::string connectionsItem;
+  while (std::getline (connectionsStream, connectionsItem, ','))
+    {
+      uint32_t nConnections = std::stoul (connectionsItem);
+      NS_ABORT_MSG_IF (nConnections == 0 || nConnections > 16000000, "Unsupported number of connections");
+
+      // Client i is 11.x.y.z:(1024 + i % 60000), or 2001:db8:1::i
+      std::vector<Ipv4Address> clients4 (nConnections);
+      std::vector<Ipv6Address> clients6 (nConnections);
+      std::vector<uint16_t> clientPorts (nConnections);
+      for (uint32_t i = 0; i < nConnections; i++)
+        {
+          clients4[i] = Ipv4Address (0x0b000000 + i);
+          uint8_t bytes[16] = {0x20, 0x01, 0x0d, 0xb8, 0, 1};
+          bytes[13] = (i >> 16) & 0xff;
+          bytes[14] = (i >> 8) & 0xff;
+          bytes[15] = i & 0xff;
+          clients6[i] = Ipv6Address (bytes);
+          clientPorts[i] = 1024 + i % 60000;
+        }
+      std::vector<uint32_t> queries (lookups);
+      for (uint32_t i = 0; i < lookups; i++)
+        {
+          queries[i] = rng->GetInteger (0, nConnections - 1);
+        }
+
+      // IPv4
+      Ipv4EndPointDemux demux4;
+      demux4.Allocate (0, Ipv4Address::GetAny (), 80);
+      clock.Start ();
+      for (uint32_t i = 0; i < nConnections; i++)
+        {
+          demux4.Allocate (0, server4, 80, clients4[i], clientPorts[i]);
+        }
+      Report ("Ipv4 accept", nConnections, nConnections, clock.End ());
+
+      uint32_t found = 0;
+      clock.Start ();
+      for (uint32_t i = 0; i < lookups; i++)
+        {
+          uint32_t c = queries[i];
+          found += demux4.Lookup (server4, 80, clients4[c], clientPorts[c], interface4).size ();
+        }
+      Report ("Ipv4 established", nConnections, lookups, clock.End ());
+      NS_ABORT_MSG_UNLESS (found == lookups, "Some connections were not found");
+
+      clock.Start ();
+      for (uint32_t i = 0; i < lookups; i++)
+        {
+          uint32_t c = queries[i];
+          found += demux4.Lookup (server4, 80, clients4[c], clientPorts[c] + 1, interface4).size ();
+        }
+      Report ("Ipv4 new", nConnections, lookups, clock.End ());
+
+      uint32_t nLinear = std::min (linearLookups, lookups);
+      Ipv4EndPointDemux::EndPoints endPoints = demux4.GetAllEndPoints ();
+      found = 0;
+      clock.Start ();
+      for (uint32_t i = 0; i < nLinear; i++)
+        {
+          uint32_t c = queries[i];
+          found += LinearLookup (endPoints, server4, 80, clients4[c], clientPorts[c]) != 0;
+        }
+      Report ("Ipv4 linear scan", nConnections, nLinear, clock.End ());
+      NS_ABORT_MSG_UNLESS (found == nLinear, "Some connections were not found");
+
+      // IPv6
+      Ipv6EndPointDemux demux6;
+      demux6.Allocate (0, Ipv6Address::GetAny (), 80);
+      clock.Start ();
+      for (uint32_t i = 0; i < nConnections; i++)
+        {
+          demux6.Allocate (0, server6, 80, clients6[i], clientPorts[i]);
+        }
+      Report ("Ipv6 accept", nConnections, nConnections, clock.End ());
+
+      found = 0;
+      clock.Start ();
+      for (uint32_t i = 0; i < lookups; i++)
+        {
+          uint32_t c = queries[i];
+          found += demux6.Lookup (server6, 80, clients6[c], clientPorts[c], interface6).size ();
+        }
+      Report ("Ipv6 established", nConnections, lookups, clock.End ());
+      NS_ABORT_MSG_UNLESS (found == lookups, "Some connections were not found");
+
+      // Ephemeral ports of a client holding min (connections, 16000) of them
+      uint32_t nHeld = std::min<uint32_t> (nConnections, 16000);
+      Ipv4EndPointDemux client;
+      std::vector<Ipv4EndPoint *> held;
+      for (uint32_t i = 0; i < nHeld; i++)
+        {
+          held.push_back (client.Allocate ());
+        }
+      clock.Start ();
+      for (uint32_t i = 0; i < lookups; i++)
+        {
+          uint32_t j = queries[i] % nHeld;
+          client.DeAllocate (held[j]);
+          held[j] = client.Allocate ();
+          NS_ABORT_MSG_UNLESS (held[j] != 0, "Ephemeral port allocation failed");
+        }
+      Report ("Ipv4 ephemeral", nHeld, lookups, clock.End ());
+    }
+
+  return 0;
+}
@@ -0,0 +1,261 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures the forwarding rate (route lookups per second) of
+// Ipv4StaticRouting, Ipv4GlobalRouting and Ipv6StaticRouting with large
+// routing tables (by default 1000, 10000 and 100000 routes).
+//
+// Example:
+//
+//     ./ns3 run "fib-lookup-benchmark --routes=1000,10000,100000 --lookups=1000000"
+//
+// The routes are random networks (with a /16 to /28 mask for IPv4 and a /32
+// to /64 prefix for IPv6) through four interfaces, and the destinations are
+// random addresses in these networks.  As a reference, the same IPv4
+// lookups are also done by a linear scan of the routes, as these protocols
+// did before they indexed their routes; as it is slow, it is run on
+// --linearLookups lookups only.
+//
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Print the lookup rate of a run.
+ * \param label description of the run
+ * \param routes number of routes
+ * \param lookups number of lookups
+ * \param ms elapsed wall clock time, in milliseconds
+ */
+static void
+Report (const std::string &label, uint32_t routes, uint32_t lookups, int64_t ms)
+{
+  double rate = ms > 0 ? lookups * 1000.0 / ms : 0;
+  std::cout << std::left << std::setw (20) << label
+            << std::right << std::setw (8) << routes << " routes "
+            << std::setw (9) << lookups << " lookups "
+            << std::setw (7) << ms << " ms "
+            << std::setw (12) << std::fixed << std::setprecision (0) << rate
+            << " lookups/s" << std::endl;
+}
+
+/**
+ * A random IPv4 network route.
+ */
+struct Ipv4Route4Bench
+{
+  Ipv4Address network; //!< network address
+  Ipv4Mask mask;       //!< network mask
+  uint32_t interface;  //!< output interface
+};
+
+/**
+ * Linear scan of the routes, keeping the longest match, as
+ * Ipv4StaticRouting used to do.
+ * \param routes the routes
+ * \param dest the destination
+ * \return the matching route with the longest mask, or 0
+ */
+static const Ipv4Route4Bench *
+LinearLookup (const std::list<Ipv4Route4Bench> &routes, Ipv4Address dest)
+{
+  const Ipv4Route4Bench *best = 0;
+  uint16_t longestMask = 0;
+  for (std::list<Ipv4Route4Bench>::const_iterator it = routes.begin (); it != routes.end (); it++)
+    {
+      if (it->mask.IsMatch (dest, it->network))
+        {
+          uint16_t maskLen = it->mask.GetPrefixLength ();
+          if (best == 0 || maskLen > longestMask)
+            {
+              best = &(*it);
+              longestMask = maskLen;
+            }
+        }
+    }
+  return best;
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string routesList = "1000,10000,100000";
+  uint32_t lookups = 1000000;
+  uint32_t linearLookups = 1000;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("routes", "Comma-separated numbers of routes", routesList);
+  cmd.AddValue ("lookups", "Number of lookups per run", lookups);
+  cmd.AddValue ("linearLookups", "Number of lookups of the linear scan reference", linearLookups);
+  cmd.Parse (argc, argv);
+
+  // A node with four interfaces
+  const uint32_t nInterfaces = 4;
+  Ptr<Node> node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.Install (node);
+  SimpleNetDeviceHelper devHelper;
+  NetDeviceContainer devices;
+  for (uint32_t i = 0; i < nInterfaces; i++)
+    {
+      devices.Add (devHelper.Install (node));
+    }
+  Ipv4AddressHelper ipv4Address;
+  ipv4Address.SetBase ("10.0.0.0", "255.255.255.0");
+  Ipv6AddressHelper ipv6Address;
+  ipv6Address.SetBase (Ipv6Address ("2001:db8:ffff::"), Ipv6Prefix (64));
+  for (uint32_t i = 0; i < nInterfaces; i++)
+    {
+      ipv4Address.Assign (NetDeviceContainer (devices.Get (i)));
+      ipv4Address.NewNetwork ();
+      ipv6Address.Assign (NetDeviceContainer (devices.Get (i)));
+      ipv6Address.NewNetwork ();
+    }
+  Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+  Ptr<Ipv6> ipv6 = node->GetObject<Ipv6> ();
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  Ptr<Packet> packet = Create<Packet> ();
+  Socket::SocketErrno sockerr;
+  SystemWallClockMs clock;
+
+  std::istringstream routesStream (routesList);
+  std::string routesItem;
+  while (std::getline (routesStream, routesItem, ','))
+    {
+      uint32_t nRoutes = std::stoul (routesItem);
+
+      // IPv4 routes and destinations
+      std::list<Ipv4Route4Bench> routes4;
+      for (uint32_t i = 0; i < nRoutes; i++)
+        {
+          Ipv4Route4Bench route;
+          uint32_t prefixLength = rng->GetInteger (16, 28);
+          route.mask = Ipv4Mask (0xffffffff << (32 - prefixLength));
+          // Unicast networks only (from 1.0.0.0 to 223.255.255.255)
+          route.network = Ipv4Address (rng->GetInteger (0x01000000, 0xdfffffff)).CombineMask (route.mask);
+          route.interface = 1 + i % nInterfaces;
+          routes4.push_back (route);
+        }
+      std::vector<const Ipv4Route4Bench *> routes4Index;
+      for (std::list<Ipv4Route4Bench>::const_iterator it = routes4.begin (); it != routes4.end (); it++)
+        {
+          routes4Index.push_back (&(*it));
+        }
+      std::vector<Ipv4Header> headers4 (lookups);
+      for (uint32_t i = 0; i < lookups; i++)
+        {
+          const Ipv4Route4Bench *route = routes4Index[rng->GetInteger (0, nRoutes - 1)];
+          uint32_t host = rng->GetInteger (0, 0xffffffff) & ~route->mask.Get ();
+          headers4[i].SetDestination (Ipv4Address (route->network.Get () | host));
+        }
+
+      Ptr<Ipv4StaticRouting> staticRouting = CreateObject<Ipv4StaticRouting> ();
+      staticRouting->SetIpv4 (ipv4);
+      Ptr<Ipv4GlobalRouting> globalRouting = CreateObject<Ipv4GlobalRouting> ();
+      globalRouting->SetIpv4 (ipv4);
+      for (std::list<Ipv4Route4Bench>::const_iterator it = routes4.begin (); it != routes4.end (); it++)
+        {
+          Ipv4Address gateway (ipv4->GetAddress (it->interface, 0).GetLocal ().Get () + 1);
+          staticRouting->AddNetworkRouteTo (it->network, it->mask, gateway, it->interface);
+          globalRouting->AddNetworkRouteTo (it->network, it->mask, gateway, it->interface);
+        }
+
+      clock.Start ();
+      for (uint32_t i = 0; i < lookups; i++)
+        {
+          staticRouting->RouteOutput (packet, headers4[i], 0, sockerr);
+        }
+      Report ("Ipv4StaticRouting", nRoutes, lookups, clock.End ());
+
+      clock.Start ();
+      for (uint32_t i = 0; i < lookups; i++)
+        {
+          globalRouting->RouteOutput (packet, headers4[i], 0, sockerr);
+        }
+      Report ("Ipv4GlobalRouting", nRoutes, lookups, clock.End ());
+
+      uint32_t nLinear = std::min (linearLookups, lookups);
+      uint32_t found = 0;
+      clock.Start ();
+      for (uint32_t i = 0; i < nLinear; i++)
+        {
+          found += LinearLookup (routes4, headers4[i].GetDestination ()) != 0;
+        }
+      Report ("linear scan", nRoutes, nLinear, clock.End ());
+      NS_ABORT_MSG_UNLESS (found == nLinear, "Some destinations have no route");
+
+      staticRouting->Dispose ();
+      globalRouting->Dispose ();
+
+      // IPv6 routes and destinations
+      Ptr<Ipv6StaticRouting> staticRouting6 = CreateObject<Ipv6StaticRouting> ();
+      staticRouting6->SetIpv6 (ipv6);
+      std::vector<Ipv6Header> headers6 (lookups);
+      std::vector<std::pair<Ipv6Address, Ipv6Prefix> > routes6;
+      for (uint32_t i = 0; i < nRoutes; i++)
+        {
+          uint8_t bytes[16];
+          // Global unicast networks only (2000::/3)
+          for (uint32_t j = 0; j < 16; j++)
+            {
+              bytes[j] = rng->GetInteger (0, 255);
+            }
+          bytes[0] = 0x20 | (bytes[0] & 0x1f);
+          Ipv6Prefix prefix (rng->GetInteger (32, 64));
+          Ipv6Address network = Ipv6Address (bytes).CombinePrefix (prefix);
+          uint32_t interface = 1 + i % nInterfaces;
+          Ipv6Address gateway = ipv6->GetAddress (interface, 1).GetAddress ();
+          staticRouting6->AddNetworkRouteTo (network, prefix, gateway, interface);
+          routes6.push_back (std::make_pair (network, prefix));
+        }
+      for (uint32_t i = 0; i < lookups; i++)
+        {
+          const std::pair<Ipv6Address, Ipv6Prefix> &route = routes6[rng->GetInteger (0, nRoutes - 1)];
+          uint8_t network[16];
+          uint8_t prefix[16];
+          route.first.GetBytes (network);
+          route.second.GetBytes (prefix);
+          for (uint32_t j = 0; j < 16; j++)
+            {
+              network[j] |= rng->GetInteger (0, 255) & ~prefix[j];
+            }
+          headers6[i].SetDestination (Ipv6Address (network));
+        }
+
+      clock.Start ();
+      for (uint32_t i = 0; i < lookups; i++)
+        {
+          staticRouting6->RouteOutput (packet, headers6[i], 0, sockerr);
+        }
+      Report ("Ipv6StaticRouting", nRoutes, lookups, clock.End ());
+
+      staticRouting6->Dispose ();
+    }
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -83,6 +83,8 @@ public:
    * Users must first call PopulateRoutingTables() and then may subsequently
    * call RecomputeRoutingTables() at any later time in the simulation.
    *
+   * If the GlobalRoutingIncrementalSpf global value is true, only the routes
+   * affected by the changes of the topology are updated.
    */
   static void RecomputeRoutingTables (void);
 private:
@@ -0,0 +1,216 @@
+// -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*-
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include <cstring>
+#include <fstream>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "global-next-hop-table.h"
+#include "ipv4-routing-table-entry.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("GlobalNextHopTable");
+
+/// File type and version of the files of next hops
+static const char g_nextHopFileMagic[8] = {'N', 'S', '3', 'G', 'N', 'H', 'T', '1'};
+
+GlobalNextHopTable::GlobalNextHopTable (uint32_t nVertices, uint32_t nRows)
+  : m_nVertices (nVertices),
+    m_nRows (nRows)
+{
+  NS_LOG_FUNCTION (this << nVertices << nRows);
+  NextHop none;
+  none.gateway = 0;
+  none.interface = NO_INTERFACE;
+  m_nextHops.assign (static_cast<uint64_t> (nVertices) * nRows, none);
+  m_rows = m_nextHops.empty () ? 0 : &m_nextHops[0];
+}
+
+GlobalNextHopTable::~GlobalNextHopTable ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+GlobalNextHopTable::AddDestination (Ipv4Address network, Ipv4Mask mask, DestinationType type, uint32_t vertex)
+{
+  NS_LOG_FUNCTION (this << network << mask << type << vertex);
+  NS_ASSERT (vertex < m_nVertices);
+  Destination destination;
+  destination.network = network.CombineMask (mask).Get ();
+  destination.mask = mask.Get ();
+  destination.vertex = vertex;
+  destination.type = type;
+  m_destinationIndex.Insert (network, mask, m_destinations.size ());
+  m_destinations.push_back (destination);
+}
+
+uint32_t
+GlobalNextHopTable::GetNDestinations (void) const
+{
+  return m_destinations.size ();
+}
+
+uint32_t
+GlobalNextHopTable::GetNVertices (void) const
+{
+  return m_nVertices;
+}
+
+uint32_t
+GlobalNextHopTable::GetNRows (void) const
+{
+  return m_nRows;
+}
+
+void
+GlobalNextHopTable::SetNextHop (uint32_t row, uint32_t vertex, Ipv4Address gateway, uint32_t interface)
+{
+  NS_ASSERT_MSG (!IsLoaded (), "The next hops loaded from a file cannot be changed");
+  NS_ASSERT (row < m_nRows && vertex < m_nVertices);
+  NextHop &nextHop = m_nextHops[static_cast<uint64_t> (row) * m_nVertices + vertex];
+  nextHop.gateway = gateway.Get ();
+  nextHop.interface = interface;
+}
+
+const GlobalNextHopTable::NextHop &
+GlobalNextHopTable::GetNextHop (uint32_t row, uint32_t vertex) const
+{
+  NS_ASSERT (row < m_nRows && vertex < m_nVertices);
+  return m_rows[static_cast<uint64_t> (row) * m_nVertices + vertex];
+}
+
+bool
+GlobalNextHopTable::Lookup (uint32_t row, Ipv4Address dest, Ipv4Address &gateway, uint32_t &interface) const
+{
+  NS_LOG_FUNCTION (this << row << dest);
+  std::vector<uint32_t> candidates;
+  m_destinationIndex.Lookup (dest, candidates);
+  const Destination *best = 0;
+  uint16_t bestLength = 0;
+  for (std::vector<uint32_t>::const_iterator i = candidates.begin (); i != candidates.end (); i++)
+    {
+      const Destination &destination = m_destinations[*i];
+      if (GetNextHop (row, destination.vertex).interface == NO_INTERFACE)
+        {
+          // The router itself, or an unreachable vertex
+          continue;
+        }
+      uint16_t length = Ipv4Mask (destination.mask).GetPrefixLength ();
+      if (best == 0 || destination.type < best->type
+          || (destination.type == best->type && length > bestLength))
+        {
+          best = &destination;
+          bestLength = length;
+        }
+    }
+  if (best == 0)
+    {
+      return false;
+    }
+  const NextHop &nextHop = GetNextHop (row, best->vertex);
+  gateway = Ipv4Address (nextHop.gateway);
+  interface = nextHop.interface;
+  NS_LOG_LOGIC ("Found next hop " << gateway << " through interface " << interface);
+  return true;
+}
+
+bool
+GlobalNextHopTable::GetRoute (uint32_t row, uint32_t i, Ipv4RoutingTableEntry &route) const
+{
+  NS_ASSERT (i < m_destinations.size ());
+  const Destination &destination = m_destinations[i];
+  const NextHop &nextHop = GetNextHop (row, destination.vertex);
+  if (nextHop.interface == NO_INTERFACE)
+    {
+      return false;
+    }
+  if (destination.type == HOST)
+    {
+      route = Ipv4RoutingTableEntry::CreateHostRouteTo (Ipv4Address (destination.network),
+                                                        Ipv4Address (nextHop.gateway),
+                                                        nextHop.interface);
+    }
+  else
+    {
+      route = Ipv4RoutingTableEntry::CreateNetworkRouteTo (Ipv4Address (destination.network),
+                                                           Ipv4Mask (destination.mask),
+                                                           Ipv4Address (nextHop.gateway),
+                                                           nextHop.interface);
+    }
+  return true;
+}
+
+bool
+GlobalNextHopTable::Save (const std::string &filename, uint64_t key) const
+{
+  NS_LOG_FUNCTION (this << filename << key);
+  std::ofstream file (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file)
+    {
+      NS_LOG_WARN ("Cannot write the next hops to " << filename);
+      return false;
+    }
+  FileHeader header;
+  std::memset (&header, 0, sizeof (header));
+  std::memcpy (header.magic, g_nextHopFileMagic, sizeof (header.magic));
+  header.key = key;
+  header.nVertices = m_nVertices;
+  header.nRows = m_nRows;
+  file.write (reinterpret_cast<const char *> (&header), sizeof (header));
+  file.write (reinterpret_cast<const char *> (m_rows),
+              static_cast<uint64_t> (m_nVertices) * m_nRows * sizeof (NextHop));
+  return file.good ();
+}
+
+bool
+GlobalNextHopTable::Load (const std::string &filename, uint64_t key)
+{
+  NS_LOG_FUNCTION (this << filename << key);
+  if (!m_file.Open (filename))
+    {
+      return false;
+    }
+  uint64_t size = static_cast<uint64_t> (m_nVertices) * m_nRows * sizeof (NextHop);
+  FileHeader header;
+  if (m_file.GetSize () != sizeof (header) + size)
+    {
+      NS_LOG_LOGIC ("Wrong size of " << filename);
+      m_file.Close ();
+      return false;
+    }
+  std::memcpy (&header, m_file.GetData (), sizeof (header));
+  if (std::memcmp (header.magic, g_nextHopFileMagic, sizeof (header.magic)) != 0
+      || header.key != key || header.nVertices != m_nVertices || header.nRows != m_nRows)
+    {
+      NS_LOG_LOGIC (filename << " was saved for another topology");
+      m_file.Close ();
+      return false;
+    }
+  m_rows = reinterpret_cast<const NextHop *> (m_file.GetData () + sizeof (header));
+  std::vector<NextHop> ().swap (m_nextHops);
+  NS_LOG_INFO ("Loaded the next hops of " << m_nRows << " routers from " << filename);
+  return true;
+}
+
+bool
+GlobalNextHopTable::IsLoaded (void) const
+{
+  return m_file.IsOpen ();
+}
+
+} // namespace ns3
@@ -26,10 +26,23 @@
 #include <vector>
 #include <queue>
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include <iostream>
+#include <sstream>
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include <thread>
+#endif /* HAVE_PTHREAD_H */
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/global-value.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/hash.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
@@ -37,12 +50,55 @@
 #include "global-router-interface.h"
 #include "global-route-manager-impl.h"
 #include "candidate-queue.h"
+#include "global-next-hop-table.h"
 #include "ipv4-global-routing.h"
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("GlobalRouteManagerImpl");
 
+/**
+ * \ingroup globalrouting
+ * The number of threads computing the shortest path trees
+ */
+static GlobalValue g_spfThreads ("GlobalRoutingSpfThreads",
+                                 "The number of threads computing the shortest path "
+                                 "trees of the global routing (0: one per processor core)",
+                                 UintegerValue (1),
+                                 MakeUintegerChecker<uint32_t> ());
+
+/**
+ * \ingroup globalrouting
+ * Whether only the changed shortest path trees are recomputed
+ */
+static GlobalValue g_incrementalSpf ("GlobalRoutingIncrementalSpf",
+                                     "Only recompute the shortest path trees which may "
+                                     "have changed when the global routes are recomputed",
+                                     BooleanValue (false),
+                                     MakeBooleanChecker ());
+
+/**
+ * \ingroup globalrouting
+ * Whether the next hops of all the routers are stored in a shared table
+ */
+static GlobalValue g_nextHopTable ("GlobalRoutingNextHopTable",
+                                   "Store the next hops of all the routers in a single table "
+                                   "shared by their global routing protocols, rather than "
+                                   "in a routing table per router",
+                                   BooleanValue (false),
+                                   MakeBooleanChecker ());
+
+/**
+ * \ingroup globalrouting
+ * The file caching the shared table of next hops
+ */
+static GlobalValue g_nextHopCache ("GlobalRoutingNextHopCache",
+                                   "The file in which the shared table of next hops is saved, "
+                                   "and from which it is mapped instead of being computed "
+                                   "if the topology did not change (empty: no file)",
+                                   StringValue (""),
+                                   MakeStringChecker ());
+
 /**
  * \brief Stream insertion operator.
  *
@@ -422,7 +478,8 @@ SPFVertex::ClearVertexProcessed (void)
 GlobalRouteManagerLSDB::GlobalRouteManagerLSDB ()
   :
     m_database (),
-    m_extdatabase ()
+    m_extdatabase (),
+    m_linkDataIndex ()
 {
   NS_LOG_FUNCTION (this);
 }
@@ -445,6 +502,7 @@ GlobalRouteManagerLSDB::~GlobalRouteManagerLSDB ()
     }
   NS_LOG_LOGIC ("clear map");
   m_database.clear ();
+  m_linkDataIndex.clear ();
 }
 
 void
@@ -467,9 +525,25 @@ GlobalRouteManagerLSDB::Insert (Ipv4Address addr, GlobalRoutingLSA* lsa)
     {
       m_extdatabase.push_back (lsa);
     } 
-  else
+  else if (m_database.insert (LSDBPair_t (addr, lsa)).second)
     {
-      m_database.insert (LSDBPair_t (addr, lsa));
+      for (uint32_t j = 0; j < lsa->GetNLinkRecords (); j++)
+        {
+          GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
+          if (lr->GetLinkType () != GlobalRoutingLinkRecord::TransitNetwork)
+            {
+              continue;
+            }
+          LinkDataMap_t::iterator i = m_linkDataIndex.find (lr->GetLinkData ());
+          if (i == m_linkDataIndex.end ())
+            {
+              m_linkDataIndex.insert (std::make_pair (lr->GetLinkData (), LSDBPair_t (addr, lsa)));
+            }
+          else if (addr < i->second.first)
+            {
+              i->second = LSDBPair_t (addr, lsa);
+            }
+        }
     }
 }
 
@@ -494,13 +568,10 @@ GlobalRouteManagerLSDB::GetLSA (Ipv4Address addr) const
 //
 // Look up an LSA by its address.
 //
-  LSDBMap_t::const_iterator i;
-  for (i= m_database.begin (); i!= m_database.end (); i++)
+  LSDBMap_t::const_iterator i = m_database.find (addr);
+  if (i != m_database.end ())
     {
-      if (i->first == addr)
-        {
-          return i->second;
-        }
+      return i->second;
     }
   return 0;
 }
@@ -510,26 +581,28 @@ GlobalRouteManagerLSDB::GetLSAByLinkData (Ipv4Address addr) const
 {
   NS_LOG_FUNCTION (this << addr);
 //
-// Look up an LSA by its address.
+// Look up an LSA by the link data of one of its transit network link records.
+// The index holds, for each link data, the LSA with the lowest address.
 //
-  LSDBMap_t::const_iterator i;
-  for (i= m_database.begin (); i!= m_database.end (); i++)
+  LinkDataMap_t::const_iterator i = m_linkDataIndex.find (addr);
+  if (i != m_linkDataIndex.end ())
     {
-      GlobalRoutingLSA* temp = i->second;
-// Iterate among temp's Link Records
-      for (uint32_t j = 0; j < temp->GetNLinkRecords (); j++)
-        {
-          GlobalRoutingLinkRecord *lr = temp->GetLinkRecord (j);
-          if ( lr->GetLinkType () == GlobalRoutingLinkRecord::TransitNetwork &&
-               lr->GetLinkData () == addr)
-            {
-              return temp;
-            }
-        }
+      return i->second.second;
     }
   return 0;
 }
 
+void
+GlobalRouteManagerLSDB::GetLSAs (std::vector<GlobalRoutingLSA*> &lsas) const
+{
+  NS_LOG_FUNCTION (this);
+  lsas.clear ();
+  for (LSDBMap_t::const_iterator i = m_database.begin (); i != m_database.end (); i++)
+    {
+      lsas.push_back (i->second);
+    }
+}
+
 // ---------------------------------------------------------------------------
 //
 // GlobalRouteManagerImpl Implementation
@@ -538,16 +611,38 @@ GlobalRouteManagerLSDB::GetLSAByLinkData (Ipv4Address addr) const
 
 GlobalRouteManagerImpl::GlobalRouteManagerImpl () 
   :
-    m_spfroot (0)
+    m_spfroot (0),
+    m_sharedLsdb (false),
+    m_spfrootNode (0),
+    m_spfrootIpv4 (0),
+    m_spfrootRouting (0),
+    m_nextHops (0),
+    m_vertexIndex (0),
+    m_rowIndex (0)
 {
   NS_LOG_FUNCTION (this);
   m_lsdb = new GlobalRouteManagerLSDB ();
 }
 
+GlobalRouteManagerImpl::GlobalRouteManagerImpl (GlobalRouteManagerLSDB* lsdb)
+  :
+    m_spfroot (0),
+    m_lsdb (lsdb),
+    m_sharedLsdb (true),
+    m_spfrootNode (0),
+    m_spfrootIpv4 (0),
+    m_spfrootRouting (0),
+    m_nextHops (0),
+    m_vertexIndex (0),
+    m_rowIndex (0)
+{
+  NS_LOG_FUNCTION (this << lsdb);
+}
+
 GlobalRouteManagerImpl::~GlobalRouteManagerImpl ()
 {
   NS_LOG_FUNCTION (this);
-  if (m_lsdb)
+  if (m_lsdb && !m_sharedLsdb)
     {
       delete m_lsdb;
     }
@@ -557,11 +652,12 @@ void
 GlobalRouteManagerImpl::DebugUseLsdb (GlobalRouteManagerLSDB* lsdb)
 {
   NS_LOG_FUNCTION (this << lsdb);
-  if (m_lsdb)
+  if (m_lsdb && !m_sharedLsdb)
     {
       delete m_lsdb;
     }
   m_lsdb = lsdb;
+  m_sharedLsdb = false;
 }
 
 void
@@ -578,6 +674,7 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes ()
           continue;
         }
       Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
+      gr->SetNextHopTable (0, 0);
       uint32_t j = 0;
       uint32_t nRoutes = gr->GetNRoutes ();
       NS_LOG_LOGIC ("Deleting " << gr->GetNRoutes ()<< " routes from node " << node->GetId ());
@@ -612,6 +709,13 @@ void
 GlobalRouteManagerImpl::BuildGlobalRoutingDatabase () 
 {
   NS_LOG_FUNCTION (this);
+  BuildLsdb (m_lsdb);
+}
+
+void
+GlobalRouteManagerImpl::BuildLsdb (GlobalRouteManagerLSDB* lsdb)
+{
+  NS_LOG_FUNCTION (this << lsdb);
 //
 // Walk the list of nodes looking for the GlobalRouter Interface.  Nodes with
 // global router interfaces are, not too surprisingly, our routers.
@@ -653,7 +757,7 @@ GlobalRouteManagerImpl::BuildGlobalRoutingDatabase ()
 //
 // Write the newly discovered link state advertisement to the database.
 //
-          m_lsdb->Insert (lsa->GetLinkStateId (), lsa); 
+          lsdb->Insert (lsa->GetLinkStateId (), lsa); 
         }
     }
 }
@@ -699,34 +803,740 @@ GlobalRouteManagerImpl::InitializeRoutes ()
 // Walk the list of nodes in the system.
 //
   NS_LOG_INFO ("About to start SPF calculation");
+  std::vector<Ipv4Address> roots;
   NodeList::Iterator listEnd = NodeList::End ();
   for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
     {
       Ptr<Node> node = *i;
 //
-// Look for the GlobalRouter interface that indicates that the node is
-// participating in routing.
+// Look for the GlobalRouter interface that indicates that the node is
+// participating in routing.
+//
+      Ptr<GlobalRouter> rtr = 
+        node->GetObject<GlobalRouter> ();
+
+      uint32_t systemId = Simulator::GetSystemId ();
+      // Ignore nodes that are not assigned to our systemId (distributed sim)
+      if (node->GetSystemId () != systemId) 
+        {
+          continue;
+        }
+
+//
+// if the node has a global router interface, then run the global routing
+// algorithms.
+//
+      if (rtr && rtr->GetNumLSAs () )
+        {
+          roots.push_back (rtr->GetRouterId ());
+        }
+    }
+  BooleanValue nextHopTable;
+  g_nextHopTable.GetValue (nextHopTable);
+  if (nextHopTable.Get ())
+    {
+      BuildNextHopTable (roots);
+    }
+  else
+    {
+      SPFCalculate (roots);
+    }
+  NS_LOG_INFO ("Finished SPF calculation");
+}
+
+//
+// The shortest path trees of the routers are independent of each other: the
+// Link State Database is only read during the calculations, and each
+// calculation only writes the routing table of the node at its root.  They
+// are thus shared among GlobalRoutingSpfThreads threads, each with its own
+// GlobalRouteManagerImpl (and its own SPF state) on the same database.
+//
+// The nodes of the roots are looked up here, on the main thread: the
+// threads only get raw pointers to the objects of their roots, since the
+// NodeList and the reference counts of the Ptr are not thread-safe.
+//
+void
+GlobalRouteManagerImpl::SPFCalculate (const std::vector<Ipv4Address> &roots)
+{
+  NS_LOG_FUNCTION (this << roots.size ());
+  std::vector<SpfRoot> spfRoots;
+  spfRoots.reserve (roots.size ());
+  for (std::vector<Ipv4Address>::const_iterator i = roots.begin (); i != roots.end (); i++)
+    {
+      GlobalRoutingLSA *rootLsa = m_lsdb->GetLSA (*i);
+      NS_ASSERT_MSG (rootLsa, "GlobalRouteManagerImpl::SPFCalculate (): No LSA for root " << *i);
+      spfRoots.push_back (GetSpfRoot (rootLsa));
+    }
+  UintegerValue threadsValue;
+  g_spfThreads.GetValue (threadsValue);
+  std::size_t nThreads = threadsValue.Get ();
+#ifdef HAVE_PTHREAD_H
+  if (nThreads == 0)
+    {
+      nThreads = std::max (std::thread::hardware_concurrency (), 1u);
+    }
+#else
+  nThreads = 1;
+#endif /* HAVE_PTHREAD_H */
+  nThreads = std::min (nThreads, roots.size ());
+
+  std::atomic<std::size_t> next (0);
+  if (nThreads <= 1)
+    {
+      SPFWorker (&spfRoots, &next);
+      return;
+    }
+#ifdef HAVE_PTHREAD_H
+  NS_LOG_INFO ("Running the SPF calculations of " << roots.size () << " routers on " << nThreads << " threads");
+  std::vector<GlobalRouteManagerImpl *> workers;
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < nThreads; i++)
+    {
+      workers.push_back (new GlobalRouteManagerImpl (m_lsdb));
+      workers.back ()->m_nextHops = m_nextHops;
+      workers.back ()->m_vertexIndex = m_vertexIndex;
+      workers.back ()->m_rowIndex = m_rowIndex;
+      threads.push_back (std::thread (&GlobalRouteManagerImpl::SPFWorker, workers.back (), &spfRoots, &next));
+    }
+  for (std::size_t i = 0; i < nThreads; i++)
+    {
+      threads[i].join ();
+      delete workers[i];
+    }
+#endif /* HAVE_PTHREAD_H */
+}
+
+void
+GlobalRouteManagerImpl::SPFWorker (const std::vector<SpfRoot> *roots, std::atomic<std::size_t> *next)
+{
+  for (std::size_t i = (*next)++; i < roots->size (); i = (*next)++)
+    {
+      SPFCalculate ((*roots)[i]);
+    }
+}
+
+//
+// The routes of a router are its next hops to the vertices of the link state
+// graph (routers and transit networks), plus the networks and hosts which
+// these vertices advertise.  Rather than expanding them into a routing table
+// per router, whose size grows with the square of the number of routers, the
+// SPF calculations only record the next hops into a matrix shared by all the
+// routers, and the destinations are indexed once for all of them.
+//
+void
+GlobalRouteManagerImpl::BuildNextHopTable (const std::vector<Ipv4Address> &roots)
+{
+  NS_LOG_FUNCTION (this << roots.size ());
+  std::vector<GlobalRoutingLSA*> lsas;
+  m_lsdb->GetLSAs (lsas);
+  LSAIndex_t vertexIndex;
+  for (uint32_t i = 0; i < lsas.size (); i++)
+    {
+      vertexIndex[lsas[i]] = i;
+    }
+  LSAIndex_t rowIndex;
+  for (uint32_t i = 0; i < roots.size (); i++)
+    {
+      rowIndex[m_lsdb->GetLSA (roots[i])] = i;
+    }
+
+  Ptr<GlobalNextHopTable> table = Create<GlobalNextHopTable> (lsas.size (), roots.size ());
+  for (uint32_t i = 0; i < lsas.size (); i++)
+    {
+      GlobalRoutingLSA *lsa = lsas[i];
+      if (lsa->GetLSType () == GlobalRoutingLSA::NetworkLSA)
+        {
+          // As in SPFIntraAddTransit ()
+          table->AddDestination (lsa->GetLinkStateId (), lsa->GetNetworkLSANetworkMask (),
+                                 GlobalNextHopTable::NETWORK, i);
+          continue;
+        }
+      for (uint32_t j = 0; j < lsa->GetNLinkRecords (); j++)
+        {
+          GlobalRoutingLinkRecord *l = lsa->GetLinkRecord (j);
+          if (l->GetLinkType () == GlobalRoutingLinkRecord::PointToPoint)
+            {
+              // As in SPFIntraAddRouter ()
+              table->AddDestination (l->GetLinkData (), Ipv4Mask::GetOnes (),
+                                     GlobalNextHopTable::HOST, i);
+            }
+          else if (l->GetLinkType () == GlobalRoutingLinkRecord::StubNetwork)
+            {
+              // As in SPFIntraAddStub ()
+              table->AddDestination (l->GetLinkId (), Ipv4Mask (l->GetLinkData ().Get ()),
+                                     GlobalNextHopTable::NETWORK, i);
+            }
+        }
+    }
+  for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs (); i++)
+    {
+      // As in SPFAddASExternal ()
+      GlobalRoutingLSA *extlsa = m_lsdb->GetExtLSA (i);
+      LSAIndex_t::const_iterator router = vertexIndex.find (m_lsdb->GetLSA (extlsa->GetAdvertisingRouter ()));
+      if (router != vertexIndex.end ())
+        {
+          table->AddDestination (extlsa->GetLinkStateId (), extlsa->GetNetworkLSANetworkMask (),
+                                 GlobalNextHopTable::EXTERNAL, router->second);
+        }
+    }
+
+  StringValue cache;
+  g_nextHopCache.GetValue (cache);
+  uint64_t key = GetTopologyKey (lsas, roots);
+  if (cache.Get ().empty () || !table->Load (cache.Get (), key))
+    {
+      m_nextHops = PeekPointer (table);
+      m_vertexIndex = &vertexIndex;
+      m_rowIndex = &rowIndex;
+      SPFCalculate (roots);
+      m_nextHops = 0;
+      m_vertexIndex = 0;
+      m_rowIndex = 0;
+      if (!cache.Get ().empty () && !table->Save (cache.Get (), key))
+        {
+          NS_LOG_WARN ("Cannot save the next hops to " << cache.Get ());
+        }
+    }
+  NS_LOG_INFO ("Next hops of " << roots.size () << " routers to " << lsas.size () << " vertices and "
+                                << table->GetNDestinations () << " destinations");
+
+  for (uint32_t i = 0; i < roots.size (); i++)
+    {
+      Ptr<GlobalRouter> router = m_lsdb->GetLSA (roots[i])->GetNode ()->GetObject<GlobalRouter> ();
+      router->GetRoutingProtocol ()->SetNextHopTable (table, i);
+    }
+}
+
+uint64_t
+GlobalRouteManagerImpl::GetTopologyKey (const std::vector<GlobalRoutingLSA*> &lsas,
+                                        const std::vector<Ipv4Address> &roots) const
+{
+  NS_LOG_FUNCTION (this);
+  // The next hops depend on the LSDB, and on the interfaces of the roots
+  std::ostringstream topology;
+  for (uint32_t i = 0; i < lsas.size (); i++)
+    {
+      topology << *lsas[i];
+    }
+  for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs (); i++)
+    {
+      topology << *m_lsdb->GetExtLSA (i);
+    }
+  for (uint32_t i = 0; i < roots.size (); i++)
+    {
+      topology << "root " << roots[i] << std::endl;
+      Ptr<Ipv4> ipv4 = m_lsdb->GetLSA (roots[i])->GetNode ()->GetObject<Ipv4> ();
+      for (uint32_t j = 0; j < ipv4->GetNInterfaces (); j++)
+        {
+          topology << j << (ipv4->IsUp (j) ? " up" : " down");
+          for (uint32_t k = 0; k < ipv4->GetNAddresses (j); k++)
+            {
+              topology << " " << ipv4->GetAddress (j, k).GetLocal () << "/" << ipv4->GetAddress (j, k).GetMask ();
+            }
+          topology << std::endl;
+        }
+    }
+  return Hash64 (topology.str ());
+}
+
+GlobalRoutingLSA::SPFStatus
+GlobalRouteManagerImpl::GetSpfStatus (GlobalRoutingLSA* lsa) const
+{
+  std::unordered_map<GlobalRoutingLSA*, GlobalRoutingLSA::SPFStatus>::const_iterator i = m_spfStatus.find (lsa);
+  if (i == m_spfStatus.end ())
+    {
+      return GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED;
+    }
+  return i->second;
+}
+
+void
+GlobalRouteManagerImpl::SetSpfStatus (GlobalRoutingLSA* lsa, GlobalRoutingLSA::SPFStatus status)
+{
+  m_spfStatus[lsa] = status;
+}
+
+GlobalRouteManagerImpl::SpfRoot
+GlobalRouteManagerImpl::GetSpfRoot (GlobalRoutingLSA* rootLsa)
+{
+  NS_LOG_FUNCTION (rootLsa);
+  SpfRoot root;
+  root.lsa = rootLsa;
+  root.node = 0;
+  root.ipv4 = 0;
+  root.routing = 0;
+  // The LSAs built by the unit tests may have no node
+  if (NodeList::GetNNodes () == 0)
+    {
+      return root;
+    }
+  Ptr<Node> node = rootLsa->GetNode ();
+  root.node = PeekPointer (node);
+  Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
+  if (router && router->GetRouterId () == rootLsa->GetLinkStateId ())
+    {
+      root.routing = PeekPointer (router->GetRoutingProtocol ());
+      root.ipv4 = PeekPointer (node->GetObject<Ipv4> ());
+      NS_ASSERT_MSG (root.ipv4,
+                     "GlobalRouteManagerImpl::GetSpfRoot (): "
+                     "GetObject for <Ipv4> interface failed");
+    }
+  return root;
+}
+
+void
+GlobalRouteManagerImpl::SetSpfRoot (const SpfRoot &root)
+{
+  NS_LOG_FUNCTION (this << root.lsa);
+  m_spfrootNode = root.node;
+  m_spfrootIpv4 = root.ipv4;
+  m_spfrootRouting = root.routing;
+}
+
+void
+GlobalRouteManagerImpl::ClearSpfRoot (void)
+{
+  m_spfrootNode = 0;
+  m_spfrootIpv4 = 0;
+  m_spfrootRouting = 0;
+}
+
+void
+GlobalRouteManagerImpl::RecomputeRoutes ()
+{
+  NS_LOG_FUNCTION (this);
+  BooleanValue incremental;
+  g_incrementalSpf.GetValue (incremental);
+  BooleanValue nextHopTable;
+  g_nextHopTable.GetValue (nextHopTable);
+  // The shared table of next hops is always computed as a whole
+  if (!incremental.Get () || nextHopTable.Get ())
+    {
+      DeleteGlobalRoutes ();
+      BuildGlobalRoutingDatabase ();
+      InitializeRoutes ();
+      return;
+    }
+  GlobalRouteManagerLSDB* lsdb = new GlobalRouteManagerLSDB ();
+  BuildLsdb (lsdb);
+  if (!UpdateRoutes (lsdb))
+    {
+      NS_LOG_INFO ("Incremental update not possible, recomputing all the routes");
+      DeleteGlobalRoutes ();
+      delete m_lsdb;
+      m_lsdb = lsdb;
+      InitializeRoutes ();
+    }
+}
+
+bool
+GlobalRouteManagerImpl::LinkStateEdge::operator< (const LinkStateEdge &other) const
+{
+  if (to != other.to)
+    {
+      return to < other.to;
+    }
+  if (cost != other.cost)
+    {
+      return cost < other.cost;
+    }
+  return linkData < other.linkData;
+}
+
+void
+GlobalRouteManagerImpl::BuildLinkStateGraph (GlobalRouteManagerLSDB* lsdb,
+                                             const std::vector<GlobalRoutingLSA*> &lsas,
+                                             const LSAIndex_t &index,
+                                             LinkStateGraph_t &graph)
+{
+  graph.assign (lsas.size (), std::vector<LinkStateEdge> ());
+  for (uint32_t i = 0; i < lsas.size (); i++)
+    {
+      GlobalRoutingLSA *lsa = lsas[i];
+      LinkStateEdge edge;
+      if (lsa->GetLSType () == GlobalRoutingLSA::RouterLSA)
+        {
+          // Links to routers and to transit networks, as followed by SPFNext ()
+          for (uint32_t j = 0; j < lsa->GetNLinkRecords (); j++)
+            {
+              GlobalRoutingLinkRecord *l = lsa->GetLinkRecord (j);
+              if (l->GetLinkType () == GlobalRoutingLinkRecord::StubNetwork)
+                {
+                  continue;
+                }
+              LSAIndex_t::const_iterator w = index.find (lsdb->GetLSA (l->GetLinkId ()));
+              if (w == index.end ())
+                {
+                  continue;
+                }
+              edge.to = w->second;
+              edge.cost = l->GetMetric ();
+              edge.linkData = l->GetLinkData ();
+              graph[i].push_back (edge);
+            }
+        }
+      else if (lsa->GetLSType () == GlobalRoutingLSA::NetworkLSA)
+        {
+          // Links to the attached routers, at no cost
+          for (uint32_t j = 0; j < lsa->GetNAttachedRouters (); j++)
+            {
+              LSAIndex_t::const_iterator w = index.find (lsdb->GetLSAByLinkData (lsa->GetAttachedRouter (j)));
+              if (w == index.end ())
+                {
+                  continue;
+                }
+              edge.to = w->second;
+              edge.cost = 0;
+              edge.linkData = lsa->GetAttachedRouter (j);
+              graph[i].push_back (edge);
+            }
+        }
+      std::sort (graph[i].begin (), graph[i].end ());
+    }
+}
+
+void
+GlobalRouteManagerImpl::GetDistancesTo (const LinkStateGraph_t &graph,
+                                        uint32_t target,
+                                        std::vector<uint32_t> &distances)
+{
+  // Dijkstra on the reversed graph: distances[i] is the distance from i to target
+  std::vector<std::vector<std::pair<uint32_t, uint32_t> > > reversed (graph.size ());
+  for (uint32_t i = 0; i < graph.size (); i++)
+    {
+      for (std::vector<LinkStateEdge>::const_iterator e = graph[i].begin (); e != graph[i].end (); e++)
+        {
+          reversed[e->to].push_back (std::make_pair (i, e->cost));
+        }
+    }
+  distances.assign (graph.size (), SPF_INFINITY);
+  typedef std::pair<uint32_t, uint32_t> Item_t; // distance, vertex
+  std::priority_queue<Item_t, std::vector<Item_t>, std::greater<Item_t> > queue;
+  distances[target] = 0;
+  queue.push (Item_t (0, target));
+  while (!queue.empty ())
+    {
+      Item_t item = queue.top ();
+      queue.pop ();
+      if (item.first > distances[item.second])
+        {
+          continue;
+        }
+      for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator e = reversed[item.second].begin ();
+           e != reversed[item.second].end (); e++)
+        {
+          uint32_t distance = item.first + e->second;
+          if (distance < distances[e->first])
+            {
+              distances[e->first] = distance;
+              queue.push (Item_t (distance, e->first));
+            }
+        }
+    }
+}
+
+//
+// Mirror of the test done by CheckForStubNode (), without installing any
+// route: a stub router has no transit link, or a single point-to-point link
+// to a router which has a link back to it.
+//
+static bool
+IsStubRouter (GlobalRouteManagerLSDB* lsdb, GlobalRoutingLSA* rlsa, GlobalRoutingLSA** neighbor)
+{
+  *neighbor = 0;
+  int transits = 0;
+  GlobalRoutingLinkRecord *transitLink = 0;
+  for (uint32_t i = 0; i < rlsa->GetNLinkRecords (); i++)
+    {
+      GlobalRoutingLinkRecord *l = rlsa->GetLinkRecord (i);
+      if (l->GetLinkType () == GlobalRoutingLinkRecord::TransitNetwork
+          || l->GetLinkType () == GlobalRoutingLinkRecord::PointToPoint)
+        {
+          transits++;
+          transitLink = l;
+        }
+    }
+  if (transits == 0)
+    {
+      return true;
+    }
+  if (transits == 1 && transitLink->GetLinkType () == GlobalRoutingLinkRecord::PointToPoint)
+    {
+      GlobalRoutingLSA *w_lsa = lsdb->GetLSA (transitLink->GetLinkId ());
+      for (uint32_t j = 0; w_lsa && j < w_lsa->GetNLinkRecords (); ++j)
+        {
+          GlobalRoutingLinkRecord *lr = w_lsa->GetLinkRecord (j);
+          if (lr->GetLinkType () == GlobalRoutingLinkRecord::PointToPoint
+              && lr->GetLinkId () == rlsa->GetLinkStateId ())
+            {
+              *neighbor = w_lsa;
+              return true;
+            }
+        }
+    }
+  return false;
+}
+
+/**
+ * Get the stub networks and the point-to-point addresses of a router, to
+ * which SPFIntraAddStub () and SPFIntraAddRouter () add routes.
+ * \param lsa the router LSA
+ * \param stubs the sorted stub networks and masks
+ * \param hosts the sorted point-to-point addresses
+ */
+static void
+GetRouterDestinations (GlobalRoutingLSA* lsa,
+                       std::vector<std::pair<Ipv4Address, Ipv4Address> > &stubs,
+                       std::vector<Ipv4Address> &hosts)
+{
+  stubs.clear ();
+  hosts.clear ();
+  for (uint32_t i = 0; i < lsa->GetNLinkRecords (); i++)
+    {
+      GlobalRoutingLinkRecord *l = lsa->GetLinkRecord (i);
+      if (l->GetLinkType () == GlobalRoutingLinkRecord::StubNetwork)
+        {
+          Ipv4Mask mask (l->GetLinkData ().Get ());
+          stubs.push_back (std::make_pair (l->GetLinkId ().CombineMask (mask), l->GetLinkData ()));
+        }
+      else if (l->GetLinkType () == GlobalRoutingLinkRecord::PointToPoint)
+        {
+          hosts.push_back (l->GetLinkData ());
+        }
+    }
+  std::sort (stubs.begin (), stubs.end ());
+  std::sort (hosts.begin (), hosts.end ());
+}
+
+//
+// Incremental update of the routes, after a change of the link states.
+//
+// The routes of a router, and their order in its routing table, only depend
+// on the order in which its SPF calculation explores the link state graph,
+// and on the destinations advertised by the routers it reaches.  An edge
+// u->w of the graph is ignored by the calculation if w is closer to the
+// root than u, since w is then already in the SPF tree when u is explored;
+// the calculation is thus unchanged if every removed edge was ignored in
+// the old graph, and every added edge is ignored in the new graph.  Both
+// tests only need the distances of all the routers to the ends of the
+// changed edges, which are given by a few Dijkstra runs on the reversed
+// graphs.
+//
+// The routers whose calculation may have changed, or which reach a router
+// whose destinations changed, are recomputed from scratch; the others keep
+// their routing tables, which are the same as after a full recomputation.
+//
+bool
+GlobalRouteManagerImpl::UpdateRoutes (GlobalRouteManagerLSDB* lsdb)
+{
+  NS_LOG_FUNCTION (this << lsdb);
+  std::vector<GlobalRoutingLSA*> oldLsas;
+  std::vector<GlobalRoutingLSA*> newLsas;
+  m_lsdb->GetLSAs (oldLsas);
+  lsdb->GetLSAs (newLsas);
+//
+// Only changes of the links of the existing routers and networks are
+// supported, and the AS-external routes must be unchanged.
+//
+  if (oldLsas.empty () || oldLsas.size () != newLsas.size ()
+      || m_lsdb->GetNumExtLSAs () != lsdb->GetNumExtLSAs ())
+    {
+      return false;
+    }
+  LSAIndex_t oldIndex;
+  LSAIndex_t newIndex;
+  for (uint32_t i = 0; i < newLsas.size (); i++)
+    {
+      if (oldLsas[i]->GetLinkStateId () != newLsas[i]->GetLinkStateId ()
+          || oldLsas[i]->GetLSType () != newLsas[i]->GetLSType ()
+          || (newLsas[i]->GetLSType () == GlobalRoutingLSA::NetworkLSA
+              && oldLsas[i]->GetNetworkLSANetworkMask () != newLsas[i]->GetNetworkLSANetworkMask ()))
+        {
+          return false;
+        }
+      oldIndex[oldLsas[i]] = i;
+      newIndex[newLsas[i]] = i;
+    }
+  for (uint32_t i = 0; i < lsdb->GetNumExtLSAs (); i++)
+    {
+      GlobalRoutingLSA *oldExt = m_lsdb->GetExtLSA (i);
+      GlobalRoutingLSA *newExt = lsdb->GetExtLSA (i);
+      if (oldExt->GetLinkStateId () != newExt->GetLinkStateId ()
+          || oldExt->GetNetworkLSANetworkMask () != newExt->GetNetworkLSANetworkMask ()
+          || oldExt->GetAdvertisingRouter () != newExt->GetAdvertisingRouter ())
+        {
+          return false;
+        }
+    }
+
+  LinkStateGraph_t oldGraph;
+  LinkStateGraph_t newGraph;
+  BuildLinkStateGraph (m_lsdb, oldLsas, oldIndex, oldGraph);
+  BuildLinkStateGraph (lsdb, newLsas, newIndex, newGraph);
+//
+// Find the changed edges and the routers whose destinations changed.
+//
+  uint32_t n = newLsas.size ();
+  std::vector<bool> changed (n, false);
+  std::vector<std::pair<uint32_t, LinkStateEdge> > removedEdges;
+  std::vector<std::pair<uint32_t, LinkStateEdge> > addedEdges;
+  std::vector<uint32_t> changedRouters;
+  std::vector<std::pair<Ipv4Address, Ipv4Address> > oldStubs;
+  std::vector<std::pair<Ipv4Address, Ipv4Address> > newStubs;
+  std::vector<Ipv4Address> oldHosts;
+  std::vector<Ipv4Address> newHosts;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      std::vector<LinkStateEdge> edges;
+      std::set_difference (oldGraph[i].begin (), oldGraph[i].end (),
+                           newGraph[i].begin (), newGraph[i].end (), std::back_inserter (edges));
+      for (std::vector<LinkStateEdge>::const_iterator e = edges.begin (); e != edges.end (); e++)
+        {
+          removedEdges.push_back (std::make_pair (i, *e));
+        }
+      changed[i] = !edges.empty ();
+      edges.clear ();
+      std::set_difference (newGraph[i].begin (), newGraph[i].end (),
+                           oldGraph[i].begin (), oldGraph[i].end (), std::back_inserter (edges));
+      for (std::vector<LinkStateEdge>::const_iterator e = edges.begin (); e != edges.end (); e++)
+        {
+          addedEdges.push_back (std::make_pair (i, *e));
+        }
+      changed[i] = changed[i] || !edges.empty ();
+      if (newLsas[i]->GetLSType () == GlobalRoutingLSA::RouterLSA)
+        {
+          GetRouterDestinations (oldLsas[i], oldStubs, oldHosts);
+          GetRouterDestinations (newLsas[i], newStubs, newHosts);
+          if (oldStubs != newStubs || oldHosts != newHosts)
+            {
+              changed[i] = true;
+              changedRouters.push_back (i);
+            }
+        }
+    }
+  NS_LOG_LOGIC (removedEdges.size () << " removed edges, " << addedEdges.size () <<
+                " added edges, " << changedRouters.size () << " routers with changed destinations");
+//
+// The routers whose links changed, or attached to a network whose links
+// changed, are recomputed.
+//
+  std::vector<bool> affected (n, false);
+  std::vector<std::pair<uint32_t, LinkStateEdge> > changedEdges (removedEdges);
+  changedEdges.insert (changedEdges.end (), addedEdges.begin (), addedEdges.end ());
+  for (std::vector<std::pair<uint32_t, LinkStateEdge> >::const_iterator e = changedEdges.begin ();
+       e != changedEdges.end (); e++)
+    {
+      uint32_t ends[2] = {e->first, e->second.to};
+      for (uint32_t k = 0; k < 2; k++)
+        {
+          affected[ends[k]] = true;
+          if (newLsas[ends[k]]->GetLSType () == GlobalRoutingLSA::NetworkLSA)
+            {
+              for (uint32_t j = 0; j < oldGraph[ends[k]].size (); j++)
+                {
+                  affected[oldGraph[ends[k]][j].to] = true;
+                }
+              for (uint32_t j = 0; j < newGraph[ends[k]].size (); j++)
+                {
+                  affected[newGraph[ends[k]][j].to] = true;
+                }
+            }
+        }
+    }
+  for (uint32_t i = 0; i < changedRouters.size (); i++)
+    {
+      affected[changedRouters[i]] = true;
+    }
+//
+// Then, the routers whose SPF calculation may have changed.
 //
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      uint32_t systemId = Simulator::GetSystemId ();
-      // Ignore nodes that are not assigned to our systemId (distributed sim)
-      if (node->GetSystemId () != systemId) 
+  std::map<uint32_t, std::vector<uint32_t> > oldDistances;
+  std::map<uint32_t, std::vector<uint32_t> > newDistances;
+  for (std::vector<std::pair<uint32_t, LinkStateEdge> >::const_iterator e = changedEdges.begin ();
+       e != changedEdges.end (); e++)
+    {
+      bool removed = e - changedEdges.begin () < static_cast<std::ptrdiff_t> (removedEdges.size ());
+      const LinkStateGraph_t &graph = removed ? oldGraph : newGraph;
+      std::map<uint32_t, std::vector<uint32_t> > &distances = removed ? oldDistances : newDistances;
+      for (uint32_t end : {e->first, e->second.to})
         {
-          continue;
+          if (distances.find (end) == distances.end ())
+            {
+              GetDistancesTo (graph, end, distances[end]);
+            }
         }
-
+    }
 //
-// if the node has a global router interface, then run the global routing
-// algorithms.
+// And the routers which reach a router whose destinations changed: their
+// routes to these destinations could be patched, but not in the order in
+// which a full calculation adds them, which matters for the selection of
+// the routes and when several routers advertise the same destination.
 //
-      if (rtr && rtr->GetNumLSAs () )
+  std::vector<std::vector<uint32_t> > oldChangedDistances (changedRouters.size ());
+  std::vector<std::vector<uint32_t> > newChangedDistances (changedRouters.size ());
+  for (uint32_t i = 0; i < changedRouters.size (); i++)
+    {
+      GetDistancesTo (oldGraph, changedRouters[i], oldChangedDistances[i]);
+      GetDistancesTo (newGraph, changedRouters[i], newChangedDistances[i]);
+    }
+  std::vector<Ipv4Address> roots;
+  uint32_t systemId = Simulator::GetSystemId ();
+  for (uint32_t r = 0; r < n; r++)
+    {
+      GlobalRoutingLSA *rootLsa = newLsas[r];
+      Ptr<Node> node = rootLsa->GetNode ();
+      if (rootLsa->GetLSType () != GlobalRoutingLSA::RouterLSA || node == 0
+          || node->GetSystemId () != systemId || node->GetObject<GlobalRouter> () == 0)
+        {
+          continue;
+        }
+      GlobalRoutingLSA *oldNeighbor;
+      GlobalRoutingLSA *newNeighbor;
+      bool oldStub = IsStubRouter (m_lsdb, oldLsas[r], &oldNeighbor);
+      bool newStub = IsStubRouter (lsdb, newLsas[r], &newNeighbor);
+      if (!affected[r] && (oldStub || newStub))
+        {
+          // A stub router only has a default route to its neighbor
+          affected[r] = (oldNeighbor && changed[oldIndex[oldNeighbor]])
+            || (newNeighbor && changed[newIndex[newNeighbor]]);
+          if (!affected[r])
+            {
+              continue;
+            }
+        }
+      for (std::vector<std::pair<uint32_t, LinkStateEdge> >::const_iterator e = changedEdges.begin ();
+           !affected[r] && e != changedEdges.end (); e++)
+        {
+          bool removed = e - changedEdges.begin () < static_cast<std::ptrdiff_t> (removedEdges.size ());
+          std::map<uint32_t, std::vector<uint32_t> > &distances = removed ? oldDistances : newDistances;
+          uint32_t from = distances[e->first][r];
+          uint32_t to = distances[e->second.to][r];
+          affected[r] = from != SPF_INFINITY && to >= from;
+        }
+      for (uint32_t i = 0; !affected[r] && i < changedRouters.size (); i++)
+        {
+          affected[r] = oldChangedDistances[i][r] != SPF_INFINITY
+            || newChangedDistances[i][r] != SPF_INFINITY;
+        }
+      if (affected[r])
         {
-          SPFCalculate (rtr->GetRouterId ());
+          roots.push_back (rootLsa->GetLinkStateId ());
+          Ptr<Ipv4GlobalRouting> gr = node->GetObject<GlobalRouter> ()->GetRoutingProtocol ();
+          NS_LOG_LOGIC ("Deleting " << gr->GetNRoutes () << " routes from node " << node->GetId ());
+          while (gr->GetNRoutes () > 0)
+            {
+              gr->RemoveRoute (0);
+            }
         }
     }
-  NS_LOG_INFO ("Finished SPF calculation");
+  NS_LOG_INFO ("Recomputing the routes of " << roots.size () << " routers");
+//
+// Recompute the affected routers on the new database.
+//
+  delete m_lsdb;
+  m_lsdb = lsdb;
+  SPFCalculate (roots);
+  return true;
 }
 
 //
@@ -835,7 +1645,7 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
 // If the link is to a router that is already in the shortest path first tree
 // then we have it covered -- ignore it.
 //
-      if (w_lsa->GetStatus () == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE) 
+      if (GetSpfStatus (w_lsa) == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE) 
         {
           NS_LOG_LOGIC ("Skipping ->  LSA "<< 
                         w_lsa->GetLinkStateId () << " already in SPF tree");
@@ -860,7 +1670,7 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
       NS_LOG_LOGIC ("Considering w_lsa " << w_lsa->GetLinkStateId ());
 
 // Is there already vertex w in candidate list?
-      if (w_lsa->GetStatus () == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
+      if (GetSpfStatus (w_lsa) == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
         {
 // Calculate nexthop to w
 // We need to figure out how to actually get to the new router represented
@@ -872,7 +1682,7 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
           w = new SPFVertex (w_lsa);
           if (SPFNexthopCalculation (v, w, l, distance))
             {
-              w_lsa->SetStatus (GlobalRoutingLSA::LSA_SPF_CANDIDATE);
+              SetSpfStatus (w_lsa, GlobalRoutingLSA::LSA_SPF_CANDIDATE);
 //
 // Push this new vertex onto the priority queue (ordered by distance from the
 // root node).
@@ -887,7 +1697,7 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
             NS_ASSERT_MSG (0, "SPFNexthopCalculation never " 
                            << "return false, but it does now!");
         }
-      else if (w_lsa->GetStatus () == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
+      else if (GetSpfStatus (w_lsa) == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
         {
 //
 // We have already considered the link represented by <w>.  What wse have to
@@ -1123,7 +1933,8 @@ GlobalRouteManagerImpl::SPFNexthopCalculation (
         }
       else 
         {
-          w->SetRootExitDirection (v->GetRootExitDirection ());
+// The network may be reached through several equal-cost exits
+          w->InheritAllRootExitDirections (v);
         }
     }
   else 
@@ -1246,7 +2057,9 @@ void
 GlobalRouteManagerImpl::DebugSPFCalculate (Ipv4Address root)
 {
   NS_LOG_FUNCTION (this << root);
-  SPFCalculate (root);
+  GlobalRoutingLSA *rootLsa = m_lsdb->GetLSA (root);
+  NS_ASSERT_MSG (rootLsa, "GlobalRouteManagerImpl::DebugSPFCalculate (): No LSA for root " << root);
+  SPFCalculate (GetSpfRoot (rootLsa));
 }
 
 //
@@ -1319,9 +2132,7 @@ GlobalRouteManagerImpl::CheckForStubNode (Ipv4Address root)
               if (lr->GetLinkId () == myRouterId)
                 {
                   // Next hop is stored in the LinkID field of lr
-                  Ptr<GlobalRouter> router = rlsa->GetNode ()->GetObject<GlobalRouter> ();
-                  NS_ASSERT (router);
-                  Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
+                  Ipv4GlobalRouting *gr = m_spfrootRouting;
                   NS_ASSERT (gr);
                   gr->AddNetworkRouteTo (Ipv4Address ("0.0.0.0"), Ipv4Mask ("0.0.0.0"), lr->GetLinkData (), 
                                          FindOutgoingInterfaceId (transitLink->GetLinkData ()));
@@ -1338,15 +2149,25 @@ GlobalRouteManagerImpl::CheckForStubNode (Ipv4Address root)
 
 // quagga ospf_spf_calculate
 void
-GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
+GlobalRouteManagerImpl::SPFCalculate (const SpfRoot &spfRoot)
 {
+  GlobalRoutingLSA *rootLsa = spfRoot.lsa;
+  Ipv4Address root = rootLsa->GetLinkStateId ();
   NS_LOG_FUNCTION (this << root);
 
   SPFVertex *v;
 //
-// Initialize the Link State Database.
+// Forget the status of the LSAs in the previous calculation.  The status is
+// kept here rather than in the (shared) LSAs, so that several calculations
+// can run on the same Link State Database at the same time.
+//
+  m_spfStatus.clear ();
+//
+// The node at the root of the calculation, whose routing table is going to
+// be written, has been looked up by the caller.  Only this node is accessed
+// during the calculation.
 //
-  m_lsdb->Initialize ();
+  SetSpfRoot (spfRoot);
 //
 // The candidate queue is a priority queue of SPFVertex objects, with the top
 // of the queue being the closest vertex in terms of distance from the root
@@ -1359,14 +2180,14 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 // calculation.  Each router (and corresponding network) is a vertex in the
 // shortest path first (SPF) tree.
 //
-  v = new SPFVertex (m_lsdb->GetLSA (root));
+  v = new SPFVertex (rootLsa);
 // 
 // This vertex is the root of the SPF tree and it is distance 0 from the root.
 // We also mark this vertex as being in the SPF tree.
 //
   m_spfroot= v;
   v->SetDistanceFromRoot (0);
-  v->GetLSA ()->SetStatus (GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+  SetSpfStatus (v->GetLSA (), GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
   NS_LOG_LOGIC ("Starting SPFCalculate for node " << root);
 
 //
@@ -1376,10 +2197,12 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 // reached.  Instead, short-circuit this computation and just install
 // a default route in the CheckForStubNode() method.
 //
-  if (NodeList::GetNNodes () > 0 && CheckForStubNode (root))
+  if (!m_nextHops && m_spfrootNode != 0 && CheckForStubNode (root))
     {
       NS_LOG_LOGIC ("SPFCalculate truncated for stub node " << root);
       delete m_spfroot;
+      m_spfroot = 0;
+      ClearSpfRoot ();
       return;
     }
 
@@ -1427,7 +2250,7 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 // Update the status field of the vertex to indicate that it is in the SPF
 // tree.
 //
-      v->GetLSA ()->SetStatus (GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+      SetSpfStatus (v->GetLSA (), GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
 //
 // The current vertex has a parent pointer.  By calling this rather oddly 
 // named method (blame quagga) we add the current vertex to the list of 
@@ -1437,6 +2260,20 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 //
       SPFVertexAddParent (v);
 //
+// When filling a table of next hops, only the first next hop from the root
+// to the vertex is recorded.  The destinations behind the vertex share it.
+//
+      if (m_nextHops)
+        {
+          if (v->GetNRootExitDirections () > 0 && v->GetRootExitDirection (0).second >= 0)
+            {
+              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (0);
+              m_nextHops->SetNextHop (m_rowIndex->at (rootLsa), m_vertexIndex->at (v->GetLSA ()),
+                                      exit.first, exit.second);
+            }
+          continue;
+        }
+//
 // Note that when there is a choice of vertices closest to the root, network
 // vertices must be chosen before router vertices in order to necessarily
 // find all equal-cost paths. 
@@ -1484,14 +2321,18 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 
     }  // end for loop
 
-// Second stage of SPF calculation procedure
-  SPFProcessStubs (m_spfroot);
-  for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs (); i++)
+// Second stage of SPF calculation procedure, unless filling a table of next
+// hops, whose destinations are the same for all the roots
+  if (!m_nextHops)
     {
-      m_spfroot->ClearVertexProcessed ();
-      GlobalRoutingLSA *extlsa = m_lsdb->GetExtLSA (i);
-      NS_LOG_LOGIC ("Processing External LSA with id " << extlsa->GetLinkStateId ());
-      ProcessASExternals (m_spfroot, extlsa);
+      SPFProcessStubs (m_spfroot);
+      for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs (); i++)
+        {
+          m_spfroot->ClearVertexProcessed ();
+          GlobalRoutingLSA *extlsa = m_lsdb->GetExtLSA (i);
+          NS_LOG_LOGIC ("Processing External LSA with id " << extlsa->GetLinkStateId ());
+          ProcessASExternals (m_spfroot, extlsa);
+        }
     }
 
 //
@@ -1501,6 +2342,7 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 //
   delete m_spfroot;
   m_spfroot = 0;
+  ClearSpfRoot ();
 }
 
 void
@@ -1554,110 +2396,57 @@ GlobalRouteManagerImpl::SPFAddASExternal (GlobalRoutingLSA *extlsa, SPFVertex *v
     }
   NS_LOG_LOGIC ("External is on remote host: " 
                 << extlsa->GetAdvertisingRouter () << "; installing");
-
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
 //
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
+// The routing information is written to the node at the root of the SPF
+// tree, which SPFCalculate () has looked up from the root's LSA.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  if (m_spfrootRouting == 0)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to QI for that interface.  If there's no GlobalRouter interface, the node
-// in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to QI
-// for that interface.  If the node is acting as an IP version 4 router, it
-// should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "QI for <Ipv4> interface failed");
+      NS_LOG_LOGIC ("No global routing protocol at root " << m_spfroot->GetVertexId ());
+      return;
+    }
+  NS_LOG_LOGIC ("Setting routes for node " << m_spfrootNode->GetId ());
 //
 // Get the Global Router Link State Advertisement from the vertex we're
 // adding the routes to.  The LSA will have a number of attached Global Router
 // Link Records corresponding to links off of that vertex / node.  We're going
 // to be interested in the records corresponding to point-to-point links.
 //
-          NS_ASSERT_MSG (v->GetLSA (), 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask ();
-          Ipv4Address tempip = extlsa->GetLinkStateId ();
-          tempip = tempip.CombineMask (tempmask);
-
-//
-// Here's why we did all of that work.  We're going to add a host route to the
-// host address found in the m_linkData field of the point-to-point link
-// record.  In the case of a point-to-point link, this is the local IP address
-// of the node connected to the link.  Each of these point-to-point links
-// will correspond to a local interface that has an IP address to which
-// the node at the root of the SPF tree can send packets.  The vertex <v> 
-// (corresponding to the node that has these links and interfaces) has 
-// an m_nextHop address precalculated for us that is the address to which the
-// root node should send packets to be forwarded to these IP addresses.
-// Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-// which the packets should be send for forwarding.
-//
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all next-hop-IPs and out-going-interfaces for reaching
-          // the stub network gateway 'v' from the root node
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
-              if (outIf >= 0)
-                {
-                  gr->AddASExternalRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add external network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative");
-                }
-            }
-          return;
-        } // if
-    } // for
+  NS_ASSERT_MSG (v->GetLSA (), 
+                 "GlobalRouteManagerImpl::SPFAddASExternal (): "
+                 "Expected valid LSA in SPFVertex* v");
+  Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask ();
+  Ipv4Address tempip = extlsa->GetLinkStateId ();
+  tempip = tempip.CombineMask (tempmask);
+//
+// The vertex <v> has an m_nextHop address precalculated for us that is the
+// address to which the root node should send packets to be forwarded to the
+// external network.  Similarly, the vertex <v> has an m_rootOif (outbound
+// interface index) to which the packets should be send for forwarding.
+//
+  // walk through all next-hop-IPs and out-going-interfaces for reaching
+  // the stub network gateway 'v' from the root node
+  for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+    {
+      SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+      Ipv4Address nextHop = exit.first;
+      int32_t outIf = exit.second;
+      if (outIf >= 0)
+        {
+          m_spfrootRouting->AddASExternalRouteTo (tempip, tempmask, nextHop, outIf);
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfrootNode->GetId () <<
+                        " add external network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
+        }
+      else
+        {
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfrootNode->GetId () <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative");
+        }
+    }
 }
 
 
@@ -1719,122 +2508,65 @@ GlobalRouteManagerImpl::SPFIntraAddStub (GlobalRoutingLinkRecord *l, SPFVertex*
   NS_LOG_LOGIC ("Stub is on remote host: " << v->GetVertexId () << "; installing");
 //
 // The root of the Shortest Path First tree is the router to which we are 
-// going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
+// going to write the actual routing table entries.  SPFCalculate () has
+// looked up the node of this router from the root's LSA.
 //
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
-//
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  if (m_spfrootRouting == 0)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to QI for that interface.  If there's no GlobalRouter interface, the node
-// in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to QI
-// for that interface.  If the node is acting as an IP version 4 router, it
-// should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "QI for <Ipv4> interface failed");
+      NS_LOG_LOGIC ("No global routing protocol at root " << m_spfroot->GetVertexId ());
+      return;
+    }
+  NS_LOG_LOGIC ("Setting routes for node " << m_spfrootNode->GetId ());
 //
 // Get the Global Router Link State Advertisement from the vertex we're
 // adding the routes to.  The LSA will have a number of attached Global Router
 // Link Records corresponding to links off of that vertex / node.  We're going
 // to be interested in the records corresponding to point-to-point links.
 //
-          NS_ASSERT_MSG (v->GetLSA (), 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask (l->GetLinkData ().Get ());
-          Ipv4Address tempip = l->GetLinkId ();
-          tempip = tempip.CombineMask (tempmask);
-//
-// Here's why we did all of that work.  We're going to add a host route to the
-// host address found in the m_linkData field of the point-to-point link
-// record.  In the case of a point-to-point link, this is the local IP address
-// of the node connected to the link.  Each of these point-to-point links
-// will correspond to a local interface that has an IP address to which
-// the node at the root of the SPF tree can send packets.  The vertex <v> 
-// (corresponding to the node that has these links and interfaces) has 
-// an m_nextHop address precalculated for us that is the address to which the
-// root node should send packets to be forwarded to these IP addresses.
-// Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-// which the packets should be send for forwarding.
-//
-
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all next-hop-IPs and out-going-interfaces for reaching
-          // the stub network gateway 'v' from the root node
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
-              if (outIf >= 0)
-                {
-                  gr->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative");
-                }
-            }
-          return;
-        } // if
-    } // for
+  NS_ASSERT_MSG (v->GetLSA (), 
+                 "GlobalRouteManagerImpl::SPFIntraAddStub (): "
+                 "Expected valid LSA in SPFVertex* v");
+  Ipv4Mask tempmask (l->GetLinkData ().Get ());
+  Ipv4Address tempip = l->GetLinkId ();
+  tempip = tempip.CombineMask (tempmask);
+//
+// Here's why we did all of that work.  We're going to add a network route to
+// the stub network found in the link record.  The vertex <v> (corresponding
+// to the node that has this stub network) has an m_nextHop address
+// precalculated for us that is the address to which the root node should
+// send packets to be forwarded to this network.  Similarly, the vertex <v>
+// has an m_rootOif (outbound interface index) to which the packets should be
+// send for forwarding.
+//
+  // walk through all next-hop-IPs and out-going-interfaces for reaching
+  // the stub network gateway 'v' from the root node
+  for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+    {
+      SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+      Ipv4Address nextHop = exit.first;
+      int32_t outIf = exit.second;
+      if (outIf >= 0)
+        {
+          m_spfrootRouting->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfrootNode->GetId () <<
+                        " add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
+        }
+      else
+        {
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfrootNode->GetId () <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative");
+        }
+    }
 }
 
 //
 // Return the interface number corresponding to a given IP address and mask
-// This is a wrapper around GetInterfaceForPrefix(), but we first
-// have to find the right node pointer to pass to that function.
+// This is a wrapper around GetInterfaceForPrefix() of the node at the root
+// of the SPF tree.
 // If no such interface is found, return -1 (note:  unit test framework
 // for routing assumes -1 to be a legal return value)
 //
@@ -1843,70 +2575,24 @@ GlobalRouteManagerImpl::FindOutgoingInterfaceId (Ipv4Address a, Ipv4Mask amask)
 {
   NS_LOG_FUNCTION (this << a << amask);
 //
-// We have an IP address <a> and a vertex ID of the root of the SPF tree.
+// We have an IP address <a> and the Ipv4 interface of the node at the root
+// of the SPF tree, which SPFCalculate () has looked up from the root's LSA.
 // The question is what interface index does this address correspond to.
-// The answer is a little complicated since we have to find a pointer to
-// the node corresponding to the vertex ID, find the Ipv4 interface on that
-// node in order to iterate the interfaces and find the one corresponding to
-// the address in question.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
 //
-// Walk the list of nodes in the system looking for the one corresponding to
-// the node at the root of the SPF tree.  This is the node for which we are
-// building the routing table.
-//
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  if (m_spfrootIpv4 == 0)
     {
-      Ptr<Node> node = *i;
-
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-//
-// If the node doesn't have a GlobalRouter interface it can't be the one
-// we're interested in.
-//
-      if (rtr == 0)
-        {
-          continue;
-        }
-
-      if (rtr->GetRouterId () == routerId)
-        {
 //
-// This is the node we're building the routing table for.  We're going to need
-// the Ipv4 interface to look for the ipv4 interface index.  Since this node
-// is participating in routing IP version 4 packets, it certainly must have 
-// an Ipv4 interface.
+// Couldn't find it.
 //
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
-                         "GetObject for <Ipv4> interface failed");
+      NS_LOG_LOGIC ("FindOutgoingInterfaceId():Can't find root node " << m_spfroot->GetVertexId ());
+      return -1;
+    }
 //
 // Look through the interfaces on this node for one that has the IP address
 // we're looking for.  If we find one, return the corresponding interface
 // index, or -1 if not found.
 //
-          int32_t interface = ipv4->GetInterfaceForPrefix (a, amask);
-
-#if 0
-          if (interface < 0)
-            {
-              NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
-                              "Expected an interface associated with address a:" << a);
-            }
-#endif 
-          return interface;
-        }
-    }
-//
-// Couldn't find it.
-//
-  NS_LOG_LOGIC ("FindOutgoingInterfaceId():Can't find root node " << routerId);
-  return -1;
+  return m_spfrootIpv4->GetInterfaceForPrefix (a, amask);
 }
 
 //
@@ -1934,69 +2620,27 @@ GlobalRouteManagerImpl::SPFIntraAddRouter (SPFVertex* v)
                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): Root pointer not set");
 //
 // The root of the Shortest Path First tree is the router to which we are 
-// going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
+// going to write the actual routing table entries.  SPFCalculate () has
+// looked up the node of this router from the root's LSA.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  if (m_spfrootRouting == 0)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to GetObject for that interface.  If there's no GlobalRouter interface, 
-// the node in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to 
-// GetObject for that interface.  If the node is acting as an IP version 4 
-// router, it should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "GetObject for <Ipv4> interface failed");
+      NS_LOG_LOGIC ("No global routing protocol at root " << m_spfroot->GetVertexId ());
+      return;
+    }
+  NS_LOG_LOGIC ("Setting routes for node " << m_spfrootNode->GetId ());
 //
 // Get the Global Router Link State Advertisement from the vertex we're
 // adding the routes to.  The LSA will have a number of attached Global Router
 // Link Records corresponding to links off of that vertex / node.  We're going
 // to be interested in the records corresponding to point-to-point links.
 //
-          GlobalRoutingLSA *lsa = v->GetLSA ();
-          NS_ASSERT_MSG (lsa, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
+  GlobalRoutingLSA *lsa = v->GetLSA ();
+  NS_ASSERT_MSG (lsa, 
+                 "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                 "Expected valid LSA in SPFVertex* v");
 
-          uint32_t nLinkRecords = lsa->GetNLinkRecords ();
+  uint32_t nLinkRecords = lsa->GetNLinkRecords ();
 //
 // Iterate through the link records on the vertex to which we're going to add
 // routes.  To make sure we're being clear, we're going to add routing table
@@ -2005,18 +2649,18 @@ GlobalRouteManagerImpl::SPFIntraAddRouter (SPFVertex* v)
 // the local side of the point-to-point links found on the node described by
 // the vertex <v>.
 //
-          NS_LOG_LOGIC (" Node " << node->GetId () <<
-                        " found " << nLinkRecords << " link records in LSA " << lsa << "with LinkStateId "<< lsa->GetLinkStateId ());
-          for (uint32_t j = 0; j < nLinkRecords; ++j)
-            {
+  NS_LOG_LOGIC (" Node " << m_spfrootNode->GetId () <<
+                " found " << nLinkRecords << " link records in LSA " << lsa << "with LinkStateId "<< lsa->GetLinkStateId ());
+  for (uint32_t j = 0; j < nLinkRecords; ++j)
+    {
 //
 // We are only concerned about point-to-point links
 //
-              GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
-              if (lr->GetLinkType () != GlobalRoutingLinkRecord::PointToPoint)
-                {
-                  continue;
-                }
+      GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
+      if (lr->GetLinkType () != GlobalRoutingLinkRecord::PointToPoint)
+        {
+          continue;
+        }
 //
 // Here's why we did all of that work.  We're going to add a host route to the
 // host address found in the m_linkData field of the point-to-point link
@@ -2030,46 +2674,34 @@ GlobalRouteManagerImpl::SPFIntraAddRouter (SPFVertex* v)
 // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
 // which the packets should be send for forwarding.
 //
-              Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-              if (router == 0)
-                {
-                  continue;
-                }
-              Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-              NS_ASSERT (gr);
-              // walk through all available exit directions due to ECMP,
-              // and add host route for each of the exit direction toward
-              // the vertex 'v'
-              for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-                {
-                  SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-                  Ipv4Address nextHop = exit.first;
-                  int32_t outIf = exit.second;
-                  if (outIf >= 0)
-                    {
-                      gr->AddHostRouteTo (lr->GetLinkData (), nextHop,
-                                          outIf);
-                      NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                    " adding host route to " << lr->GetLinkData () <<
-                                    " using next hop " << nextHop <<
-                                    " and outgoing interface " << outIf);
-                    }
-                  else
-                    {
-                      NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                    " NOT able to add host route to " << lr->GetLinkData () <<
-                                    " using next hop " << nextHop <<
-                                    " since outgoing interface id is negative " << outIf);
-                    }
-                } // for all routes from the root the vertex 'v'
+      // walk through all available exit directions due to ECMP,
+      // and add host route for each of the exit direction toward
+      // the vertex 'v'
+      for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+        {
+          SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+          Ipv4Address nextHop = exit.first;
+          int32_t outIf = exit.second;
+          if (outIf >= 0)
+            {
+              m_spfrootRouting->AddHostRouteTo (lr->GetLinkData (), nextHop,
+                                                outIf);
+              NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfrootNode->GetId () <<
+                            " adding host route to " << lr->GetLinkData () <<
+                            " using next hop " << nextHop <<
+                            " and outgoing interface " << outIf);
             }
-//
-// Done adding the routes for the selected node.
-//
-          return;
-        }
+          else
+            {
+              NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfrootNode->GetId () <<
+                            " NOT able to add host route to " << lr->GetLinkData () <<
+                            " using next hop " << nextHop <<
+                            " since outgoing interface id is negative " << outIf);
+            }
+        } // for all routes from the root the vertex 'v'
     }
 }
+
 void
 GlobalRouteManagerImpl::SPFIntraAddTransit (SPFVertex* v)
 {
@@ -2079,104 +2711,53 @@ GlobalRouteManagerImpl::SPFIntraAddTransit (SPFVertex* v)
                  "GlobalRouteManagerImpl::SPFIntraAddTransit (): Root pointer not set");
 //
 // The root of the Shortest Path First tree is the router to which we are 
-// going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
+// going to write the actual routing table entries.  SPFCalculate () has
+// looked up the node of this router from the root's LSA.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  if (m_spfrootRouting == 0)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to GetObject for that interface.  If there's no GlobalRouter interface, 
-// the node in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to 
-// GetObject for that interface.  If the node is acting as an IP version 4 
-// router, it should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                         "GetObject for <Ipv4> interface failed");
+      NS_LOG_LOGIC ("No global routing protocol at root " << m_spfroot->GetVertexId ());
+      return;
+    }
+  NS_LOG_LOGIC ("setting routes for node " << m_spfrootNode->GetId ());
 //
 // Get the Global Router Link State Advertisement from the vertex we're
 // adding the routes to.  The LSA will have a number of attached Global Router
 // Link Records corresponding to links off of that vertex / node.  We're going
 // to be interested in the records corresponding to point-to-point links.
 //
-          GlobalRoutingLSA *lsa = v->GetLSA ();
-          NS_ASSERT_MSG (lsa, 
-                         "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask ();
-          Ipv4Address tempip = lsa->GetLinkStateId ();
-          tempip = tempip.CombineMask (tempmask);
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all available exit directions due to ECMP,
-          // and add host route for each of the exit direction toward
-          // the vertex 'v'
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
+  GlobalRoutingLSA *lsa = v->GetLSA ();
+  NS_ASSERT_MSG (lsa, 
+                 "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                 "Expected valid LSA in SPFVertex* v");
+  Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask ();
+  Ipv4Address tempip = lsa->GetLinkStateId ();
+  tempip = tempip.CombineMask (tempmask);
+  // walk through all available exit directions due to ECMP,
+  // and add host route for each of the exit direction toward
+  // the vertex 'v'
+  for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+    {
+      SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+      Ipv4Address nextHop = exit.first;
+      int32_t outIf = exit.second;
 
-              if (outIf >= 0)
-                {
-                  gr->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative " << outIf);
-                }
-            }
+      if (outIf >= 0)
+        {
+          m_spfrootRouting->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfrootNode->GetId () <<
+                        " add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
         }
-    } 
+      else
+        {
+          NS_LOG_LOGIC ("(Route " << i << ") Node " << m_spfrootNode->GetId () <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative " << outIf);
+        }
+    }
 }
 
 // Derived from quagga ospf_vertex_add_parents ()
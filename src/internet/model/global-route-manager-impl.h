@@ -23,9 +23,12 @@
 #define GLOBAL_ROUTE_MANAGER_IMPL_H
 
 #include <stdint.h>
+#include <atomic>
 #include <list>
 #include <queue>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <vector>
 #include "ns3/object.h"
 #include "ns3/ptr.h"
@@ -37,7 +40,10 @@ namespace ns3 {
 const uint32_t SPF_INFINITY = 0xffffffff; //!< "infinite" distance between nodes
 
 class CandidateQueue;
+class GlobalNextHopTable;
 class Ipv4GlobalRouting;
+class Node;
+class Ipv4;
 
 /**
  * \ingroup globalrouting
@@ -674,13 +680,24 @@ public:
    */
   uint32_t GetNumExtLSAs () const;
 
+  /**
+   * @brief Get the Link State Advertisements, except the External ones, in
+   * the order of their address.
+   *
+   * @param lsas the vector to fill with the Link State Advertisements.
+   */
+  void GetLSAs (std::vector<GlobalRoutingLSA*> &lsas) const;
+
 
 private:
   typedef std::map<Ipv4Address, GlobalRoutingLSA*> LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisements
   typedef std::pair<Ipv4Address, GlobalRoutingLSA*> LSDBPair_t; //!< pair of IPv4 addresses / Link State Advertisements
 
+  typedef std::map<Ipv4Address, LSDBPair_t> LinkDataMap_t; //!< container of transit link data / Link State Advertisements
+
   LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
   std::vector<GlobalRoutingLSA*> m_extdatabase; //!< database of External Link State Advertisements
+  LinkDataMap_t m_linkDataIndex; //!< index of the Link State Advertisements by transit link data
 
 /**
  * @brief GlobalRouteManagerLSDB copy construction is disallowed.  There's no 
@@ -735,6 +752,17 @@ public:
  */
   virtual void InitializeRoutes ();
 
+/**
+ * @brief Recompute the routes after a change of the topology.
+ *
+ * By default, this deletes all the routes, rebuilds the routing database
+ * and recomputes all the routes.  If the GlobalRoutingIncrementalSpf
+ * global value is true, the routing database is rebuilt, but only the
+ * routers whose shortest path trees may have changed are recomputed; the
+ * other routers only update their routes to the changed destinations.
+ */
+  virtual void RecomputeRoutes ();
+
 /**
  * @brief Debugging routine; allow client code to supply a pre-built LSDB
  * @param lsdb the pre-built LSDB
@@ -767,8 +795,164 @@ private:
  */
   GlobalRouteManagerImpl& operator= (GlobalRouteManagerImpl& srmi);
 
+/**
+ * @brief Create a worker of the SPF calculations, sharing the LSDB
+ * of its parent.
+ *
+ * @param lsdb the shared LSDB
+ */
+  GlobalRouteManagerImpl (GlobalRouteManagerLSDB* lsdb);
+
   SPFVertex* m_spfroot; //!< the root node
   GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+  bool m_sharedLsdb; //!< true if the LSDB belongs to another GlobalRouteManagerImpl
+  Node* m_spfrootNode; //!< the node of the root of the SPF calculation
+  Ipv4* m_spfrootIpv4; //!< the Ipv4 of the root, if it has a GlobalRouter
+  Ipv4GlobalRouting* m_spfrootRouting; //!< the routing protocol of the root, if it has a GlobalRouter
+  /// SPF status of the LSAs in the current SPF calculation (NOT_EXPLORED if absent)
+  std::unordered_map<GlobalRoutingLSA*, GlobalRoutingLSA::SPFStatus> m_spfStatus;
+
+  /**
+   * \brief An edge of the link state graph
+   */
+  struct LinkStateEdge
+  {
+    uint32_t to;          //!< index of the LSA at the end of the edge
+    uint32_t cost;        //!< cost of the edge
+    Ipv4Address linkData; //!< link data of the edge
+    /**
+     * \brief Order the edges
+     * \param other the other edge
+     * \return true if this edge is before the other edge
+     */
+    bool operator< (const LinkStateEdge &other) const;
+  };
+  /**
+   * \brief The root of a SPF calculation, with its node, Ipv4 and routing
+   * protocol looked up before the calculation
+   *
+   * The calculations may run on other threads, which must not access the
+   * NodeList nor copy the Ptr of the objects: the reference counts are not
+   * atomic.
+   */
+  struct SpfRoot
+  {
+    GlobalRoutingLSA* lsa;       //!< the router LSA of the root
+    Node* node;                  //!< the node, 0 if there is no node (unit tests)
+    Ipv4* ipv4;                  //!< the Ipv4 of the node, if it has a GlobalRouter
+    Ipv4GlobalRouting* routing;  //!< the routing protocol of the node, if it has a GlobalRouter
+  };
+
+  typedef std::vector<std::vector<LinkStateEdge> > LinkStateGraph_t; //!< edges of each LSA, by LSA index
+  typedef std::unordered_map<GlobalRoutingLSA*, uint32_t> LSAIndex_t; //!< index of the LSAs
+
+  /// Table of next hops filled by the SPF calculations instead of the routing tables, if any
+  GlobalNextHopTable* m_nextHops;
+  const LSAIndex_t* m_vertexIndex; //!< vertex (column) of each LSA in m_nextHops
+  const LSAIndex_t* m_rowIndex; //!< row of each root LSA in m_nextHops
+
+  /**
+   * \brief Gather the Link State Advertisements of all the nodes
+   * \param lsdb the database to fill
+   */
+  void BuildLsdb (GlobalRouteManagerLSDB* lsdb);
+
+  /**
+   * \brief Calculate the SPF trees of several roots, possibly in parallel
+   * (see the GlobalRoutingSpfThreads global value)
+   * \param roots the root nodes
+   */
+  void SPFCalculate (const std::vector<Ipv4Address> &roots);
+
+  /**
+   * \brief Calculate the SPF trees of the roots not taken by another worker
+   * \param roots the root nodes
+   * \param next the index of the next root to calculate
+   */
+  void SPFWorker (const std::vector<SpfRoot> *roots, std::atomic<std::size_t> *next);
+
+  /**
+   * \brief Compute the next hops of several roots into a table shared by
+   * their routing protocols (see the GlobalRoutingNextHopTable global value),
+   * or load them from the GlobalRoutingNextHopCache file.
+   * \param roots the root nodes
+   */
+  void BuildNextHopTable (const std::vector<Ipv4Address> &roots);
+
+  /**
+   * \brief Compute a key of the topology, which changes if the next hops
+   * of the roots may change
+   * \param lsas the LSAs of the vertices
+   * \param roots the root nodes
+   * \return the key
+   */
+  uint64_t GetTopologyKey (const std::vector<GlobalRoutingLSA*> &lsas,
+                           const std::vector<Ipv4Address> &roots) const;
+
+  /**
+   * \brief Get the status of a LSA in the current SPF calculation
+   * \param lsa the LSA
+   * \return the status
+   */
+  GlobalRoutingLSA::SPFStatus GetSpfStatus (GlobalRoutingLSA* lsa) const;
+
+  /**
+   * \brief Set the status of a LSA in the current SPF calculation
+   * \param lsa the LSA
+   * \param status the status
+   */
+  void SetSpfStatus (GlobalRoutingLSA* lsa, GlobalRoutingLSA::SPFStatus status);
+
+  /**
+   * \brief Look up the node, Ipv4 and routing protocol of a SPF root
+   *
+   * This method accesses the NodeList, and must be called on the main thread.
+   *
+   * \param rootLsa the router LSA of the root
+   * \return the root
+   */
+  static SpfRoot GetSpfRoot (GlobalRoutingLSA* rootLsa);
+
+  /**
+   * \brief Set the node, Ipv4 and routing protocol of the SPF root
+   * \param root the root
+   */
+  void SetSpfRoot (const SpfRoot &root);
+
+  /**
+   * \brief Forget the node, Ipv4 and routing protocol of the SPF root
+   */
+  void ClearSpfRoot (void);
+
+  /**
+   * \brief Incrementally update the routes to a new LSDB
+   * \param lsdb the new LSDB, which is adopted on success
+   * \return false if the change is not supported and all the routes must
+   * be recomputed
+   */
+  bool UpdateRoutes (GlobalRouteManagerLSDB* lsdb);
+
+  /**
+   * \brief Build the link state graph of a LSDB
+   * \param lsdb the LSDB
+   * \param lsas the router and network LSAs of the LSDB
+   * \param index the index of the LSAs
+   * \param graph the graph
+   */
+  static void BuildLinkStateGraph (GlobalRouteManagerLSDB* lsdb,
+                                   const std::vector<GlobalRoutingLSA*> &lsas,
+                                   const LSAIndex_t &index,
+                                   LinkStateGraph_t &graph);
+
+  /**
+   * \brief Get the distances of all the vertices to a vertex
+   * \param graph the link state graph
+   * \param target the index of the vertex
+   * \param distances the distances, SPF_INFINITY if unreachable
+   */
+  static void GetDistancesTo (const LinkStateGraph_t &graph,
+                              uint32_t target,
+                              std::vector<uint32_t> &distances);
 
   /**
    * \brief Test if a node is a stub, from an OSPF sense.
@@ -786,9 +970,9 @@ private:
    * \brief Calculate the shortest path first (SPF) tree
    *
    * Equivalent to quagga ospf_spf_calculate
-   * \param root the root node
+   * \param spfRoot the root, looked up by GetSpfRoot ()
    */
-  void SPFCalculate (Ipv4Address root);
+  void SPFCalculate (const SpfRoot &spfRoot);
 
   /**
    * \brief Process Stub nodes
@@ -65,6 +65,13 @@ public:
  */
   static void InitializeRoutes ();
 
+/**
+ * @brief Recompute the routes after a change of the topology, either from
+ * scratch or incrementally (see the GlobalRoutingIncrementalSpf global
+ * value).
+ */
+  static void RecomputeRoutes ();
+
 private:
 /**
  * @brief Global Route Manager copy construction is disallowed.  There's no 
@@ -29,7 +29,8 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("Ipv4EndPointDemux");
 
 Ipv4EndPointDemux::Ipv4EndPointDemux ()
-  : m_ephemeral (49152), m_portLast (65535), m_portFirst (49152)
+  : m_ephemeral (49152), m_portLast (65535), m_portFirst (49152),
+    m_portsInUse (65536 / 64, 0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -43,27 +44,91 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux ()
       delete endPoint;
     }
   m_endPoints.clear ();
+  m_index.clear ();
+  m_portEndPoints.clear ();
+  m_peerEndPoints.clear ();
 }
 
 bool
-Ipv4EndPointDemux::LookupPortLocal (uint16_t port)
+Ipv4EndPointDemux::PeerKey::operator== (const PeerKey &other) const
 {
-  NS_LOG_FUNCTION (this << port);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
+  return localPort == other.localPort
+         && peerPort == other.peerPort
+         && peerAddr == other.peerAddr;
+}
+
+size_t
+Ipv4EndPointDemux::PeerKeyHash::operator() (const PeerKey &key) const
+{
+  uint64_t v = (static_cast<uint64_t> (key.peerAddr.Get ()) << 32)
+    | (static_cast<uint64_t> (key.peerPort) << 16)
+    | key.localPort;
+  return std::hash<uint64_t> () (v);
+}
+
+Ipv4EndPointDemux::PeerKey
+Ipv4EndPointDemux::GetPeerKey (Ipv4EndPoint *endPoint)
+{
+  return PeerKey {endPoint->GetLocalPort (), endPoint->GetPeerAddress (), endPoint->GetPeerPort ()};
+}
+
+void
+Ipv4EndPointDemux::Insert (Ipv4EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  uint16_t port = endPoint->GetLocalPort ();
+  EndPointIndex index;
+  index.all = m_endPoints.insert (m_endPoints.end (), endPoint);
+  EndPoints &portBucket = m_portEndPoints[port];
+  index.port = portBucket.insert (portBucket.end (), endPoint);
+  index.key = GetPeerKey (endPoint);
+  EndPoints &peerBucket = m_peerEndPoints[index.key];
+  index.peer = peerBucket.insert (peerBucket.end (), endPoint);
+  m_index[endPoint] = index;
+  m_portsInUse[port / 64] |= (uint64_t (1) << (port % 64));
+  endPoint->m_demux = this;
+}
+
+void
+Ipv4EndPointDemux::UpdatePeer (Ipv4EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  auto it = m_index.find (endPoint);
+  NS_ASSERT (it != m_index.end ());
+  EndPointIndex &index = it->second;
+  PeerKey key = GetPeerKey (endPoint);
+  if (key == index.key)
     {
-      if ((*i)->GetLocalPort  () == port) 
-        {
-          return true;
-        }
+      return;
     }
-  return false;
+  auto bucket = m_peerEndPoints.find (index.key);
+  bucket->second.erase (index.peer);
+  if (bucket->second.empty ())
+    {
+      m_peerEndPoints.erase (bucket);
+    }
+  index.key = key;
+  EndPoints &peerBucket = m_peerEndPoints[key];
+  index.peer = peerBucket.insert (peerBucket.end (), endPoint);
+}
+
+bool
+Ipv4EndPointDemux::LookupPortLocal (uint16_t port)
+{
+  NS_LOG_FUNCTION (this << port);
+  return (m_portsInUse[port / 64] >> (port % 64)) & 1;
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal (Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
   NS_LOG_FUNCTION (this << addr << port);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
+  auto bucket = m_portEndPoints.find (port);
+  if (bucket == m_portEndPoints.end ())
+    {
+      return false;
+    }
+  for (EndPointsI i = bucket->second.begin (); i != bucket->second.end (); i++)
     {
       if ((*i)->GetLocalPort () == port &&
           (*i)->GetLocalAddress () == addr &&
@@ -86,7 +151,7 @@ Ipv4EndPointDemux::Allocate (void)
       return 0;
     }
   Ipv4EndPoint *endPoint = new Ipv4EndPoint (Ipv4Address::GetAny (), port);
-  m_endPoints.push_back (endPoint);
+  Insert (endPoint);
   NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
   return endPoint;
 }
@@ -102,7 +167,7 @@ Ipv4EndPointDemux::Allocate (Ipv4Address address)
       return 0;
     }
   Ipv4EndPoint *endPoint = new Ipv4EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
+  Insert (endPoint);
   NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
   return endPoint;
 }
@@ -125,7 +190,7 @@ Ipv4EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice, Ipv4Address address,
       return 0;
     }
   Ipv4EndPoint *endPoint = new Ipv4EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
+  Insert (endPoint);
   NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
   return endPoint;
 }
@@ -136,12 +201,11 @@ Ipv4EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice,
                              Ipv4Address peerAddress, uint16_t peerPort)
 {
   NS_LOG_FUNCTION (this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
+  // The bucket is either non-empty or filled by Insert () below
+  EndPoints &bucket = m_peerEndPoints[PeerKey {localPort, peerAddress, peerPort}];
+  for (EndPointsI i = bucket.begin (); i != bucket.end (); i++)
     {
-      if ((*i)->GetLocalPort () == localPort &&
-          (*i)->GetLocalAddress () == localAddress &&
-          (*i)->GetPeerPort () == peerPort &&
-          (*i)->GetPeerAddress () == peerAddress &&
+      if ((*i)->GetLocalAddress () == localAddress &&
           ((*i)->GetBoundNetDevice () == boundNetDevice || (*i)->GetBoundNetDevice () == 0))
         {
           NS_LOG_WARN ("Duplicated endpoint.");
@@ -150,7 +214,7 @@ Ipv4EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice,
     }
   Ipv4EndPoint *endPoint = new Ipv4EndPoint (localAddress, localPort);
   endPoint->SetPeer (peerAddress, peerPort);
-  m_endPoints.push_back (endPoint);
+  Insert (endPoint);
 
   NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
 
@@ -161,15 +225,30 @@ void
 Ipv4EndPointDemux::DeAllocate (Ipv4EndPoint *endPoint)
 {
   NS_LOG_FUNCTION (this << endPoint);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
+  auto it = m_index.find (endPoint);
+  if (it == m_index.end ())
     {
-      if (*i == endPoint)
-        {
-          delete endPoint;
-          m_endPoints.erase (i);
-          break;
-        }
+      return;
+    }
+  EndPointIndex &index = it->second;
+  uint16_t port = endPoint->GetLocalPort ();
+  m_endPoints.erase (index.all);
+  auto portBucket = m_portEndPoints.find (port);
+  portBucket->second.erase (index.port);
+  if (portBucket->second.empty ())
+    {
+      m_portEndPoints.erase (portBucket);
+      m_portsInUse[port / 64] &= ~(uint64_t (1) << (port % 64));
     }
+  auto peerBucket = m_peerEndPoints.find (index.key);
+  peerBucket->second.erase (index.peer);
+  if (peerBucket->second.empty ())
+    {
+      m_peerEndPoints.erase (peerBucket);
+    }
+  m_index.erase (it);
+  endPoint->m_demux = 0;
+  delete endPoint;
 }
 
 /*
@@ -208,119 +287,132 @@ Ipv4EndPointDemux::Lookup (Ipv4Address daddr, uint16_t dport,
   EndPoints retval4; // Exact match on all 4
 
   NS_LOG_DEBUG ("Looking up endpoint for destination address " << daddr << ":" << dport);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
+  // A packet can only match the endpoints whose peer is either its source
+  // or the wildcard, i.e., the endpoints of (at most) two peer buckets.
+  PeerKey keys[2] = { PeerKey {dport, saddr, sport},
+                      PeerKey {dport, Ipv4Address::GetAny (), 0} };
+  uint32_t nKeys = (keys[0] == keys[1]) ? 1 : 2;
+  for (uint32_t k = 0; k < nKeys; k++)
     {
-      Ipv4EndPoint* endP = *i;
-
-      NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
-                                                 << " daddr=" << endP->GetLocalAddress ()
-                                                 << " sport=" << endP->GetPeerPort ()
-                                                 << " saddr=" << endP->GetPeerAddress ());
-
-      if (!endP->IsRxEnabled ())
-        {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                        << " because endpoint can not receive packets");
-          continue;
-        }
-
-      if (endP->GetLocalPort () != dport) 
+      auto bucket = m_peerEndPoints.find (keys[k]);
+      if (bucket == m_peerEndPoints.end ())
         {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                             << " because endpoint dport "
-                                             << endP->GetLocalPort ()
-                                             << " does not match packet dport " << dport);
           continue;
         }
-      if (endP->GetBoundNetDevice ())
+      for (EndPointsI i = bucket->second.begin (); i != bucket->second.end (); i++)
         {
-          if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+          Ipv4EndPoint* endP = *i;
+
+          NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
+                                                     << " daddr=" << endP->GetLocalAddress ()
+                                                     << " sport=" << endP->GetPeerPort ()
+                                                     << " saddr=" << endP->GetPeerAddress ());
+
+          if (!endP->IsRxEnabled ())
             {
               NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                                 << " because endpoint is bound to specific device and"
-                                                 << endP->GetBoundNetDevice ()
-                                                 << " does not match packet device " << incomingInterface->GetDevice ());
+                            << " because endpoint can not receive packets");
               continue;
             }
-        }
 
-      bool localAddressMatchesExact = false;
-      bool localAddressIsAny = false;
-      bool localAddressIsSubnetAny = false;
+          if (endP->GetLocalPort () != dport) 
+            {
+              NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                                                 << " because endpoint dport "
+                                                 << endP->GetLocalPort ()
+                                                 << " does not match packet dport " << dport);
+              continue;
+            }
+          if (endP->GetBoundNetDevice ())
+            {
+              if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+                {
+                  NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                                                     << " because endpoint is bound to specific device and"
+                                                     << endP->GetBoundNetDevice ()
+                                                     << " does not match packet device " << incomingInterface->GetDevice ());
+                  continue;
+                }
+            }
 
-      // We have 3 cases:
-      // 1) Exact local / destination address match
-      // 2) Local endpoint bound to Any -> matches anything
-      // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g., x.y.z.255 in a /24 net) and direct destination match.
+          bool localAddressMatchesExact = false;
+          bool localAddressIsAny = false;
+          bool localAddressIsSubnetAny = false;
 
-      if (endP->GetLocalAddress () == daddr)
-        {
-          // Case 1:
-          localAddressMatchesExact = true;
-        }
-      else if (endP->GetLocalAddress () == Ipv4Address::GetAny ())
-        {
-          // Case 2:
-          localAddressIsAny = true;
-        }
-      else
-        {
-          // Case 3:
-          for (uint32_t i = 0; i < incomingInterface->GetNAddresses (); i++)
-            {
-              Ipv4InterfaceAddress addr = incomingInterface->GetAddress (i);
+          // We have 3 cases:
+          // 1) Exact local / destination address match
+          // 2) Local endpoint bound to Any -> matches anything
+          // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g., x.y.z.255 in a /24 net) and direct destination match.
 
-              Ipv4Address addrNetpart = addr.GetLocal ().CombineMask (addr.GetMask ());
-              if (endP->GetLocalAddress () == addrNetpart)
+          if (endP->GetLocalAddress () == daddr)
+            {
+              // Case 1:
+              localAddressMatchesExact = true;
+            }
+          else if (endP->GetLocalAddress () == Ipv4Address::GetAny ())
+            {
+              // Case 2:
+              localAddressIsAny = true;
+            }
+          else
+            {
+              // Case 3:
+              for (uint32_t i = 0; i < incomingInterface->GetNAddresses (); i++)
                 {
-                  NS_LOG_LOGIC ("Endpoint is SubnetDirectedAny " << endP->GetLocalAddress () << "/" << addr.GetMask ().GetPrefixLength ());
+                  Ipv4InterfaceAddress addr = incomingInterface->GetAddress (i);
 
-                  Ipv4Address daddrNetPart = daddr.CombineMask (addr.GetMask ());
-                  if (addrNetpart == daddrNetPart)
+                  Ipv4Address addrNetpart = addr.GetLocal ().CombineMask (addr.GetMask ());
+                  if (endP->GetLocalAddress () == addrNetpart)
                     {
-                      localAddressIsSubnetAny = true;
+                      NS_LOG_LOGIC ("Endpoint is SubnetDirectedAny " << endP->GetLocalAddress () << "/" << addr.GetMask ().GetPrefixLength ());
+
+                      Ipv4Address daddrNetPart = daddr.CombineMask (addr.GetMask ());
+                      if (addrNetpart == daddrNetPart)
+                        {
+                          localAddressIsSubnetAny = true;
+                        }
                     }
                 }
-            }
 
-          // if no match here, keep looking
-          if (!localAddressIsSubnetAny)
-            continue;
-        }
+              // if no match here, keep looking
+              if (!localAddressIsSubnetAny)
+                continue;
+            }
 
-      bool remotePortMatchesExact = endP->GetPeerPort () == sport;
-      bool remotePortMatchesWildCard = endP->GetPeerPort () == 0;
-      bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
-      bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv4Address::GetAny ();
+          bool remotePortMatchesExact = endP->GetPeerPort () == sport;
+          bool remotePortMatchesWildCard = endP->GetPeerPort () == 0;
+          bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
+          bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv4Address::GetAny ();
 
-      // If remote does not match either with exact or wildcard,
-      // skip this one
-      if (!(remotePortMatchesExact || remotePortMatchesWildCard))
-        continue;
-      if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        continue;
+          // If remote does not match either with exact or wildcard,
+          // skip this one
+          if (!(remotePortMatchesExact || remotePortMatchesWildCard))
+            continue;
+          if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+            continue;
 
-      bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
+          bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
 
-      if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All 4 match - this is the case of an open TCP connection, for example.
-          NS_LOG_LOGIC ("Found an endpoint for case 4, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
-          retval4.push_back (endP);
-        }
-      if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All but local address - no idea what this case could be.
-          NS_LOG_LOGIC ("Found an endpoint for case 3, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
-          retval3.push_back (endP);
-        }
-      if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port and local address matches exactly - Not yet opened connection
-          NS_LOG_LOGIC ("Found an endpoint for case 2, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
-          retval2.push_back (endP);
-        }
-      if (localAddressMatchesWildCard && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port matches exactly - Endpoint open to "any" connection
-          NS_LOG_LOGIC ("Found an endpoint for case 1, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
-          retval1.push_back (endP);
+          if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
+            { // All 4 match - this is the case of an open TCP connection, for example.
+              NS_LOG_LOGIC ("Found an endpoint for case 4, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
+              retval4.push_back (endP);
+            }
+          if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
+            { // All but local address - no idea what this case could be.
+              NS_LOG_LOGIC ("Found an endpoint for case 3, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
+              retval3.push_back (endP);
+            }
+          if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
+            { // Only local port and local address matches exactly - Not yet opened connection
+              NS_LOG_LOGIC ("Found an endpoint for case 2, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
+              retval2.push_back (endP);
+            }
+          if (localAddressMatchesWildCard && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
+            { // Only local port matches exactly - Endpoint open to "any" connection
+              NS_LOG_LOGIC ("Found an endpoint for case 1, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
+              retval1.push_back (endP);
+            }
         }
     }
 
@@ -347,7 +439,12 @@ Ipv4EndPointDemux::SimpleLookup (Ipv4Address daddr,
   // function.
   uint32_t genericity = 3;
   Ipv4EndPoint *generic = 0;
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
+  auto bucket = m_portEndPoints.find (dport);
+  if (bucket == m_portEndPoints.end ())
+    {
+      return 0;
+    }
+  for (EndPointsI i = bucket->second.begin (); i != bucket->second.end (); i++)
     {
       if ((*i)->GetLocalPort () != dport) 
         {
@@ -378,27 +475,49 @@ Ipv4EndPointDemux::SimpleLookup (Ipv4Address daddr,
   return generic;
 }
 uint16_t
-Ipv4EndPointDemux::AllocateEphemeralPort (void)
+Ipv4EndPointDemux::FindFreePort (uint16_t first, uint16_t last) const
 {
-  // Similar to counting up logic in netinet/in_pcb.c
-  NS_LOG_FUNCTION (this);
-  uint16_t port = m_ephemeral;
-  int count = m_portLast - m_portFirst;
-  do 
+  uint32_t port = first;
+  while (port <= last)
     {
-      if (count-- < 0)
+      uint64_t word = m_portsInUse[port / 64];
+      if (word == ~uint64_t (0))
         {
-          return 0;
+          // All the ports of this word are in use
+          port = (port / 64 + 1) * 64;
+          continue;
         }
-      ++port;
-      if (port < m_portFirst || port > m_portLast)
+      if (((word >> (port % 64)) & 1) == 0)
         {
-          port = m_portFirst;
+          return port;
         }
-    } while (LookupPortLocal (port));
+      port++;
+    }
+  return 0;
+}
+
+uint16_t
+Ipv4EndPointDemux::AllocateEphemeralPort (void)
+{
+  // Similar to counting up logic in netinet/in_pcb.c: try the ports
+  // following the last allocated one, wrapping around the range.
+  NS_LOG_FUNCTION (this);
+  uint16_t start = m_ephemeral + 1;
+  if (start < m_portFirst || start > m_portLast)
+    {
+      start = m_portFirst;
+    }
+  uint16_t port = FindFreePort (start, m_portLast);
+  if (port == 0 && start > m_portFirst)
+    {
+      port = FindFreePort (m_portFirst, start - 1);
+    }
+  if (port == 0)
+    {
+      return 0;
+    }
   m_ephemeral = port;
   return port;
 }
 
 } // namespace ns3
-
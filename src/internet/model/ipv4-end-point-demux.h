@@ -23,6 +23,8 @@
 
 #include <stdint.h>
 #include <list>
+#include <unordered_map>
+#include <vector>
 #include "ns3/ipv4-address.h"
 #include "ipv4-interface.h"
 
@@ -40,6 +42,14 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * Besides the list of endpoints (kept in allocation order), the demux
+ * indexes every endpoint by its local port and by the triple (local port,
+ * peer address, peer port).  A received packet can only match endpoints
+ * whose peer is either exactly its source or the wildcard, so Lookup ()
+ * inspects two hash buckets instead of every endpoint.  The ports in use
+ * are also tracked in a bitmap, which AllocateEphemeralPort () scans a
+ * word at a time.
  */
 
 class Ipv4EndPointDemux {
@@ -166,6 +176,78 @@ public:
   void DeAllocate (Ipv4EndPoint *endPoint);
 
 private:
+  friend class Ipv4EndPoint;
+
+  /**
+   * \brief Key of the peer index.
+   */
+  struct PeerKey
+  {
+    uint16_t localPort;   //!< local port
+    Ipv4Address peerAddr; //!< peer address
+    uint16_t peerPort;    //!< peer port
+
+    /**
+     * \brief Compare two keys.
+     * \param other the other key
+     * \return true if the keys are equal
+     */
+    bool operator== (const PeerKey &other) const;
+  };
+
+  /**
+   * \brief Hash function for the peer index keys.
+   */
+  struct PeerKeyHash
+  {
+    /**
+     * \brief Hash a key.
+     * \param key the key
+     * \return the hash
+     */
+    size_t operator() (const PeerKey &key) const;
+  };
+
+  /**
+   * \brief Position of an endpoint in the demux containers.
+   */
+  struct EndPointIndex
+  {
+    EndPointsI all;  //!< position in m_endPoints
+    EndPointsI port; //!< position in the local port bucket
+    EndPointsI peer; //!< position in the peer bucket
+    PeerKey key;     //!< key of the peer bucket
+  };
+
+  /**
+   * \brief Insert a new endpoint in the list and in the indexes.
+   * \param endPoint the end point
+   */
+  void Insert (Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Move an endpoint to the peer bucket matching its current peer.
+   *
+   * Called by Ipv4EndPoint::SetPeer.
+   *
+   * \param endPoint the end point
+   */
+  void UpdatePeer (Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Build the peer index key of an endpoint.
+   * \param endPoint the end point
+   * \return the key
+   */
+  static PeerKey GetPeerKey (Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Find the first port not in use in a range.
+   * \param first the first port of the range
+   * \param last the last port of the range
+   * \returns the port, or 0 if every port in the range is in use
+   */
+  uint16_t FindFreePort (uint16_t first, uint16_t last) const;
 
   /**
    * \brief Allocate an ephemeral port.
@@ -189,9 +271,29 @@ private:
   uint16_t m_portFirst;
 
   /**
-   * \brief A list of IPv4 end points.
+   * \brief A list of IPv4 end points, in allocation order.
    */
   EndPoints m_endPoints;
+
+  /**
+   * \brief Position of each end point in the containers.
+   */
+  std::unordered_map<Ipv4EndPoint *, EndPointIndex> m_index;
+
+  /**
+   * \brief End points by local port, in allocation order.
+   */
+  std::unordered_map<uint16_t, EndPoints> m_portEndPoints;
+
+  /**
+   * \brief End points by local port, peer address and peer port.
+   */
+  std::unordered_map<PeerKey, EndPoints, PeerKeyHash> m_peerEndPoints;
+
+  /**
+   * \brief Bitmap of the local ports in use, 64 ports per word.
+   */
+  std::vector<uint64_t> m_portsInUse;
 };
 
 } // namespace ns3
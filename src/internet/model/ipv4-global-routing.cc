@@ -59,7 +59,8 @@ Ipv4GlobalRouting::GetTypeId (void)
 
 Ipv4GlobalRouting::Ipv4GlobalRouting () 
   : m_randomEcmpRouting (false),
-    m_respondToInterfaceEvents (false)
+    m_respondToInterfaceEvents (false),
+    m_nextHopRow (0)
 {
   NS_LOG_FUNCTION (this);
 
@@ -80,6 +81,7 @@ Ipv4GlobalRouting::AddHostRouteTo (Ipv4Address dest,
   Ipv4RoutingTableEntry *route = new Ipv4RoutingTableEntry ();
   *route = Ipv4RoutingTableEntry::CreateHostRouteTo (dest, nextHop, interface);
   m_hostRoutes.push_back (route);
+  m_hostFib.Insert (route->GetDest (), Ipv4Mask::GetOnes (), route);
 }
 
 void 
@@ -90,6 +92,7 @@ Ipv4GlobalRouting::AddHostRouteTo (Ipv4Address dest,
   Ipv4RoutingTableEntry *route = new Ipv4RoutingTableEntry ();
   *route = Ipv4RoutingTableEntry::CreateHostRouteTo (dest, interface);
   m_hostRoutes.push_back (route);
+  m_hostFib.Insert (route->GetDest (), Ipv4Mask::GetOnes (), route);
 }
 
 void 
@@ -105,6 +108,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         nextHop,
                                                         interface);
   m_networkRoutes.push_back (route);
+  m_networkFib.Insert (route->GetDestNetwork (), route->GetDestNetworkMask (), route);
 }
 
 void 
@@ -118,6 +122,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         networkMask,
                                                         interface);
   m_networkRoutes.push_back (route);
+  m_networkFib.Insert (route->GetDestNetwork (), route->GetDestNetworkMask (), route);
 }
 
 void 
@@ -133,6 +138,7 @@ Ipv4GlobalRouting::AddASExternalRouteTo (Ipv4Address network,
                                                         nextHop,
                                                         interface);
   m_ASexternalRoutes.push_back (route);
+  m_ASexternalFib.Insert (route->GetDestNetwork (), route->GetDestNetworkMask (), route);
 }
 
 
@@ -145,10 +151,13 @@ Ipv4GlobalRouting::LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif)
   // store all available routes that bring packets to their destination
   typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
   RouteVec_t allRoutes;
+  // The indexes return the candidate routes in the order of the tables
+  RouteVec_t candidates;
 
   NS_LOG_LOGIC ("Number of m_hostRoutes = " << m_hostRoutes.size ());
-  for (HostRoutesCI i = m_hostRoutes.begin (); 
-       i != m_hostRoutes.end (); 
+  m_hostFib.Lookup (dest, candidates);
+  for (RouteVec_t::const_iterator i = candidates.begin (); 
+       i != candidates.end (); 
        i++) 
     {
       NS_ASSERT ((*i)->IsHost ());
@@ -169,8 +178,9 @@ Ipv4GlobalRouting::LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif)
   if (allRoutes.size () == 0) // if no host route is found
     {
       NS_LOG_LOGIC ("Number of m_networkRoutes" << m_networkRoutes.size ());
-      for (NetworkRoutesI j = m_networkRoutes.begin (); 
-           j != m_networkRoutes.end (); 
+      m_networkFib.Lookup (dest, candidates);
+      for (RouteVec_t::const_iterator j = candidates.begin (); 
+           j != candidates.end (); 
            j++) 
         {
           Ipv4Mask mask = (*j)->GetDestNetworkMask ();
@@ -190,10 +200,27 @@ Ipv4GlobalRouting::LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif)
             }
         }
     }
+  if (allRoutes.size () == 0 && m_nextHops != 0) // then the shared next hops
+    {
+      Ipv4Address gateway;
+      uint32_t interface;
+      if (m_nextHops->Lookup (m_nextHopRow, dest, gateway, interface)
+          && (oif == 0 || oif == m_ipv4->GetNetDevice (interface)))
+        {
+          NS_LOG_LOGIC ("Found next hop " << gateway << " in the shared table");
+          rtentry = Create<Ipv4Route> ();
+          rtentry->SetDestination (dest);
+          rtentry->SetSource (m_ipv4->GetAddress (interface, 0).GetLocal ());
+          rtentry->SetGateway (gateway);
+          rtentry->SetOutputDevice (m_ipv4->GetNetDevice (interface));
+          return rtentry;
+        }
+    }
   if (allRoutes.size () == 0)  // consider external if no host/network found
     {
-      for (ASExternalRoutesI k = m_ASexternalRoutes.begin ();
-           k != m_ASexternalRoutes.end ();
+      m_ASexternalFib.Lookup (dest, candidates);
+      for (RouteVec_t::const_iterator k = candidates.begin ();
+           k != candidates.end ();
            k++)
         {
           Ipv4Mask mask = (*k)->GetDestNetworkMask ();
@@ -319,6 +346,7 @@ Ipv4GlobalRouting::RemoveRoute (uint32_t index)
           if (tmp  == index)
             {
               NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_hostRoutes.size ());
+              m_hostFib.Erase ((*i)->GetDest (), Ipv4Mask::GetOnes (), *i);
               delete *i;
               m_hostRoutes.erase (i);
               NS_LOG_LOGIC ("Done removing host route " << index << "; host route remaining size = " << m_hostRoutes.size ());
@@ -336,6 +364,7 @@ Ipv4GlobalRouting::RemoveRoute (uint32_t index)
       if (tmp == index)
         {
           NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_networkRoutes.size ());
+          m_networkFib.Erase ((*j)->GetDestNetwork (), (*j)->GetDestNetworkMask (), *j);
           delete *j;
           m_networkRoutes.erase (j);
           NS_LOG_LOGIC ("Done removing network route " << index << "; network route remaining size = " << m_networkRoutes.size ());
@@ -352,6 +381,7 @@ Ipv4GlobalRouting::RemoveRoute (uint32_t index)
       if (tmp == index)
         {
           NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_ASexternalRoutes.size ());
+          m_ASexternalFib.Erase ((*k)->GetDestNetwork (), (*k)->GetDestNetworkMask (), *k);
           delete *k;
           m_ASexternalRoutes.erase (k);
           NS_LOG_LOGIC ("Done removing network route " << index << "; network route remaining size = " << m_networkRoutes.size ());
@@ -362,6 +392,20 @@ Ipv4GlobalRouting::RemoveRoute (uint32_t index)
   NS_ASSERT (false);
 }
 
+void
+Ipv4GlobalRouting::SetNextHopTable (Ptr<GlobalNextHopTable> table, uint32_t row)
+{
+  NS_LOG_FUNCTION (this << table << row);
+  m_nextHops = table;
+  m_nextHopRow = row;
+}
+
+Ptr<GlobalNextHopTable>
+Ipv4GlobalRouting::GetNextHopTable (void) const
+{
+  return m_nextHops;
+}
+
 int64_t
 Ipv4GlobalRouting::AssignStreams (int64_t stream)
 {
@@ -392,6 +436,10 @@ Ipv4GlobalRouting::DoDispose (void)
     {
       delete (*l);
     }
+  m_hostFib.Clear ();
+  m_networkFib.Clear ();
+  m_ASexternalFib.Clear ();
+  m_nextHops = 0;
 
   Ipv4RoutingProtocol::DoDispose ();
 }
@@ -413,13 +461,29 @@ Ipv4GlobalRouting::PrintRoutingTable (Ptr<OutputStreamWrapper> stream, Time::Uni
       << ", Local time: " << m_ipv4->GetObject<Node> ()->GetLocalTime ().As (unit)
       << ", Ipv4GlobalRouting table" << std::endl;
 
-  if (GetNRoutes () > 0)
+  std::vector<Ipv4RoutingTableEntry> routes;
+  for (uint32_t j = 0; j < GetNRoutes (); j++)
+    {
+      routes.push_back (*GetRoute (j));
+    }
+  if (m_nextHops != 0)
+    {
+      Ipv4RoutingTableEntry route;
+      for (uint32_t j = 0; j < m_nextHops->GetNDestinations (); j++)
+        {
+          if (m_nextHops->GetRoute (m_nextHopRow, j, route))
+            {
+              routes.push_back (route);
+            }
+        }
+    }
+  if (routes.size () > 0)
     {
       *os << "Destination     Gateway         Genmask         Flags Metric Ref    Use Iface" << std::endl;
-      for (uint32_t j = 0; j < GetNRoutes (); j++)
+      for (uint32_t j = 0; j < routes.size (); j++)
         {
           std::ostringstream dest, gw, mask, flags;
-          Ipv4RoutingTableEntry route = GetRoute (j);
+          const Ipv4RoutingTableEntry &route = routes[j];
           dest << route.GetDest ();
           *os << std::setw (16) << dest.str ();
           gw << route.GetGateway ();
@@ -544,9 +608,7 @@ Ipv4GlobalRouting::NotifyInterfaceUp (uint32_t i)
   NS_LOG_FUNCTION (this << i);
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
-      GlobalRouteManager::DeleteGlobalRoutes ();
-      GlobalRouteManager::BuildGlobalRoutingDatabase ();
-      GlobalRouteManager::InitializeRoutes ();
+      GlobalRouteManager::RecomputeRoutes ();
     }
 }
 
@@ -556,9 +618,7 @@ Ipv4GlobalRouting::NotifyInterfaceDown (uint32_t i)
   NS_LOG_FUNCTION (this << i);
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
-      GlobalRouteManager::DeleteGlobalRoutes ();
-      GlobalRouteManager::BuildGlobalRoutingDatabase ();
-      GlobalRouteManager::InitializeRoutes ();
+      GlobalRouteManager::RecomputeRoutes ();
     }
 }
 
@@ -568,9 +628,7 @@ Ipv4GlobalRouting::NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress ad
   NS_LOG_FUNCTION (this << interface << address);
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
-      GlobalRouteManager::DeleteGlobalRoutes ();
-      GlobalRouteManager::BuildGlobalRoutingDatabase ();
-      GlobalRouteManager::InitializeRoutes ();
+      GlobalRouteManager::RecomputeRoutes ();
     }
 }
 
@@ -580,9 +638,7 @@ Ipv4GlobalRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress
   NS_LOG_FUNCTION (this << interface << address);
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
-      GlobalRouteManager::DeleteGlobalRoutes ();
-      GlobalRouteManager::BuildGlobalRoutingDatabase ();
-      GlobalRouteManager::InitializeRoutes ();
+      GlobalRouteManager::RecomputeRoutes ();
     }
 }
 
@@ -28,6 +28,8 @@
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/random-variable-stream.h"
+#include "prefix-trie.h"
+#include "global-next-hop-table.h"
 
 namespace ns3 {
 
@@ -218,6 +220,24 @@ public:
    */
   void RemoveRoute (uint32_t i);
 
+  /**
+   * \brief Use a table of next hops shared with the other routers.
+   *
+   * The table is looked up when no host or network route of this router
+   * matches a destination (see GlobalNextHopTable).  Its routes are not
+   * counted by GetNRoutes () and not returned by GetRoute (), but they are
+   * printed by PrintRoutingTable ().
+   *
+   * \param table the table, or 0 to stop using a table
+   * \param row the row of this router in the table
+   */
+  void SetNextHopTable (Ptr<GlobalNextHopTable> table, uint32_t row);
+
+  /**
+   * \return the table of next hops shared with the other routers, or 0
+   */
+  Ptr<GlobalNextHopTable> GetNextHopTable (void) const;
+
   /**
    * Assign a fixed random variable stream number to the random variables
    * used by this model.  Return the number of streams (possibly zero) that
@@ -272,6 +292,13 @@ private:
   NetworkRoutes m_networkRoutes;       //!< Routes to networks
   ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+  PrefixTrie<Ipv4RoutingTableEntry *> m_hostFib;       //!< Index of m_hostRoutes
+  PrefixTrie<Ipv4RoutingTableEntry *> m_networkFib;    //!< Index of m_networkRoutes
+  PrefixTrie<Ipv4RoutingTableEntry *> m_ASexternalFib; //!< Index of m_ASexternalRoutes
+
+  Ptr<GlobalNextHopTable> m_nextHops; //!< Next hops shared with the other routers, if any
+  uint32_t m_nextHopRow;              //!< Row of this router in m_nextHops
+
   Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
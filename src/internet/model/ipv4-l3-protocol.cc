@@ -35,6 +35,7 @@
 #include "ns3/boolean.h"
 #include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/traffic-control-layer.h"
+#include "ns3/segmentation-offload.h"
 
 #include "loopback-net-device.h"
 #include "arp-l3-protocol.h"
@@ -996,7 +997,34 @@ Ipv4L3Protocol::SendRealOut (Ptr<Ipv4Route> route,
   if (outInterface->IsUp ())
     {
       NS_LOG_LOGIC ("Send to " << targetLabel << " " << target);
-      if ( packet->GetSize () + ipHeader.GetSerializedSize () > outInterface->GetDevice ()->GetMtu () )
+      SegmentationTag segmentationTag;
+      if (packet->GetSize () + ipHeader.GetSerializedSize () > outInterface->GetDevice ()->GetMtu ()
+          && packet->PeekPacketTag (segmentationTag))
+        {
+          //
+          // A super-segment is split into segments which fit the MTU by the
+          // device, if it supports segmentation offload, or here otherwise.
+          //
+          if (outDev->SupportsSegmentationOffload ())
+            {
+              CallTxTrace (ipHeader, packet, Ptr (this), interface);
+              outInterface->Send (packet, ipHeader, target);
+              return;
+            }
+          Ptr<Packet> superSegment = packet->Copy ();
+          superSegment->AddHeader (ipHeader);
+          std::list<Ptr<Packet> > segments = SegmentationOffload::Segment (superSegment, PROT_NUMBER);
+          for (std::list<Ptr<Packet> >::iterator it = segments.begin (); it != segments.end (); it++)
+            {
+              CoalescingTag coalescingTag;
+              (*it)->RemovePacketTag (coalescingTag);
+              Ipv4Header segmentHeader;
+              (*it)->RemoveHeader (segmentHeader);
+              CallTxTrace (segmentHeader, *it, Ptr (this), interface);
+              outInterface->Send (*it, segmentHeader, target);
+            }
+        }
+      else if ( packet->GetSize () + ipHeader.GetSerializedSize () > outInterface->GetDevice ()->GetMtu () )
         {
           std::list<Ipv4PayloadHeaderPair> listFragments;
           DoFragmentation (packet, ipHeader, outInterface->GetDevice ()->GetMtu (), listFragments);
@@ -76,7 +76,7 @@ Ipv4StaticRouting::AddNetworkRouteTo (Ipv4Address network,
   if (!LookupRoute (route, metric))
     {
       Ipv4RoutingTableEntry *routePtr = new Ipv4RoutingTableEntry (route);
-      m_networkRoutes.push_back (make_pair (routePtr, metric));
+      AppendNetworkRoute (routePtr, metric);
     }
 }
 
@@ -95,7 +95,7 @@ Ipv4StaticRouting::AddNetworkRouteTo (Ipv4Address network,
     {
       Ipv4RoutingTableEntry *routePtr = new Ipv4RoutingTableEntry (route);
 
-      m_networkRoutes.push_back (make_pair (routePtr, metric));
+      AppendNetworkRoute (routePtr, metric);
     }
 }
 
@@ -153,7 +153,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute (uint32_t outputInterface)
   *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo (network,
                                                         networkMask,
                                                         outputInterface);
-  m_networkRoutes.push_back (make_pair (route,0));
+  AppendNetworkRoute (route, 0);
 }
 
 uint32_t 
@@ -229,10 +229,21 @@ Ipv4StaticRouting::RemoveMulticastRoute (uint32_t index)
     }
 }
 
+void
+Ipv4StaticRouting::AppendNetworkRoute (Ipv4RoutingTableEntry *route, uint32_t metric)
+{
+  NS_LOG_FUNCTION (this << route << metric);
+  m_networkRoutes.push_back (make_pair (route, metric));
+  m_fib.Insert (route->GetDestNetwork (), route->GetDestNetworkMask (), m_networkRoutes.back ());
+}
+
 bool
 Ipv4StaticRouting::LookupRoute (const Ipv4RoutingTableEntry &route, uint32_t metric)
 {
-  for (NetworkRoutesI j = m_networkRoutes.begin (); j != m_networkRoutes.end (); j++)
+  // Only the routes to the same network can be equal
+  std::vector<NetworkRoutes::value_type> sameNetwork;
+  m_fib.Find (route.GetDestNetwork (), route.GetDestNetworkMask (), sameNetwork);
+  for (std::vector<NetworkRoutes::value_type>::const_iterator j = sameNetwork.begin (); j != sameNetwork.end (); j++)
     {
       Ipv4RoutingTableEntry* rtentry = j->first;
 
@@ -269,8 +280,11 @@ Ipv4StaticRouting::LookupStatic (Ipv4Address dest, Ptr<NetDevice> oif)
     }
 
 
-  for (NetworkRoutesI i = m_networkRoutes.begin (); 
-       i != m_networkRoutes.end (); 
+  // The candidate routes are the matching ones, in the order of the table
+  std::vector<NetworkRoutes::value_type> candidates;
+  m_fib.Lookup (dest, candidates);
+  for (std::vector<NetworkRoutes::value_type>::const_iterator i = candidates.begin (); 
+       i != candidates.end (); 
        i++) 
     {
       Ipv4RoutingTableEntry *j=i->first;
@@ -476,6 +490,7 @@ Ipv4StaticRouting::RemoveRoute (uint32_t index)
     {
       if (tmp == index)
         {
+          m_fib.Erase (j->first->GetDestNetwork (), j->first->GetDestNetworkMask (), *j);
           delete j->first;
           m_networkRoutes.erase (j);
           return;
@@ -604,6 +619,7 @@ Ipv4StaticRouting::DoDispose (void)
     {
       delete (j->first);
     }
+  m_fib.Clear ();
   for (MulticastRoutesI i = m_multicastRoutes.begin (); 
        i != m_multicastRoutes.end (); 
        i = m_multicastRoutes.erase (i)) 
@@ -642,6 +658,7 @@ Ipv4StaticRouting::NotifyInterfaceDown (uint32_t i)
     {
       if (it->first->GetInterface () == i)
         {
+          m_fib.Erase (it->first->GetDestNetwork (), it->first->GetDestNetworkMask (), *it);
           delete it->first;
           it = m_networkRoutes.erase (it);
         }
@@ -689,6 +706,7 @@ Ipv4StaticRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress
           && it->first->GetDestNetwork () == networkAddress
           && it->first->GetDestNetworkMask () == networkMask)
         {
+          m_fib.Erase (it->first->GetDestNetwork (), it->first->GetDestNetworkMask (), *it);
           delete it->first;
           it = m_networkRoutes.erase (it);
         }
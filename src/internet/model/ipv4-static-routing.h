@@ -31,6 +31,7 @@
 #include "ns3/ptr.h"
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
+#include "prefix-trie.h"
 
 namespace ns3 {
 
@@ -376,6 +377,13 @@ private:
   /// Iterator for container for the multicast routes
   typedef std::list<Ipv4MulticastRoutingTableEntry *>::iterator MulticastRoutesI;
 
+  /**
+   * \brief Append a route to the forwarding table for network.
+   * \param route route
+   * \param metric metric of route
+   */
+  void AppendNetworkRoute (Ipv4RoutingTableEntry *route, uint32_t metric);
+
   /**
    * \brief Checks if a route is already present in the forwarding table.
    * \param route route
@@ -407,6 +415,11 @@ private:
    */
   NetworkRoutes m_networkRoutes;
 
+  /**
+   * \brief the longest-prefix-match index of m_networkRoutes.
+   */
+  PrefixTrie<std::pair <Ipv4RoutingTableEntry *, uint32_t> > m_fib;
+
   /**
    * \brief the forwarding table for multicast.
    */
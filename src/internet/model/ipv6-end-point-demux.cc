@@ -29,7 +29,8 @@ NS_LOG_COMPONENT_DEFINE ("Ipv6EndPointDemux");
 Ipv6EndPointDemux::Ipv6EndPointDemux ()
   : m_ephemeral (49152),
     m_portFirst (49152),
-    m_portLast (65535)
+    m_portLast (65535),
+    m_portsInUse (65536 / 64, 0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -43,25 +44,82 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux ()
       delete endPoint;
     }
   m_endPoints.clear ();
+  m_index.clear ();
+  m_portEndPoints.clear ();
+  m_peerEndPoints.clear ();
 }
 
-bool Ipv6EndPointDemux::LookupPortLocal (uint16_t port)
+bool Ipv6EndPointDemux::PeerKey::operator== (const PeerKey &other) const
 {
-  NS_LOG_FUNCTION (this << port);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  return localPort == other.localPort
+         && peerPort == other.peerPort
+         && peerAddr == other.peerAddr;
+}
+
+size_t Ipv6EndPointDemux::PeerKeyHash::operator() (const PeerKey &key) const
+{
+  size_t h = Ipv6AddressHash () (key.peerAddr);
+  return h ^ std::hash<uint32_t> () ((static_cast<uint32_t> (key.peerPort) << 16) | key.localPort);
+}
+
+Ipv6EndPointDemux::PeerKey Ipv6EndPointDemux::GetPeerKey (Ipv6EndPoint *endPoint)
+{
+  return PeerKey {endPoint->GetLocalPort (), endPoint->GetPeerAddress (), endPoint->GetPeerPort ()};
+}
+
+void Ipv6EndPointDemux::Insert (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  uint16_t port = endPoint->GetLocalPort ();
+  EndPointIndex index;
+  index.all = m_endPoints.insert (m_endPoints.end (), endPoint);
+  EndPoints &portBucket = m_portEndPoints[port];
+  index.port = portBucket.insert (portBucket.end (), endPoint);
+  index.key = GetPeerKey (endPoint);
+  EndPoints &peerBucket = m_peerEndPoints[index.key];
+  index.peer = peerBucket.insert (peerBucket.end (), endPoint);
+  m_index[endPoint] = index;
+  m_portsInUse[port / 64] |= (uint64_t (1) << (port % 64));
+  endPoint->m_demux = this;
+}
+
+void Ipv6EndPointDemux::UpdatePeer (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  auto it = m_index.find (endPoint);
+  NS_ASSERT (it != m_index.end ());
+  EndPointIndex &index = it->second;
+  PeerKey key = GetPeerKey (endPoint);
+  if (key == index.key)
     {
-      if ((*i)->GetLocalPort  () == port)
-        {
-          return true;
-        }
+      return;
     }
-  return false;
+  auto bucket = m_peerEndPoints.find (index.key);
+  bucket->second.erase (index.peer);
+  if (bucket->second.empty ())
+    {
+      m_peerEndPoints.erase (bucket);
+    }
+  index.key = key;
+  EndPoints &peerBucket = m_peerEndPoints[key];
+  index.peer = peerBucket.insert (peerBucket.end (), endPoint);
+}
+
+bool Ipv6EndPointDemux::LookupPortLocal (uint16_t port)
+{
+  NS_LOG_FUNCTION (this << port);
+  return (m_portsInUse[port / 64] >> (port % 64)) & 1;
 }
 
 bool Ipv6EndPointDemux::LookupLocal (Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
   NS_LOG_FUNCTION (this << addr << port);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  auto bucket = m_portEndPoints.find (port);
+  if (bucket == m_portEndPoints.end ())
+    {
+      return false;
+    }
+  for (EndPointsI i = bucket->second.begin (); i != bucket->second.end (); i++)
     {
       if ((*i)->GetLocalPort () == port &&
           (*i)->GetLocalAddress () == addr &&
@@ -83,7 +141,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate ()
       return 0;
     }
   Ipv6EndPoint *endPoint = new Ipv6EndPoint (Ipv6Address::GetAny (), port);
-  m_endPoints.push_back (endPoint);
+  Insert (endPoint);
   NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
   return endPoint;
 }
@@ -98,7 +156,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ipv6Address address)
       return 0;
     }
   Ipv6EndPoint *endPoint = new Ipv6EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
+  Insert (endPoint);
   NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
   return endPoint;
 }
@@ -119,7 +177,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice, Ipv6Ad
       return 0;
     }
   Ipv6EndPoint *endPoint = new Ipv6EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
+  Insert (endPoint);
   NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
   return endPoint;
 }
@@ -129,12 +187,11 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice,
                                            Ipv6Address peerAddress, uint16_t peerPort)
 {
   NS_LOG_FUNCTION (this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  // The bucket is either non-empty or filled by Insert () below
+  EndPoints &bucket = m_peerEndPoints[PeerKey {localPort, peerAddress, peerPort}];
+  for (EndPointsI i = bucket.begin (); i != bucket.end (); i++)
     {
-      if ((*i)->GetLocalPort () == localPort &&
-          (*i)->GetLocalAddress () == localAddress &&
-          (*i)->GetPeerPort () == peerPort &&
-          (*i)->GetPeerAddress () == peerAddress &&
+      if ((*i)->GetLocalAddress () == localAddress &&
           ((*i)->GetBoundNetDevice () == boundNetDevice || (*i)->GetBoundNetDevice () == 0))
         {
           NS_LOG_WARN ("Duplicated endpoint.");
@@ -143,7 +200,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice,
     }
   Ipv6EndPoint *endPoint = new Ipv6EndPoint (localAddress, localPort);
   endPoint->SetPeer (peerAddress, peerPort);
-  m_endPoints.push_back (endPoint);
+  Insert (endPoint);
 
   NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
 
@@ -152,16 +209,31 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice,
 
 void Ipv6EndPointDemux::DeAllocate (Ipv6EndPoint *endPoint)
 {
-  NS_LOG_FUNCTION (this);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  NS_LOG_FUNCTION (this << endPoint);
+  auto it = m_index.find (endPoint);
+  if (it == m_index.end ())
     {
-      if (*i == endPoint)
-        {
-          delete endPoint;
-          m_endPoints.erase (i);
-          break;
-        }
+      return;
+    }
+  EndPointIndex &index = it->second;
+  uint16_t port = endPoint->GetLocalPort ();
+  m_endPoints.erase (index.all);
+  auto portBucket = m_portEndPoints.find (port);
+  portBucket->second.erase (index.port);
+  if (portBucket->second.empty ())
+    {
+      m_portEndPoints.erase (portBucket);
+      m_portsInUse[port / 64] &= ~(uint64_t (1) << (port % 64));
+    }
+  auto peerBucket = m_peerEndPoints.find (index.key);
+  peerBucket->second.erase (index.peer);
+  if (peerBucket->second.empty ())
+    {
+      m_peerEndPoints.erase (peerBucket);
     }
+  m_index.erase (it);
+  endPoint->m_demux = 0;
+  delete endPoint;
 }
 
 /*
@@ -181,99 +253,112 @@ Ipv6EndPointDemux::EndPoints Ipv6EndPointDemux::Lookup (Ipv6Address daddr, uint1
   EndPoints retval4; /* Exact match on all 4 */
 
   NS_LOG_DEBUG ("Looking up endpoint for destination address " << daddr);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  /* A packet can only match the endpoints whose peer is either its source
+     or the wildcard, i.e., the endpoints of (at most) two peer buckets. */
+  PeerKey keys[2] = { PeerKey {dport, saddr, sport},
+                      PeerKey {dport, Ipv6Address::GetAny (), 0} };
+  uint32_t nKeys = (keys[0] == keys[1]) ? 1 : 2;
+  for (uint32_t k = 0; k < nKeys; k++)
     {
-      Ipv6EndPoint* endP = *i;
-
-      NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
-                                                 << " daddr=" << endP->GetLocalAddress ()
-                                                 << " sport=" << endP->GetPeerPort ()
-                                                 << " saddr=" << endP->GetPeerAddress ());
-
-      if (!endP->IsRxEnabled ())
+      auto bucket = m_peerEndPoints.find (keys[k]);
+      if (bucket == m_peerEndPoints.end ())
         {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                        << " because endpoint can not receive packets");
           continue;
         }
-
-      if (endP->GetLocalPort () != dport)
+      for (EndPointsI i = bucket->second.begin (); i != bucket->second.end (); i++)
         {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                             << " because endpoint dport "
-                                             << endP->GetLocalPort ()
-                                             << " does not match packet dport " << dport);
-          continue;
-        }
+          Ipv6EndPoint* endP = *i;
 
-      if (endP->GetBoundNetDevice ())
-        {
-          if (!incomingInterface)
+          NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
+                                                     << " daddr=" << endP->GetLocalAddress ()
+                                                     << " sport=" << endP->GetPeerPort ()
+                                                     << " saddr=" << endP->GetPeerAddress ());
+
+          if (!endP->IsRxEnabled ())
             {
+              NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                            << " because endpoint can not receive packets");
               continue;
             }
-          if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+
+          if (endP->GetLocalPort () != dport)
             {
               NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                                 << " because endpoint is bound to specific device and"
-                                                 << endP->GetBoundNetDevice ()
-                                                 << " does not match packet device " << incomingInterface->GetDevice ());
+                                                 << " because endpoint dport "
+                                                 << endP->GetLocalPort ()
+                                                 << " does not match packet dport " << dport);
               continue;
             }
-        }
 
-      /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-      NS_LOG_DEBUG ("dest addr " << daddr);
+          if (endP->GetBoundNetDevice ())
+            {
+              if (!incomingInterface)
+                {
+                  continue;
+                }
+              if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+                {
+                  NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                                                     << " because endpoint is bound to specific device and"
+                                                     << endP->GetBoundNetDevice ()
+                                                     << " does not match packet device " << incomingInterface->GetDevice ());
+                  continue;
+                }
+            }
 
-      bool localAddressMatchesWildCard = endP->GetLocalAddress () == Ipv6Address::GetAny ();
-      bool localAddressMatchesExact = endP->GetLocalAddress () == daddr;
-      bool localAddressMatchesAllRouters = endP->GetLocalAddress () == Ipv6Address::GetAllRoutersMulticast ();
+          /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
+          NS_LOG_DEBUG ("dest addr " << daddr);
 
-      /* if no match here, keep looking */
-      if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-          continue;
-        }
-      bool remotePeerMatchesExact = endP->GetPeerPort () == sport;
-      bool remotePeerMatchesWildCard = endP->GetPeerPort () == 0;
-      bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
-      bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv6Address::GetAny ();
-
-      /* If remote does not match either with exact or wildcard,i
-         skip this one */
-      if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-          continue;
-        }
-      if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-          continue;
-        }
+          bool localAddressMatchesWildCard = endP->GetLocalAddress () == Ipv6Address::GetAny ();
+          bool localAddressMatchesExact = endP->GetLocalAddress () == daddr;
+          bool localAddressMatchesAllRouters = endP->GetLocalAddress () == Ipv6Address::GetAllRoutersMulticast ();
 
-      /* Now figure out which return list to add this one to */
-      if (localAddressMatchesWildCard
-          && remotePeerMatchesWildCard
-          && remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-          retval1.push_back (endP);
-        }
-      if ((localAddressMatchesExact || (localAddressMatchesAllRouters))
-          && remotePeerMatchesWildCard
-          && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-          retval2.push_back (endP);
-        }
-      if (localAddressMatchesWildCard
-          && remotePeerMatchesExact
-          && remoteAddressMatchesExact)
-        { /* All but local address */
-          retval3.push_back (endP);
-        }
-      if (localAddressMatchesExact
-          && remotePeerMatchesExact
-          && remoteAddressMatchesExact)
-        { /* All 4 match */
-          retval4.push_back (endP);
+          /* if no match here, keep looking */
+          if (!(localAddressMatchesExact || localAddressMatchesWildCard))
+            {
+              continue;
+            }
+          bool remotePeerMatchesExact = endP->GetPeerPort () == sport;
+          bool remotePeerMatchesWildCard = endP->GetPeerPort () == 0;
+          bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
+          bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv6Address::GetAny ();
+
+          /* If remote does not match either with exact or wildcard,i
+             skip this one */
+          if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
+            {
+              continue;
+            }
+          if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+            {
+              continue;
+            }
+
+          /* Now figure out which return list to add this one to */
+          if (localAddressMatchesWildCard
+              && remotePeerMatchesWildCard
+              && remoteAddressMatchesWildCard)
+            { /* Only local port matches exactly */
+              retval1.push_back (endP);
+            }
+          if ((localAddressMatchesExact || (localAddressMatchesAllRouters))
+              && remotePeerMatchesWildCard
+              && remoteAddressMatchesWildCard)
+            { /* Only local port and local address matches exactly */
+              retval2.push_back (endP);
+            }
+          if (localAddressMatchesWildCard
+              && remotePeerMatchesExact
+              && remoteAddressMatchesExact)
+            { /* All but local address */
+              retval3.push_back (endP);
+            }
+          if (localAddressMatchesExact
+              && remotePeerMatchesExact
+              && remoteAddressMatchesExact)
+            { /* All 4 match */
+              retval4.push_back (endP);
+            }
         }
     }
 
@@ -292,8 +377,13 @@ Ipv6EndPoint* Ipv6EndPointDemux::SimpleLookup (Ipv6Address dst, uint16_t dport,
 {
   uint32_t genericity = 3;
   Ipv6EndPoint *generic = 0;
+  auto bucket = m_portEndPoints.find (dport);
+  if (bucket == m_portEndPoints.end ())
+    {
+      return 0;
+    }
 
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  for (EndPointsI i = bucket->second.begin (); i != bucket->second.end (); i++)
     {
       uint32_t tmp = 0;
 
@@ -328,24 +418,44 @@ Ipv6EndPoint* Ipv6EndPointDemux::SimpleLookup (Ipv6Address dst, uint16_t dport,
   return generic;
 }
 
-uint16_t Ipv6EndPointDemux::AllocateEphemeralPort ()
+uint16_t Ipv6EndPointDemux::FindFreePort (uint16_t first, uint16_t last) const
 {
-  NS_LOG_FUNCTION (this);
-  uint16_t port = m_ephemeral;
-  int count = m_portLast - m_portFirst;
-  do
+  uint32_t port = first;
+  while (port <= last)
     {
-      if (count-- < 0)
+      uint64_t word = m_portsInUse[port / 64];
+      if (word == ~uint64_t (0))
         {
-          return 0;
+          /* All the ports of this word are in use */
+          port = (port / 64 + 1) * 64;
+          continue;
         }
-      ++port;
-      if (port < m_portFirst || port > m_portLast)
+      if (((word >> (port % 64)) & 1) == 0)
         {
-          port = m_portFirst;
+          return port;
         }
+      port++;
+    }
+  return 0;
+}
+
+uint16_t Ipv6EndPointDemux::AllocateEphemeralPort ()
+{
+  NS_LOG_FUNCTION (this);
+  uint16_t start = m_ephemeral + 1;
+  if (start < m_portFirst || start > m_portLast)
+    {
+      start = m_portFirst;
+    }
+  uint16_t port = FindFreePort (start, m_portLast);
+  if (port == 0 && start > m_portFirst)
+    {
+      port = FindFreePort (m_portFirst, start - 1);
+    }
+  if (port == 0)
+    {
+      return 0;
     }
-  while (LookupPortLocal (port));
   m_ephemeral = port;
   return port;
 }
@@ -23,6 +23,8 @@
 
 #include <stdint.h>
 #include <list>
+#include <unordered_map>
+#include <vector>
 #include "ns3/ipv6-address.h"
 #include "ipv6-interface.h"
 
@@ -34,6 +36,10 @@ class Ipv6EndPoint;
  * \ingroup ipv6
  *
  * \brief Demultiplexer for end points.
+ *
+ * As in Ipv4EndPointDemux, the end points are indexed by local port and by
+ * (local port, peer address, peer port), and the ports in use are tracked
+ * in a bitmap.
  */
 class Ipv6EndPointDemux
 {
@@ -153,6 +159,79 @@ public:
   EndPoints GetEndPoints () const;
 
 private:
+  friend class Ipv6EndPoint;
+
+  /**
+   * \brief Key of the peer index.
+   */
+  struct PeerKey
+  {
+    uint16_t localPort;   //!< local port
+    Ipv6Address peerAddr; //!< peer address
+    uint16_t peerPort;    //!< peer port
+
+    /**
+     * \brief Compare two keys.
+     * \param other the other key
+     * \return true if the keys are equal
+     */
+    bool operator== (const PeerKey &other) const;
+  };
+
+  /**
+   * \brief Hash function for the peer index keys.
+   */
+  struct PeerKeyHash
+  {
+    /**
+     * \brief Hash a key.
+     * \param key the key
+     * \return the hash
+     */
+    size_t operator() (const PeerKey &key) const;
+  };
+
+  /**
+   * \brief Position of an endpoint in the demux containers.
+   */
+  struct EndPointIndex
+  {
+    EndPointsI all;  //!< position in m_endPoints
+    EndPointsI port; //!< position in the local port bucket
+    EndPointsI peer; //!< position in the peer bucket
+    PeerKey key;     //!< key of the peer bucket
+  };
+
+  /**
+   * \brief Insert a new endpoint in the list and in the indexes.
+   * \param endPoint the end point
+   */
+  void Insert (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Move an endpoint to the peer bucket matching its current peer.
+   *
+   * Called by Ipv6EndPoint::SetPeer.
+   *
+   * \param endPoint the end point
+   */
+  void UpdatePeer (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Build the peer index key of an endpoint.
+   * \param endPoint the end point
+   * \return the key
+   */
+  static PeerKey GetPeerKey (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Find the first port not in use in a range.
+   * \param first the first port of the range
+   * \param last the last port of the range
+   * \returns the port, or 0 if every port in the range is in use
+   */
+  uint16_t FindFreePort (uint16_t first, uint16_t last) const;
+
   /**
    * \brief Allocate a ephemeral port.
    * \return a port
@@ -175,9 +254,29 @@ private:
   uint16_t m_portLast;
 
   /**
-   * \brief A list of IPv6 end points.
+   * \brief A list of IPv6 end points, in allocation order.
    */
   EndPoints m_endPoints;
+
+  /**
+   * \brief Position of each end point in the containers.
+   */
+  std::unordered_map<Ipv6EndPoint *, EndPointIndex> m_index;
+
+  /**
+   * \brief End points by local port, in allocation order.
+   */
+  std::unordered_map<uint16_t, EndPoints> m_portEndPoints;
+
+  /**
+   * \brief End points by local port, peer address and peer port.
+   */
+  std::unordered_map<PeerKey, EndPoints, PeerKeyHash> m_peerEndPoints;
+
+  /**
+   * \brief Bitmap of the local ports in use, 64 ports per word.
+   */
+  std::vector<uint64_t> m_portsInUse;
 };
 
 } /* namespace ns3 */
@@ -31,6 +31,7 @@
 #include "ns3/mac16-address.h"
 #include "ns3/mac64-address.h"
 #include "ns3/traffic-control-layer.h"
+#include "ns3/segmentation-offload.h"
 
 #include "loopback-net-device.h"
 #include "ipv6-l3-protocol.h"
@@ -1143,7 +1144,28 @@ void Ipv6L3Protocol::SendRealOut (Ptr<Ipv6Route> route, Ptr<Packet> packet, Ipv6
       targetMtu = dev->GetMtu ();
     }
 
-  if (packet->GetSize () + ipHeader.GetSerializedSize () > targetMtu)
+  SegmentationTag segmentationTag;
+  if (packet->GetSize () + ipHeader.GetSerializedSize () > targetMtu
+      && packet->PeekPacketTag (segmentationTag))
+    {
+      // Super-segment => split into segments which fit the MTU by the
+      // device, if it supports segmentation offload, or here otherwise
+      if (!dev->SupportsSegmentationOffload ())
+        {
+          Ptr<Packet> superSegment = packet->Copy ();
+          superSegment->AddHeader (ipHeader);
+          std::list<Ptr<Packet> > segments = SegmentationOffload::Segment (superSegment, PROT_NUMBER);
+          for (std::list<Ptr<Packet> >::iterator it = segments.begin (); it != segments.end (); it++)
+            {
+              CoalescingTag coalescingTag;
+              (*it)->RemovePacketTag (coalescingTag);
+              Ipv6Header segmentHeader;
+              (*it)->RemoveHeader (segmentHeader);
+              fragments.push_back (Ipv6ExtensionFragment::Ipv6PayloadHeaderPair (*it, segmentHeader));
+            }
+        }
+    }
+  else if (packet->GetSize () + ipHeader.GetSerializedSize () > targetMtu)
     {
       // Router => drop
       if (!fromMe)
@@ -162,7 +162,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
   if (!LookupRoute (route, metric))
     {
       Ipv6RoutingTableEntry* routePtr = new Ipv6RoutingTableEntry (route);
-      m_networkRoutes.push_back (std::make_pair (routePtr, metric));
+      AppendNetworkRoute (routePtr, metric);
     }
 }
 
@@ -178,7 +178,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
   if (!LookupRoute (route, metric))
     {
       Ipv6RoutingTableEntry* routePtr = new Ipv6RoutingTableEntry (route);
-      m_networkRoutes.push_back (std::make_pair (routePtr, metric));
+      AppendNetworkRoute (routePtr, metric);
     }
 }
 
@@ -190,7 +190,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
   if (!LookupRoute (route, metric))
     {
       Ipv6RoutingTableEntry* routePtr = new Ipv6RoutingTableEntry (route);
-      m_networkRoutes.push_back (std::make_pair (routePtr, metric));
+      AppendNetworkRoute (routePtr, metric);
     }
 }
 
@@ -215,7 +215,7 @@ void Ipv6StaticRouting::SetDefaultMulticastRoute (uint32_t outputInterface)
   Ipv6Address network = Ipv6Address ("ff00::"); /* RFC 3513 */
   Ipv6Prefix networkMask = Ipv6Prefix (8);
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkMask, outputInterface);
-  m_networkRoutes.push_back (std::make_pair (route, 0));
+  AppendNetworkRoute (route, 0);
 }
 
 uint32_t Ipv6StaticRouting::GetNMulticastRoutes () const
@@ -300,9 +300,19 @@ bool Ipv6StaticRouting::HasNetworkDest (Ipv6Address network, uint32_t interfaceI
   return false;
 }
 
+void Ipv6StaticRouting::AppendNetworkRoute (Ipv6RoutingTableEntry *route, uint32_t metric)
+{
+  NS_LOG_FUNCTION (this << route << metric);
+  m_networkRoutes.push_back (std::make_pair (route, metric));
+  m_fib.Insert (route->GetDestNetwork (), route->GetDestNetworkPrefix (), m_networkRoutes.back ());
+}
+
 bool Ipv6StaticRouting::LookupRoute (const Ipv6RoutingTableEntry &route, uint32_t metric)
 {
-  for (NetworkRoutesI j = m_networkRoutes.begin (); j != m_networkRoutes.end (); j++)
+  // Only the routes to the same network can be equal
+  std::vector<NetworkRoutes::value_type> sameNetwork;
+  m_fib.Find (route.GetDestNetwork (), route.GetDestNetworkPrefix (), sameNetwork);
+  for (std::vector<NetworkRoutes::value_type>::const_iterator j = sameNetwork.begin (); j != sameNetwork.end (); j++)
     {
       Ipv6RoutingTableEntry* rtentry = j->first;
 
@@ -338,7 +348,10 @@ Ptr<Ipv6Route> Ipv6StaticRouting::LookupStatic (Ipv6Address dst, Ptr<NetDevice>
       return rtentry;
     }
 
-  for (NetworkRoutesI it = m_networkRoutes.begin (); it != m_networkRoutes.end (); it++)
+  // The candidate routes are the matching ones, in the order of the table
+  std::vector<NetworkRoutes::value_type> candidates;
+  m_fib.Lookup (dst, candidates);
+  for (std::vector<NetworkRoutes::value_type>::const_iterator it = candidates.begin (); it != candidates.end (); it++)
     {
       Ipv6RoutingTableEntry* j = it->first;
       uint32_t metric = it->second;
@@ -418,6 +431,7 @@ void Ipv6StaticRouting::DoDispose ()
       delete j->first;
     }
   m_networkRoutes.clear ();
+  m_fib.Clear ();
 
   for (MulticastRoutesI i = m_multicastRoutes.begin (); i != m_multicastRoutes.end (); i = m_multicastRoutes.erase (i))
     {
@@ -566,6 +580,7 @@ void Ipv6StaticRouting::RemoveRoute (uint32_t index)
     {
       if (tmp == index)
         {
+          m_fib.Erase (it->first->GetDestNetwork (), it->first->GetDestNetworkPrefix (), *it);
           delete it->first;
           m_networkRoutes.erase (it);
           return;
@@ -585,6 +600,7 @@ void Ipv6StaticRouting::RemoveRoute (Ipv6Address network, Ipv6Prefix prefix, uin
       if (network == rtentry->GetDest () && rtentry->GetInterface () == ifIndex
           && rtentry->GetPrefixToUse () == prefixToUse)
         {
+          m_fib.Erase (it->first->GetDestNetwork (), it->first->GetDestNetworkPrefix (), *it);
           delete it->first;
           m_networkRoutes.erase (it);
           return;
@@ -715,6 +731,7 @@ void Ipv6StaticRouting::NotifyInterfaceDown (uint32_t i)
     {
       if (it->first->GetInterface () == i)
         {
+          m_fib.Erase (it->first->GetDestNetwork (), it->first->GetDestNetworkPrefix (), *it);
           delete it->first;
           it = m_networkRoutes.erase (it);
         }
@@ -752,6 +769,7 @@ void Ipv6StaticRouting::NotifyRemoveAddress (uint32_t interface, Ipv6InterfaceAd
           && it->first->GetDestNetwork () == networkAddress
           && it->first->GetDestNetworkPrefix () == networkMask)
         {
+          m_fib.Erase (it->first->GetDestNetwork (), it->first->GetDestNetworkPrefix (), *it);
           delete it->first;
           it = m_networkRoutes.erase (it);
         }
@@ -800,6 +818,7 @@ void Ipv6StaticRouting::NotifyRemoveRoute (Ipv6Address dst, Ipv6Prefix mask, Ipv
 
           if (dst == entry && prefix == mask && rtentry->GetInterface () == interface)
             {
+              m_fib.Erase (j->first->GetDestNetwork (), j->first->GetDestNetworkPrefix (), *j);
               delete j->first;
               j = m_networkRoutes.erase (j);
             }
@@ -30,6 +30,7 @@
 #include "ns3/ipv6.h"
 #include "ns3/ipv6-header.h"
 #include "ns3/ipv6-routing-protocol.h"
+#include "prefix-trie.h"
 
 namespace ns3 {
 
@@ -264,6 +265,13 @@ private:
   /// Iterator for container for the multicast routes
   typedef std::list<Ipv6MulticastRoutingTableEntry *>::iterator MulticastRoutesI;
 
+  /**
+   * \brief Append a route to the forwarding table for network.
+   * \param route route
+   * \param metric metric of route
+   */
+  void AppendNetworkRoute (Ipv6RoutingTableEntry *route, uint32_t metric);
+
   /**
    * \brief Checks if a route is already present in the forwarding table.
    * \param route route
@@ -294,6 +302,11 @@ private:
    */
   NetworkRoutes m_networkRoutes;
 
+  /**
+   * \brief the longest-prefix-match index of m_networkRoutes.
+   */
+  PrefixTrie<std::pair <Ipv6RoutingTableEntry *, uint32_t> > m_fib;
+
   /**
    * \brief the forwarding table for multicast.
    */
@@ -32,6 +32,7 @@
 
 #include "tcp-l4-protocol.h"
 #include "tcp-header.h"
+#include "tcp-offload.h"
 #include "ipv4-end-point-demux.h"
 #include "ipv6-end-point-demux.h"
 #include "ipv4-end-point.h"
@@ -88,6 +89,13 @@ TcpL4Protocol::GetTypeId (void)
                    TypeIdValue (TcpPrrRecovery::GetTypeId ()),
                    MakeTypeIdAccessor (&TcpL4Protocol::m_recoveryTypeId),
                    MakeTypeIdChecker ())
+    .AddAttribute ("TimerWheelTick",
+                   "Width of the slots of the first level of the wheel which "
+                   "keeps the timers of the sockets, or zero to schedule each "
+                   "timer with the simulator.",
+                   TimeValue (MilliSeconds (1)),
+                   MakeTimeAccessor (&TcpL4Protocol::m_timerWheelTick),
+                   MakeTimeChecker (Time (0)))
     .AddAttribute ("SocketList", "The list of sockets associated to this protocol.",
                    ObjectVectorValue (),
                    MakeObjectVectorAccessor (&TcpL4Protocol::m_sockets),
@@ -100,6 +108,7 @@ TcpL4Protocol::TcpL4Protocol ()
   : m_endPoints (new Ipv4EndPointDemux ()), m_endPoints6 (new Ipv6EndPointDemux ())
 {
   NS_LOG_FUNCTION (this);
+  TcpOffload::Register ();
 }
 
 TcpL4Protocol::~TcpL4Protocol ()
@@ -175,12 +184,28 @@ TcpL4Protocol::DoDispose (void)
       m_endPoints6 = 0;
     }
 
+  if (m_timerWheel != nullptr)
+    {
+      m_timerWheel->Clear ();
+      m_timerWheel = nullptr;
+    }
+
   m_node = 0;
   m_downTarget.Nullify ();
   m_downTarget6.Nullify ();
   IpL4Protocol::DoDispose ();
 }
 
+Ptr<TcpTimerWheel>
+TcpL4Protocol::GetTimerWheel (void)
+{
+  if (m_timerWheel == nullptr && m_timerWheelTick.IsStrictlyPositive ())
+    {
+      m_timerWheel = Create<TcpTimerWheel> (m_timerWheelTick);
+    }
+  return m_timerWheel;
+}
+
 Ptr<Socket>
 TcpL4Protocol::CreateSocket (TypeId congestionTypeId)
 {
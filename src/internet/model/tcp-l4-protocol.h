@@ -26,7 +26,9 @@
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/sequence-number.h"
+#include "ns3/nstime.h"
 #include "ip-l4-protocol.h"
+#include "tcp-timer-wheel.h"
 
 
 namespace ns3 {
@@ -239,6 +241,15 @@ public:
    */
   bool RemoveSocket (Ptr<TcpSocketBase> socket);
 
+  /**
+   * \brief Get the wheel which keeps the timers of the sockets
+   *
+   * The wheel is created on the first call.
+   *
+   * \return the wheel, or 0 if the TimerWheelTick attribute is zero
+   */
+  Ptr<TcpTimerWheel> GetTimerWheel (void);
+
   /**
    * \brief Remove an IPv4 Endpoint.
    * \param endPoint the end point to remove
@@ -327,6 +338,8 @@ private:
   std::vector<Ptr<TcpSocketBase> > m_sockets;      //!< list of sockets
   IpL4Protocol::DownTargetCallback m_downTarget;   //!< Callback to send packets over IPv4
   IpL4Protocol::DownTargetCallback6 m_downTarget6; //!< Callback to send packets over IPv6
+  Time m_timerWheelTick;                           //!< Tick of the timer wheel
+  Ptr<TcpTimerWheel> m_timerWheel;                 //!< Timer wheel of the sockets
 
   /**
    * \brief Send a packet via TCP (IPv4)
@@ -0,0 +1,339 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "tcp-offload.h"
+#include "tcp-header.h"
+#include "tcp-l4-protocol.h"
+#include "ipv4-header.h"
+#include "ipv4-l3-protocol.h"
+#include "ipv6-header.h"
+#include "ipv6-l3-protocol.h"
+#include "ns3/node.h"
+#include "ns3/segmentation-offload.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TcpOffload");
+
+namespace {
+
+/**
+ * \ingroup tcp
+ * Flags of the segments which are coalesced
+ */
+const uint8_t COALESCED_FLAGS = TcpHeader::ACK | TcpHeader::PSH | TcpHeader::ECE | TcpHeader::CWR;
+
+/**
+ * \ingroup tcp
+ * \param ip the IPv4 header
+ * \return true if it is the header of a TCP segment which is not a fragment
+ */
+bool
+IsTcp (const Ipv4Header &ip)
+{
+  return ip.GetProtocol () == TcpL4Protocol::PROT_NUMBER
+         && ip.IsLastFragment () && ip.GetFragmentOffset () == 0;
+}
+
+/**
+ * \ingroup tcp
+ * \param ip the IPv6 header
+ * \return true if it is the header of a TCP segment without extension headers
+ */
+bool
+IsTcp (const Ipv6Header &ip)
+{
+  return ip.GetNextHeader () == TcpL4Protocol::PROT_NUMBER;
+}
+
+/**
+ * \ingroup tcp
+ * \param a an IPv4 header
+ * \param b another IPv4 header
+ * \return true if the segments of the headers can be coalesced
+ */
+bool
+IsSameFlow (const Ipv4Header &a, const Ipv4Header &b)
+{
+  return a.GetSource () == b.GetSource () && a.GetDestination () == b.GetDestination ()
+         && a.GetTos () == b.GetTos () && a.GetTtl () == b.GetTtl ();
+}
+
+/**
+ * \ingroup tcp
+ * \param a an IPv6 header
+ * \param b another IPv6 header
+ * \return true if the segments of the headers can be coalesced
+ */
+bool
+IsSameFlow (const Ipv6Header &a, const Ipv6Header &b)
+{
+  return a.GetSource () == b.GetSource () && a.GetDestination () == b.GetDestination ()
+         && a.GetTrafficClass () == b.GetTrafficClass () && a.GetFlowLabel () == b.GetFlowLabel ()
+         && a.GetHopLimit () == b.GetHopLimit ();
+}
+
+/**
+ * \ingroup tcp
+ * \brief Complete the IPv4 header of a segment
+ * \param ip the header of the super-segment
+ * \param payloadSize the size of the segment, with its TCP header
+ * \param index the index of the segment in the super-segment
+ * \return the header of the segment
+ */
+Ipv4Header
+MakeHeader (const Ipv4Header &ip, uint16_t payloadSize, uint16_t index)
+{
+  Ipv4Header header = ip;
+  header.SetPayloadSize (payloadSize);
+  header.SetIdentification (ip.GetIdentification () + index);
+  if (Node::ChecksumEnabled ())
+    {
+      header.EnableChecksum ();
+    }
+  return header;
+}
+
+/**
+ * \ingroup tcp
+ * \brief Complete the IPv6 header of a segment
+ * \param ip the header of the super-segment
+ * \param payloadSize the size of the segment, with its TCP header
+ * \param index the index of the segment in the super-segment
+ * \return the header of the segment
+ */
+Ipv6Header
+MakeHeader (const Ipv6Header &ip, uint16_t payloadSize, uint16_t index)
+{
+  Ipv6Header header = ip;
+  header.SetPayloadLength (payloadSize);
+  return header;
+}
+
+/**
+ * \ingroup tcp
+ * \brief Put a TCP header, with its checksum if enabled, on a segment
+ * \param p the payload of the segment
+ * \param tcp the TCP header
+ * \param ip the IP header of the segment
+ */
+template <typename IpHeader>
+void
+AddTcpHeader (Ptr<Packet> p, TcpHeader tcp, const IpHeader &ip)
+{
+  if (Node::ChecksumEnabled ())
+    {
+      tcp.EnableChecksums ();
+      tcp.InitializeChecksum (ip.GetSource (), ip.GetDestination (), TcpL4Protocol::PROT_NUMBER);
+    }
+  p->AddHeader (tcp);
+}
+
+/**
+ * \ingroup tcp
+ * \brief Split a TCP super-segment
+ * \param packet the super-segment, with its IP header
+ * \param segmentSize the payload size of the segments
+ * \return the segments, with their IP headers
+ */
+template <typename IpHeader>
+std::list<Ptr<Packet> >
+Segment (Ptr<Packet> packet, uint16_t segmentSize)
+{
+  std::list<Ptr<Packet> > segments;
+  Ptr<Packet> p = packet->Copy ();
+  IpHeader ip;
+  p->RemoveHeader (ip);
+  if (!IsTcp (ip) || segmentSize == 0)
+    {
+      segments.push_back (packet);
+      return segments;
+    }
+  TcpHeader tcp;
+  p->RemoveHeader (tcp);
+
+  uint32_t size = p->GetSize ();
+  uint16_t index = 0;
+  for (uint32_t offset = 0; offset < size || offset == 0; offset += segmentSize, index++)
+    {
+      uint32_t length = std::min<uint32_t> (segmentSize, size - offset);
+      bool last = offset + length >= size;
+      Ptr<Packet> segment = p->CreateFragment (offset, length);
+      TcpHeader header = tcp;
+      header.SetSequenceNumber (tcp.GetSequenceNumber () + offset);
+      uint8_t flags = tcp.GetFlags ();
+      if (!last)
+        {
+          flags &= ~(TcpHeader::FIN | TcpHeader::PSH);
+        }
+      if (index > 0)
+        {
+          flags &= ~TcpHeader::CWR;
+        }
+      header.SetFlags (flags);
+      IpHeader segmentIp = MakeHeader (ip, length + tcp.GetSerializedSize (), index);
+      AddTcpHeader (segment, header, segmentIp);
+      segment->AddHeader (segmentIp);
+      segments.push_back (segment);
+      if (last)
+        {
+          break;
+        }
+    }
+  NS_LOG_LOGIC ("Split " << size << " bytes from " << tcp.GetSequenceNumber ()
+                << " into " << segments.size () << " segments");
+  return segments;
+}
+
+/**
+ * \ingroup tcp
+ * \brief Coalesce TCP segments
+ * \param packets the packets, with their IP headers
+ * \return the coalesced packets
+ */
+template <typename IpHeader>
+std::list<Ptr<Packet> >
+Coalesce (const std::list<Ptr<Packet> > &packets)
+{
+  std::list<Ptr<Packet> > result;
+
+  // The run of segments being coalesced
+  Ptr<Packet> first;       // first segment of the run, as received
+  Ptr<Packet> payload;     // payload of the run
+  IpHeader firstIp;        // IP header of the first segment
+  TcpHeader firstTcp;      // TCP header of the first segment
+  TcpHeader lastTcp;       // TCP header of the last segment
+  uint8_t flags = 0;       // flags of the segments
+  uint32_t count = 0;      // number of segments
+  uint16_t segmentSize = 0; // payload size of the first segment
+
+  for (std::list<Ptr<Packet> >::const_iterator it = packets.begin (); ; it++)
+    {
+      Ptr<Packet> p;
+      IpHeader ip;
+      TcpHeader tcp;
+      bool mergeable = false;
+      if (it != packets.end ())
+        {
+          p = (*it)->Copy ();
+          p->RemoveHeader (ip);
+          if (IsTcp (ip))
+            {
+              p->RemoveHeader (tcp);
+              mergeable = p->GetSize () > 0 && (tcp.GetFlags () & ~COALESCED_FLAGS) == 0;
+            }
+        }
+
+      if (count > 0 && mergeable && !(flags & TcpHeader::PSH)
+          && IsSameFlow (ip, firstIp)
+          && tcp.GetSourcePort () == firstTcp.GetSourcePort ()
+          && tcp.GetDestinationPort () == firstTcp.GetDestinationPort ()
+          && tcp.GetSequenceNumber () == firstTcp.GetSequenceNumber () + payload->GetSize ()
+          && tcp.GetSerializedSize () + payload->GetSize () + p->GetSize () <= 0xffff - ip.GetSerializedSize ())
+        {
+          payload->AddAtEnd (p);
+          lastTcp = tcp;
+          flags |= tcp.GetFlags ();
+          count++;
+          continue;
+        }
+
+      // End of the run
+      if (count == 1)
+        {
+          result.push_back (first);
+        }
+      else if (count > 1)
+        {
+          TcpHeader header = lastTcp;
+          header.SetSequenceNumber (firstTcp.GetSequenceNumber ());
+          header.SetFlags (flags);
+          IpHeader coalescedIp = MakeHeader (firstIp, payload->GetSize () + header.GetSerializedSize (), 0);
+          AddTcpHeader (payload, header, coalescedIp);
+          payload->AddHeader (coalescedIp);
+          payload->AddPacketTag (SegmentationTag (segmentSize));
+          result.push_back (payload);
+          NS_LOG_LOGIC ("Coalesced " << count << " segments from " << firstTcp.GetSequenceNumber ());
+        }
+      count = 0;
+
+      if (it == packets.end ())
+        {
+          break;
+        }
+      if (mergeable)
+        {
+          first = *it;
+          payload = p;
+          firstIp = ip;
+          firstTcp = tcp;
+          lastTcp = tcp;
+          flags = tcp.GetFlags ();
+          count = 1;
+          segmentSize = p->GetSize ();
+        }
+      else
+        {
+          result.push_back (*it);
+        }
+    }
+  return result;
+}
+
+} // anonymous namespace
+
+void
+TcpOffload::Register (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  SegmentationOffload::Register (Ipv4L3Protocol::PROT_NUMBER,
+                                 MakeCallback (&TcpOffload::SegmentIpv4),
+                                 MakeCallback (&TcpOffload::CoalesceIpv4));
+  SegmentationOffload::Register (Ipv6L3Protocol::PROT_NUMBER,
+                                 MakeCallback (&TcpOffload::SegmentIpv6),
+                                 MakeCallback (&TcpOffload::CoalesceIpv6));
+}
+
+std::list<Ptr<Packet> >
+TcpOffload::SegmentIpv4 (Ptr<Packet> packet, uint16_t segmentSize)
+{
+  NS_LOG_FUNCTION (packet << segmentSize);
+  return Segment<Ipv4Header> (packet, segmentSize);
+}
+
+std::list<Ptr<Packet> >
+TcpOffload::CoalesceIpv4 (const std::list<Ptr<Packet> > &packets)
+{
+  NS_LOG_FUNCTION (packets.size ());
+  return Coalesce<Ipv4Header> (packets);
+}
+
+std::list<Ptr<Packet> >
+TcpOffload::SegmentIpv6 (Ptr<Packet> packet, uint16_t segmentSize)
+{
+  NS_LOG_FUNCTION (packet << segmentSize);
+  return Segment<Ipv6Header> (packet, segmentSize);
+}
+
+std::list<Ptr<Packet> >
+TcpOffload::CoalesceIpv6 (const std::list<Ptr<Packet> > &packets)
+{
+  NS_LOG_FUNCTION (packets.size ());
+  return Coalesce<Ipv6Header> (packets);
+}
+
+} // namespace ns3
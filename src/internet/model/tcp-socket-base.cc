@@ -43,6 +43,7 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/data-rate.h"
 #include "ns3/object.h"
+#include "ns3/segmentation-offload.h"
 #include "tcp-socket-base.h"
 #include "tcp-l4-protocol.h"
 #include "ipv4-end-point.h"
@@ -147,6 +148,15 @@ TcpSocketBase::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&TcpSocketBase::m_limitedTx),
                    MakeBooleanChecker ())
+    .AddAttribute ("SegmentationOffloadSize",
+                   "Maximum size of the super-segments of new data handed "
+                   "down at once and split into segments by the device "
+                   "(or by the network layer if the device does not "
+                   "support it), as with TCP segmentation offload. "
+                   "0 disables segmentation offload.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&TcpSocketBase::m_segmentationOffloadSize),
+                   MakeUintegerChecker<uint32_t> (0, 65000))
     .AddAttribute ("UseEcn", "Parameter to set ECN functionality",
                    EnumValue (TcpSocketState::Off),
                    MakeEnumAccessor (&TcpSocketBase::SetUseEcn),
@@ -259,7 +269,6 @@ TcpSocketBase::TcpSocketBase (void)
   m_tcb->m_rxBuffer = CreateObject<TcpRxBuffer> ();
 
   m_tcb->m_pacingRate = m_tcb->m_maxPacingRate;
-  m_pacingTimer.SetFunction (&TcpSocketBase::NotifyPacingPerformed, this);
 
   m_tcb->m_sendEmptyPacketCallback = MakeCallback (&TcpSocketBase::SendEmptyPacket, this);
 
@@ -353,7 +362,6 @@ TcpSocketBase::TcpSocketBase (const TcpSocketBase& sock)
     m_isFirstPartialAck (sock.m_isFirstPartialAck),
     m_txTrace (sock.m_txTrace),
     m_rxTrace (sock.m_rxTrace),
-    m_pacingTimer (Timer::CANCEL_ON_DESTROY),
     m_ecnEchoSeq (sock.m_ecnEchoSeq),
     m_ecnCESeq (sock.m_ecnCESeq),
     m_ecnCWRSeq (sock.m_ecnCWRSeq)
@@ -379,7 +387,7 @@ TcpSocketBase::TcpSocketBase (const TcpSocketBase& sock)
   m_tcb->m_rxBuffer = CopyObject (sock.m_tcb->m_rxBuffer);
 
   m_tcb->m_pacingRate = m_tcb->m_maxPacingRate;
-  m_pacingTimer.SetFunction (&TcpSocketBase::NotifyPacingPerformed, this);
+  SetTimerWheel ();
 
   if (sock.m_congestionControl)
     {
@@ -481,6 +489,7 @@ void
 TcpSocketBase::SetTcp (Ptr<TcpL4Protocol> tcp)
 {
   m_tcp = tcp;
+  SetTimerWheel ();
 }
 
 /* Set an RTT estimator with this socket */
@@ -1374,13 +1383,13 @@ TcpSocketBase::DoForwardUp (Ptr<Packet> packet, const Address &fromAddress,
     { // Zero window: Enter persist state to send 1 byte to probe
       NS_LOG_LOGIC (this << " Enter zerowindow persist state");
       NS_LOG_LOGIC (this << " Cancelled ReTxTimeout event which was set to expire at " <<
-                    (Simulator::Now () + Simulator::GetDelayLeft (m_retxEvent)).GetSeconds ());
+                    (Simulator::Now () + m_retxEvent.GetDelayLeft ()).GetSeconds ());
       m_retxEvent.Cancel ();
       NS_LOG_LOGIC ("Schedule persist timeout at time " <<
                     Simulator::Now ().GetSeconds () << " to expire at time " <<
                     (Simulator::Now () + m_persistTimeout).GetSeconds ());
-      m_persistEvent = Simulator::Schedule (m_persistTimeout, &TcpSocketBase::PersistTimeout, this);
-      NS_ASSERT (m_persistTimeout == Simulator::GetDelayLeft (m_persistEvent));
+      m_persistEvent.Schedule (m_persistTimeout, &TcpSocketBase::PersistTimeout, this);
+      NS_ASSERT (m_persistTimeout == m_persistEvent.GetDelayLeft ());
     }
 
   // TCP state machine code in different process functions
@@ -2624,7 +2633,7 @@ TcpSocketBase::DoPeerClose (void)
       m_dataRetrCount = m_dataRetries; // prevent endless FINs
       NS_LOG_LOGIC ("TcpSocketBase " << this << " scheduling LATO1");
       Time lastRto = m_rtt->GetEstimate () + Max (m_clockGranularity, m_rtt->GetVariation () * 4);
-      m_lastAckEvent = Simulator::Schedule (lastRto, &TcpSocketBase::LastAckTimeout, this);
+      m_lastAckEvent.Schedule (lastRto, &TcpSocketBase::LastAckTimeout, this);
     }
 }
 
@@ -2640,7 +2649,7 @@ TcpSocketBase::Destroy (void)
       m_tcp->RemoveSocket (this);
     }
   NS_LOG_LOGIC (this << " Cancelled ReTxTimeout event which was set to expire at " <<
-                (Simulator::Now () + Simulator::GetDelayLeft (m_retxEvent)).GetSeconds ());
+                (Simulator::Now () + m_retxEvent.GetDelayLeft ()).GetSeconds ());
   CancelAllTimers ();
 }
 
@@ -2656,7 +2665,7 @@ TcpSocketBase::Destroy6 (void)
       m_tcp->RemoveSocket (this);
     }
   NS_LOG_LOGIC (this << " Cancelled ReTxTimeout event which was set to expire at " <<
-                (Simulator::Now () + Simulator::GetDelayLeft (m_retxEvent)).GetSeconds ());
+                (Simulator::Now () + m_retxEvent.GetDelayLeft ()).GetSeconds ());
   CancelAllTimers ();
 }
 
@@ -2784,7 +2793,7 @@ TcpSocketBase::SendEmptyPacket (uint8_t flags)
       NS_LOG_LOGIC ("Schedule retransmission timeout at time "
                     << Simulator::Now ().GetSeconds () << " to expire at time "
                     << (Simulator::Now () + m_rto.Get ()).GetSeconds ());
-      m_retxEvent = Simulator::Schedule (m_rto, &TcpSocketBase::SendEmptyPacket, this, flags);
+      m_retxEvent.Schedule (m_rto, &TcpSocketBase::SendEmptyPacket, this, flags);
     }
 }
 
@@ -3038,12 +3047,30 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
   NS_LOG_FUNCTION (this << seq << maxSize << withAck);
 
   bool isStartOfTransmission = BytesInFlight () == 0U;
-  TcpTxItem *outItem = m_txBuffer->CopyFromSequence (maxSize, seq);
+  TcpTxItem *outItem = m_txBuffer->CopyFromSequence (std::min (maxSize, m_tcb->m_segmentSize), seq);
 
   m_rateOps->SkbSent(outItem, isStartOfTransmission);
 
   bool isRetransmission = outItem->IsRetrans ();
   Ptr<Packet> p = outItem->GetPacketCopy ();
+
+  // A super-segment (see SendPendingData) gathers the new data of several
+  // segments, which stay distinct items in the TxBuffer for the scoreboard
+  if (maxSize > m_tcb->m_segmentSize && !isRetransmission)
+    {
+      while (p->GetSize () < maxSize
+             && m_txBuffer->SizeFromSequence (seq + SequenceNumber32 (p->GetSize ())) > 0)
+        {
+          TcpTxItem *item = m_txBuffer->CopyFromSequence (std::min (maxSize - p->GetSize (), m_tcb->m_segmentSize),
+                                                          seq + SequenceNumber32 (p->GetSize ()));
+          m_rateOps->SkbSent (item, false);
+          p->AddAtEnd (item->GetPacketCopy ());
+        }
+      if (p->GetSize () > m_tcb->m_segmentSize)
+        {
+          p->AddPacketTag (SegmentationTag (m_tcb->m_segmentSize));
+        }
+    }
   uint32_t sz = p->GetSize (); // Size of packet
   uint8_t flags = withAck ? TcpHeader::ACK : 0;
   uint32_t remainingData = m_txBuffer->SizeFromSequence (seq + SequenceNumber32 (sz));
@@ -3059,7 +3086,8 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
         {
           NS_LOG_DEBUG ("Current Pacing Rate " << m_tcb->m_pacingRate);
           NS_LOG_DEBUG ("Timer is in expired state, activate it " << m_tcb->m_pacingRate.Get ().CalculateBytesTxTime (sz));
-          m_pacingTimer.Schedule (m_tcb->m_pacingRate.Get ().CalculateBytesTxTime (sz));
+          m_pacingTimer.Schedule (m_tcb->m_pacingRate.Get ().CalculateBytesTxTime (sz),
+                                  &TcpSocketBase::NotifyPacingPerformed, this);
         }
       else
         {
@@ -3126,7 +3154,7 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
       NS_LOG_LOGIC (this << " SendDataPacket Schedule ReTxTimeout at time " <<
                     Simulator::Now ().GetSeconds () << " to expire at time " <<
                     (Simulator::Now () + m_rto.Get ()).GetSeconds () );
-      m_retxEvent = Simulator::Schedule (m_rto, &TcpSocketBase::ReTxTimeout, this);
+      m_retxEvent.Schedule (m_rto, &TcpSocketBase::ReTxTimeout, this);
     }
 
   m_txTrace (p, header, this);
@@ -3281,6 +3309,17 @@ TcpSocketBase::SendPendingData (bool withAck)
           uint32_t maxSizeToSend = static_cast<uint32_t> (nextHigh - next);
           s = std::min (s, maxSizeToSend);
 
+          // With segmentation offload, send the new data that the windows
+          // allow, in whole segments, as a single super-segment
+          if (m_segmentationOffloadSize > m_tcb->m_segmentSize
+              && next == m_tcb->m_highTxMark && s == m_tcb->m_segmentSize)
+            {
+              SequenceNumber32 rWndEnd = m_highRxAckMark + SequenceNumber32 (m_rWnd);
+              uint32_t rWndLeft = rWndEnd > next ? static_cast<uint32_t> (rWndEnd - next) : 0;
+              uint32_t superSegment = std::min ({m_segmentationOffloadSize, availableWindow, availableData, rWndLeft});
+              s = std::max (s, superSegment / m_tcb->m_segmentSize * m_tcb->m_segmentSize);
+            }
+
           // (C.2) If any of the data octets sent in (C.1) are below HighData,
           //       HighRxt MUST be set to the highest sequence number of the
           //       retransmitted segment unless NextSeg () rule (4) was
@@ -3319,7 +3358,8 @@ TcpSocketBase::SendPendingData (bool withAck)
                 {
                   NS_LOG_DEBUG ("Current Pacing Rate " << m_tcb->m_pacingRate);
                   NS_LOG_DEBUG ("Timer is in expired state, activate it " << m_tcb->m_pacingRate.Get ().CalculateBytesTxTime (sz));
-                  m_pacingTimer.Schedule (m_tcb->m_pacingRate.Get ().CalculateBytesTxTime (sz));
+                  m_pacingTimer.Schedule (m_tcb->m_pacingRate.Get ().CalculateBytesTxTime (sz),
+                                          &TcpSocketBase::NotifyPacingPerformed, this);
                   break;
                 }
             }
@@ -3434,6 +3474,14 @@ TcpSocketBase::ReceivedData (Ptr<Packet> p, const TcpHeader& tcpHeader)
   NS_LOG_DEBUG ("Data segment, seq=" << tcpHeader.GetSequenceNumber () <<
                 " pkt size=" << p->GetSize () );
 
+  // A packet coalesced by the device counts as the segments it carries
+  uint32_t segments = 1;
+  SegmentationTag segmentationTag;
+  if (p->RemovePacketTag (segmentationTag) && segmentationTag.GetSegmentSize () > 0)
+    {
+      segments = (p->GetSize () + segmentationTag.GetSegmentSize () - 1) / segmentationTag.GetSegmentSize ();
+    }
+
   // Put into Rx buffer
   SequenceNumber32 expectedSeq = m_tcb->m_rxBuffer->NextRxSequence ();
   if (!m_tcb->m_rxBuffer->Add (p, tcpHeader))
@@ -3487,7 +3535,8 @@ TcpSocketBase::ReceivedData (Ptr<Packet> p, const TcpHeader& tcpHeader)
     }
   else
     { // In-sequence packet: ACK if delayed ack count allows
-      if (++m_delAckCount >= m_delAckMaxCount)
+      m_delAckCount += segments;
+      if (m_delAckCount >= m_delAckMaxCount)
         {
           m_delAckEvent.Cancel ();
           m_delAckCount = 0;
@@ -3511,10 +3560,10 @@ TcpSocketBase::ReceivedData (Ptr<Packet> p, const TcpHeader& tcpHeader)
       else if (m_delAckEvent.IsExpired ())
         {
           m_congestionControl->CwndEvent (m_tcb, TcpSocketState::CA_EVENT_DELAYED_ACK);
-          m_delAckEvent = Simulator::Schedule (m_delAckTimeout,
-                                               &TcpSocketBase::DelAckTimeout, this);
+          m_delAckEvent.Schedule (m_delAckTimeout,
+                                  &TcpSocketBase::DelAckTimeout, this);
           NS_LOG_LOGIC (this << " scheduled delayed ACK at " <<
-                        (Simulator::Now () + Simulator::GetDelayLeft (m_delAckEvent)).GetSeconds ());
+                        (Simulator::Now () + m_delAckEvent.GetDelayLeft ()).GetSeconds ());
         }
     }
 }
@@ -3587,7 +3636,7 @@ TcpSocketBase::NewAck (SequenceNumber32 const& ack, bool resetRTO)
   if (m_state != SYN_RCVD && resetRTO)
     { // Set RTO unless the ACK is received in SYN_RCVD state
       NS_LOG_LOGIC (this << " Cancelled ReTxTimeout event which was set to expire at " <<
-                    (Simulator::Now () + Simulator::GetDelayLeft (m_retxEvent)).GetSeconds ());
+                    (Simulator::Now () + m_retxEvent.GetDelayLeft ()).GetSeconds ());
       m_retxEvent.Cancel ();
       // On receiving a "New" ack we restart retransmission timer .. RFC 6298
       // RFC 6298, clause 2.4
@@ -3596,7 +3645,7 @@ TcpSocketBase::NewAck (SequenceNumber32 const& ack, bool resetRTO)
       NS_LOG_LOGIC (this << " Schedule ReTxTimeout at time " <<
                     Simulator::Now ().GetSeconds () << " to expire at time " <<
                     (Simulator::Now () + m_rto.Get ()).GetSeconds ());
-      m_retxEvent = Simulator::Schedule (m_rto, &TcpSocketBase::ReTxTimeout, this);
+      m_retxEvent.Schedule (m_rto, &TcpSocketBase::ReTxTimeout, this);
     }
 
   // Note the highest ACK and tell app to send more
@@ -3614,7 +3663,7 @@ TcpSocketBase::NewAck (SequenceNumber32 const& ack, bool resetRTO)
   if (m_txBuffer->Size () == 0 && m_state != FIN_WAIT_1 && m_state != CLOSING)
     { // No retransmit timer if no data to retransmit
       NS_LOG_LOGIC (this << " Cancelled ReTxTimeout event which was set to expire at " <<
-                    (Simulator::Now () + Simulator::GetDelayLeft (m_retxEvent)).GetSeconds ());
+                    (Simulator::Now () + m_retxEvent.GetDelayLeft ()).GetSeconds ());
       m_retxEvent.Cancel ();
     }
 }
@@ -3784,7 +3833,7 @@ TcpSocketBase::LastAckTimeout (void)
       SendEmptyPacket (TcpHeader::FIN | TcpHeader::ACK);
       NS_LOG_LOGIC ("TcpSocketBase " << this << " rescheduling LATO1");
       Time lastRto = m_rtt->GetEstimate () + Max (m_clockGranularity, m_rtt->GetVariation () * 4);
-      m_lastAckEvent = Simulator::Schedule (lastRto, &TcpSocketBase::LastAckTimeout, this);
+      m_lastAckEvent.Schedule (lastRto, &TcpSocketBase::LastAckTimeout, this);
     }
 }
 
@@ -3840,7 +3889,7 @@ TcpSocketBase::PersistTimeout ()
   NS_LOG_LOGIC ("Schedule persist timeout at time "
                 << Simulator::Now ().GetSeconds () << " to expire at time "
                 << (Simulator::Now () + m_persistTimeout).GetSeconds ());
-  m_persistEvent = Simulator::Schedule (m_persistTimeout, &TcpSocketBase::PersistTimeout, this);
+  m_persistEvent.Schedule (m_persistTimeout, &TcpSocketBase::PersistTimeout, this);
 }
 
 void
@@ -3890,6 +3939,18 @@ TcpSocketBase::CancelAllTimers ()
   m_pacingTimer.Cancel ();
 }
 
+void
+TcpSocketBase::SetTimerWheel (void)
+{
+  Ptr<TcpTimerWheel> wheel = m_tcp != nullptr ? m_tcp->GetTimerWheel () : nullptr;
+  m_retxEvent.SetWheel (wheel);
+  m_lastAckEvent.SetWheel (wheel);
+  m_delAckEvent.SetWheel (wheel);
+  m_persistEvent.SetWheel (wheel);
+  m_timewaitEvent.SetWheel (wheel);
+  m_pacingTimer.SetWheel (wheel);
+}
+
 /* Move TCP to Time_Wait state and schedule a transition to Closed state */
 void
 TcpSocketBase::TimeWait ()
@@ -3907,8 +3968,8 @@ TcpSocketBase::TimeWait ()
     }
   // Move from TIME_WAIT to CLOSED after 2*MSL. Max segment lifetime is 2 min
   // according to RFC793, p.28
-  m_timewaitEvent = Simulator::Schedule (Seconds (2 * m_msl),
-                                         &TcpSocketBase::CloseAndNotify, this);
+  m_timewaitEvent.Schedule (Seconds (2 * m_msl),
+                            &TcpSocketBase::CloseAndNotify, this);
 }
 
 /* Below are the attribute get/set functions */
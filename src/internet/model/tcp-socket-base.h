@@ -28,6 +28,7 @@
 #include "ns3/ipv4-header.h"
 #include "ns3/ipv6-header.h"
 #include "ns3/timer.h"
+#include "ns3/tcp-timer-wheel.h"
 #include "ns3/sequence-number.h"
 #include "ns3/data-rate.h"
 #include "ns3/node.h"
@@ -855,6 +856,11 @@ protected:
    */
   void CancelAllTimers (void);
 
+  /**
+   * \brief Keep the timers in the timer wheel of the TCP L4 protocol, if any
+   */
+  void SetTimerWheel (void);
+
   /**
    * \brief Move from CLOSING or FIN_WAIT_2 to TIME_WAIT state
    */
@@ -1243,11 +1249,11 @@ protected:
 
 protected:
   // Counters and events
-  EventId           m_retxEvent     {}; //!< Retransmission event
-  EventId           m_lastAckEvent  {}; //!< Last ACK timeout event
-  EventId           m_delAckEvent   {}; //!< Delayed ACK timeout event
-  EventId           m_persistEvent  {}; //!< Persist event: Send 1 byte to probe for a non-zero Rx window
-  EventId           m_timewaitEvent {}; //!< TIME_WAIT expiration event: Move this socket to CLOSED state
+  TcpTimer          m_retxEvent;     //!< Retransmission event
+  TcpTimer          m_lastAckEvent;  //!< Last ACK timeout event
+  TcpTimer          m_delAckEvent;   //!< Delayed ACK timeout event
+  TcpTimer          m_persistEvent;  //!< Persist event: Send 1 byte to probe for a non-zero Rx window
+  TcpTimer          m_timewaitEvent; //!< TIME_WAIT expiration event: Move this socket to CLOSED state
 
   // ACK management
   uint32_t          m_dupAckCount {0};     //!< Dupack counter
@@ -1323,6 +1329,7 @@ protected:
                                                   //!< which was set for handling previous congestion event.
   uint32_t               m_retxThresh {3};   //!< Fast Retransmit threshold
   bool                   m_limitedTx  {true}; //!< perform limited transmit
+  uint32_t               m_segmentationOffloadSize {0}; //!< Maximum size of the super-segments, 0 if disabled
 
   // Transmission Control Block
   Ptr<TcpSocketState>    m_tcb;               //!< Congestion control information
@@ -1341,7 +1348,7 @@ protected:
                  Ptr<const TcpSocketBase> > m_rxTrace; //!< Trace of received packets
 
   // Pacing related variable
-  Timer m_pacingTimer {Timer::CANCEL_ON_DESTROY}; //!< Pacing Event
+  TcpTimer m_pacingTimer; //!< Pacing Event
 
   // Parameters related to Explicit Congestion Notification
   TracedValue<SequenceNumber32> m_ecnEchoSeq {0};      //!< Sequence number of the last received ECN Echo
@@ -0,0 +1,395 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "tcp-timer-wheel.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TcpTimerWheel");
+
+TcpTimer::TcpTimer ()
+  : m_seq (0),
+    m_tick (0),
+    m_prev (nullptr),
+    m_next (nullptr),
+    m_level (0),
+    m_slot (0),
+    m_inSlot (false),
+    m_isDue (false)
+{
+}
+
+TcpTimer::~TcpTimer ()
+{
+  Cancel ();
+}
+
+void
+TcpTimer::SetWheel (Ptr<TcpTimerWheel> wheel)
+{
+  NS_ASSERT_MSG (!IsRunning (), "The wheel of a running timer cannot be changed");
+  m_wheel = wheel;
+}
+
+void
+TcpTimer::DoSchedule (const Time &delay, EventImpl *event)
+{
+  Cancel ();
+  if (m_wheel == nullptr)
+    {
+      m_eventId = Simulator::Schedule (delay, Ptr<EventImpl> (event, false));
+      return;
+    }
+  NS_ASSERT_MSG (delay.IsPositive (), "Cannot schedule a timer in the past");
+  m_event = Ptr<EventImpl> (event, false);
+  m_expiry = Simulator::Now () + delay;
+  m_wheel->Insert (this);
+}
+
+void
+TcpTimer::Cancel (void)
+{
+  if (m_event != nullptr)
+    {
+      m_wheel->Remove (this);
+      m_event = nullptr;
+    }
+  m_eventId.Cancel ();
+}
+
+bool
+TcpTimer::IsRunning (void) const
+{
+  return m_event != nullptr || m_eventId.IsRunning ();
+}
+
+bool
+TcpTimer::IsExpired (void) const
+{
+  return !IsRunning ();
+}
+
+Time
+TcpTimer::GetDelayLeft (void) const
+{
+  if (m_event != nullptr)
+    {
+      return m_expiry - Simulator::Now ();
+    }
+  return Simulator::GetDelayLeft (m_eventId);
+}
+
+TcpTimerWheel::TcpTimerWheel (Time tick)
+  : m_tick (tick.GetTimeStep ()),
+    m_current (0),
+    m_seq (0),
+    m_size (0),
+    m_expiring (false)
+{
+  NS_LOG_FUNCTION (this << tick);
+  NS_ASSERT_MSG (m_tick > 0, "The tick of the wheel must be positive");
+  for (uint32_t level = 0; level < LEVELS; level++)
+    {
+      for (uint32_t slot = 0; slot < SLOTS; slot++)
+        {
+          m_slots[level][slot] = nullptr;
+        }
+      m_levelSize[level] = 0;
+    }
+  for (uint32_t i = 0; i < SLOTS / 64; i++)
+    {
+      m_bitmap[i] = 0;
+    }
+}
+
+TcpTimerWheel::~TcpTimerWheel ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_size == 0);
+}
+
+Time
+TcpTimerWheel::GetTick (void) const
+{
+  return TimeStep (m_tick);
+}
+
+uint32_t
+TcpTimerWheel::GetSize (void) const
+{
+  return m_size;
+}
+
+void
+TcpTimerWheel::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t level = 0; level < LEVELS; level++)
+    {
+      for (uint32_t slot = 0; slot < SLOTS; slot++)
+        {
+          while (m_slots[level][slot] != nullptr)
+            {
+              TcpTimer *timer = m_slots[level][slot];
+              Unlink (timer);
+              timer->m_event = nullptr;
+            }
+        }
+    }
+  for (std::map<std::pair<int64_t, uint64_t>, TcpTimer *>::iterator it = m_due.begin ();
+       it != m_due.end (); it++)
+    {
+      it->second->m_isDue = false;
+      it->second->m_event = nullptr;
+    }
+  m_due.clear ();
+  m_size = 0;
+  m_wakeEvent.Cancel ();
+}
+
+void
+TcpTimerWheel::Insert (TcpTimer *timer)
+{
+  NS_LOG_FUNCTION (this << timer << timer->m_expiry);
+  if (m_size == 0)
+    {
+      // The wheel is empty: move it to the current time at once
+      m_current = std::max<uint64_t> (m_current, Simulator::Now ().GetTimeStep () / m_tick);
+    }
+  timer->m_seq = m_seq++;
+  timer->m_tick = timer->m_expiry.GetTimeStep () / m_tick;
+  Place (timer);
+  m_size++;
+  if (!m_expiring)
+    {
+      ScheduleWake ();
+    }
+}
+
+void
+TcpTimerWheel::Remove (TcpTimer *timer)
+{
+  NS_LOG_FUNCTION (this << timer);
+  if (timer->m_isDue)
+    {
+      m_due.erase (timer->m_due);
+      timer->m_isDue = false;
+    }
+  else
+    {
+      Unlink (timer);
+    }
+  m_size--;
+}
+
+void
+TcpTimerWheel::Place (TcpTimer *timer)
+{
+  if (timer->m_tick <= m_current)
+    {
+      timer->m_due = m_due.insert (std::make_pair (std::make_pair (timer->m_expiry.GetTimeStep (),
+                                                                   timer->m_seq),
+                                                   timer)).first;
+      timer->m_isDue = true;
+      return;
+    }
+  uint64_t delta = timer->m_tick - m_current;
+  uint64_t tick = timer->m_tick;
+  uint32_t level = 0;
+  while (level < LEVELS - 1 && delta >= (uint64_t (1) << ((level + 1) * SLOT_BITS)))
+    {
+      level++;
+    }
+  if (delta >= (uint64_t (1) << (LEVELS * SLOT_BITS)))
+    {
+      // Beyond the range of the wheel: keep the timer in the last slot of
+      // the range, and place it again from there
+      tick = m_current + (uint64_t (1) << (LEVELS * SLOT_BITS)) - 1;
+    }
+  uint32_t slot = (tick >> (level * SLOT_BITS)) & (SLOTS - 1);
+  timer->m_level = level;
+  timer->m_slot = slot;
+  timer->m_prev = nullptr;
+  timer->m_next = m_slots[level][slot];
+  if (timer->m_next != nullptr)
+    {
+      timer->m_next->m_prev = timer;
+    }
+  m_slots[level][slot] = timer;
+  timer->m_inSlot = true;
+  m_levelSize[level]++;
+  if (level == 0)
+    {
+      m_bitmap[slot / 64] |= uint64_t (1) << (slot % 64);
+    }
+}
+
+void
+TcpTimerWheel::Unlink (TcpTimer *timer)
+{
+  NS_ASSERT (timer->m_inSlot);
+  if (timer->m_prev != nullptr)
+    {
+      timer->m_prev->m_next = timer->m_next;
+    }
+  else
+    {
+      m_slots[timer->m_level][timer->m_slot] = timer->m_next;
+    }
+  if (timer->m_next != nullptr)
+    {
+      timer->m_next->m_prev = timer->m_prev;
+    }
+  timer->m_prev = nullptr;
+  timer->m_next = nullptr;
+  timer->m_inSlot = false;
+  m_levelSize[timer->m_level]--;
+  if (timer->m_level == 0 && m_slots[0][timer->m_slot] == nullptr)
+    {
+      m_bitmap[timer->m_slot / 64] &= ~(uint64_t (1) << (timer->m_slot % 64));
+    }
+}
+
+void
+TcpTimerWheel::Cascade (uint32_t level, uint32_t slot)
+{
+  NS_LOG_FUNCTION (this << level << slot);
+  while (m_slots[level][slot] != nullptr)
+    {
+      TcpTimer *timer = m_slots[level][slot];
+      Unlink (timer);
+      Place (timer);
+    }
+}
+
+bool
+TcpTimerWheel::GetNextTick (uint64_t &tick) const
+{
+  bool found = false;
+  // Next non-empty slot of the first level, after the current one
+  for (uint32_t d = 1; d <= SLOTS; )
+    {
+      uint32_t slot = (m_current + d) & (SLOTS - 1);
+      uint64_t word = m_bitmap[slot / 64] >> (slot % 64);
+      if (word == 0)
+        {
+          d += 64 - slot % 64;
+          continue;
+        }
+      while ((word & 1) == 0)
+        {
+          word >>= 1;
+          d++;
+        }
+      if (d <= SLOTS)
+        {
+          tick = m_current + d;
+          found = true;
+        }
+      break;
+    }
+  // Next turn of the first level, if the other levels have timers
+  for (uint32_t level = 1; level < LEVELS; level++)
+    {
+      if (m_levelSize[level] > 0)
+        {
+          uint64_t turn = (m_current | (SLOTS - 1)) + 1;
+          if (!found || turn < tick)
+            {
+              tick = turn;
+              found = true;
+            }
+          break;
+        }
+    }
+  return found;
+}
+
+void
+TcpTimerWheel::Advance (uint64_t tick)
+{
+  NS_LOG_FUNCTION (this << tick);
+  uint64_t next;
+  while (GetNextTick (next) && next <= tick)
+    {
+      m_current = next;
+      for (uint32_t level = 1; level < LEVELS; level++)
+        {
+          if ((m_current & ((uint64_t (1) << (level * SLOT_BITS)) - 1)) != 0)
+            {
+              break;
+            }
+          Cascade (level, (m_current >> (level * SLOT_BITS)) & (SLOTS - 1));
+        }
+      Cascade (0, m_current & (SLOTS - 1));
+    }
+  m_current = std::max (m_current, tick);
+}
+
+void
+TcpTimerWheel::ScheduleWake (void)
+{
+  Time wake;
+  uint64_t tick;
+  if (!m_due.empty ())
+    {
+      wake = TimeStep (m_due.begin ()->first.first);
+    }
+  else if (GetNextTick (tick))
+    {
+      wake = Max (TimeStep (tick * m_tick), Simulator::Now ());
+    }
+  else
+    {
+      return;
+    }
+  if (m_wakeEvent.IsRunning ())
+    {
+      if (m_wakeTime <= wake)
+        {
+          return;
+        }
+      m_wakeEvent.Remove ();
+    }
+  m_wakeTime = wake;
+  m_wakeEvent = Simulator::Schedule (wake - Simulator::Now (), &TcpTimerWheel::Expire,
+                                     Ptr<TcpTimerWheel> (this));
+}
+
+void
+TcpTimerWheel::Expire (void)
+{
+  NS_LOG_FUNCTION (this);
+  int64_t now = Simulator::Now ().GetTimeStep ();
+  Advance (now / m_tick);
+  m_expiring = true;
+  while (!m_due.empty () && m_due.begin ()->first.first <= now)
+    {
+      TcpTimer *timer = m_due.begin ()->second;
+      m_due.erase (m_due.begin ());
+      timer->m_isDue = false;
+      m_size--;
+      Ptr<EventImpl> event = timer->m_event;
+      timer->m_event = nullptr;
+      event->Invoke ();
+    }
+  m_expiring = false;
+  ScheduleWake ();
+}
+
+} // namespace ns3
@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TCP_TIMER_WHEEL_H
+#define TCP_TIMER_WHEEL_H
+
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/event-impl.h"
+#include "ns3/make-event.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include <map>
+
+namespace ns3 {
+
+class TcpTimerWheel;
+
+/**
+ * \ingroup tcp
+ *
+ * \brief A timer of a TCP socket
+ *
+ * The timer is used like an EventId returned by Simulator::Schedule, but
+ * it is kept in the TcpTimerWheel of the TcpL4Protocol of the socket, if
+ * any: canceling or rescheduling it unlinks it from the wheel, instead of
+ * leaving a canceled event in the scheduler until its expiration time.
+ * Without a wheel, the timer is scheduled with the simulator.
+ *
+ * The timer cannot be copied; it is canceled when it is destroyed.
+ */
+class TcpTimer
+{
+public:
+  TcpTimer ();
+  ~TcpTimer ();
+
+  /**
+   * \brief Set the wheel which keeps the timer
+   *
+   * The timer must not be running.
+   *
+   * \param wheel the wheel, or 0 to schedule the timer with the simulator
+   */
+  void SetWheel (Ptr<TcpTimerWheel> wheel);
+
+  /**
+   * \brief Schedule the timer, canceling its pending expiration if any
+   *
+   * The arguments are those of Simulator::Schedule.
+   *
+   * \param delay the delay after which the timer expires
+   * \param args the function to invoke and its arguments
+   */
+  template <typename... Ts>
+  void Schedule (const Time &delay, Ts... args);
+
+  /**
+   * \brief Cancel the timer, if it is running
+   */
+  void Cancel (void);
+
+  /**
+   * \return true if the timer is scheduled and has not expired yet
+   */
+  bool IsRunning (void) const;
+
+  /**
+   * \return true if the timer is not running
+   */
+  bool IsExpired (void) const;
+
+  /**
+   * \return the delay left before the timer expires, or zero if it is not
+   *         running
+   */
+  Time GetDelayLeft (void) const;
+
+private:
+  friend class TcpTimerWheel;
+
+  /**
+   * \brief Copy constructor, disabled
+   * \param timer the timer
+   */
+  TcpTimer (const TcpTimer &timer) = delete;
+  /**
+   * \brief Assignment operator, disabled
+   * \param timer the timer
+   * \return this timer
+   */
+  TcpTimer &operator= (const TcpTimer &timer) = delete;
+
+  /**
+   * \brief Schedule the timer
+   * \param delay the delay after which the timer expires
+   * \param event the event to invoke
+   */
+  void DoSchedule (const Time &delay, EventImpl *event);
+
+  Ptr<TcpTimerWheel> m_wheel;   //!< The wheel, or 0
+  EventId m_eventId;            //!< The event, without wheel
+  Ptr<EventImpl> m_event;       //!< The event, while running in the wheel
+  Time m_expiry;                //!< The expiration time, while running in the wheel
+  uint64_t m_seq;               //!< Order of scheduling, for the timers which expire together
+  uint64_t m_tick;              //!< The tick of the expiration time
+  // Links in the wheel
+  TcpTimer *m_prev;             //!< The previous timer of the slot
+  TcpTimer *m_next;             //!< The next timer of the slot
+  uint32_t m_level;             //!< The level of the slot
+  uint32_t m_slot;              //!< The slot in the level
+  bool m_inSlot;                //!< Whether the timer is in a slot
+  std::map<std::pair<int64_t, uint64_t>, TcpTimer *>::iterator m_due; //!< Position in the due timers
+  bool m_isDue;                 //!< Whether the timer is in the due timers
+};
+
+/**
+ * \ingroup tcp
+ *
+ * \brief Hierarchical timer wheel of the TCP sockets of a node
+ *
+ * The timers (see TcpTimer) are hashed by expiration tick into the slots
+ * of four levels of 256 slots each: the slots of the first level are one
+ * tick wide, those of the next levels 256 times wider than the previous
+ * level, for a range of 2^32 ticks; timers further away are kept in the
+ * last level and placed again when it is reached. As the wheel turns, the
+ * slots of a level are cascaded to the lower levels, and the timers of the
+ * current tick are moved to a list of due timers, sorted by expiration
+ * time. Scheduling and canceling a timer thus take constant time, except
+ * for the due timers, such as the pacing timers, which are usually shorter
+ * than a tick and few.
+ *
+ * The wheel schedules a single simulator event at a time: at the
+ * expiration time of the first due timer, or else at the start of the next
+ * tick with timers. The timers thus expire at their exact expiration time,
+ * and the tick only trades the work done when the wheel turns for the
+ * work done when scheduling the timers. The event of the wheel is only
+ * rescheduled when a timer expires before it; it is not rescheduled when
+ * timers are canceled, so that it may expire without any timer due.
+ */
+class TcpTimerWheel : public SimpleRefCount<TcpTimerWheel>
+{
+public:
+  /**
+   * \brief Constructor
+   * \param tick the width of the slots of the first level
+   */
+  TcpTimerWheel (Time tick);
+  ~TcpTimerWheel ();
+
+  /**
+   * \return the width of the slots of the first level
+   */
+  Time GetTick (void) const;
+
+  /**
+   * \return the number of running timers
+   */
+  uint32_t GetSize (void) const;
+
+  /**
+   * \brief Cancel all the timers and the event of the wheel
+   */
+  void Clear (void);
+
+private:
+  friend class TcpTimer;
+
+  /// Number of levels
+  static const uint32_t LEVELS = 4;
+  /// Number of bits of the slot index
+  static const uint32_t SLOT_BITS = 8;
+  /// Number of slots of each level
+  static const uint32_t SLOTS = 1 << SLOT_BITS;
+
+  /**
+   * \brief Add a timer, whose expiration time and event are set
+   * \param timer the timer
+   */
+  void Insert (TcpTimer *timer);
+
+  /**
+   * \brief Remove a running timer
+   * \param timer the timer
+   */
+  void Remove (TcpTimer *timer);
+
+  /**
+   * \brief Put a timer in the slot of its expiration tick, or in the due
+   *        timers if the tick is reached
+   * \param timer the timer
+   */
+  void Place (TcpTimer *timer);
+
+  /**
+   * \brief Remove a timer from its slot
+   * \param timer the timer
+   */
+  void Unlink (TcpTimer *timer);
+
+  /**
+   * \brief Place again the timers of a slot
+   * \param level the level of the slot
+   * \param slot the slot
+   */
+  void Cascade (uint32_t level, uint32_t slot);
+
+  /**
+   * \brief Turn the wheel up to a tick
+   * \param tick the tick
+   */
+  void Advance (uint64_t tick);
+
+  /**
+   * \brief Get the next tick at which the wheel has timers to move
+   * \param [out] tick the tick
+   * \return false if the wheel has no timer in its slots
+   */
+  bool GetNextTick (uint64_t &tick) const;
+
+  /**
+   * \brief Schedule the event of the wheel, if needed
+   */
+  void ScheduleWake (void);
+
+  /**
+   * \brief Expire the due timers
+   */
+  void Expire (void);
+
+  int64_t m_tick;                       //!< Width of the slots of the first level, in time steps
+  uint64_t m_current;                   //!< The current tick
+  TcpTimer *m_slots[LEVELS][SLOTS];     //!< The timers of the slots
+  uint64_t m_bitmap[SLOTS / 64];        //!< The non-empty slots of the first level
+  uint32_t m_levelSize[LEVELS];         //!< The number of timers of each level
+  std::map<std::pair<int64_t, uint64_t>, TcpTimer *> m_due; //!< The due timers, by expiration time and order of scheduling
+  uint64_t m_seq;                       //!< Order of the next timer scheduled
+  uint32_t m_size;                      //!< Number of running timers
+  EventId m_wakeEvent;                  //!< The event of the wheel
+  Time m_wakeTime;                      //!< The expiration time of the event of the wheel
+  bool m_expiring;                      //!< Whether the wheel is expiring timers
+};
+
+template <typename... Ts>
+void
+TcpTimer::Schedule (const Time &delay, Ts... args)
+{
+  DoSchedule (delay, MakeEvent (args...));
+}
+
+} // namespace ns3
+
+#endif /* TCP_TIMER_WHEEL_H */
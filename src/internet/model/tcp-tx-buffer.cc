@@ -58,7 +58,8 @@ TcpTxBuffer::GetTypeId (void)
  * initialized below is insignificant.
  */
 TcpTxBuffer::TcpTxBuffer (uint32_t n)
-  : m_maxBuffer (32768), m_size (0), m_sentSize (0), m_firstByteSeq (n)
+  : m_maxBuffer (32768), m_size (0), m_sentSize (0), m_firstByteSeq (n),
+    m_lostUpTo (n), m_highestLost (n), m_nextSegFrom (n)
 {
   m_rWndCallback = MakeNullCallback<uint32_t> ();
 }
@@ -165,10 +166,13 @@ TcpTxBuffer::SetHeadSequence (const SequenceNumber32& seq)
 {
   NS_LOG_FUNCTION (this << seq);
   m_firstByteSeq = seq;
+  m_lostUpTo = m_highestLost = m_nextSegFrom = seq;
 
   if (m_sentList.size () > 0)
     {
       m_sentList.front ()->m_startSeq = seq;
+      m_sentIndex.clear ();
+      m_sentIndex[seq] = m_sentList.begin ();
     }
 
   // if you change the head with data already sent, something bad will happen
@@ -296,9 +300,15 @@ TcpTxBuffer::GetNewSegment (uint32_t numBytes)
   NS_ASSERT (it != m_appList.end ());
 
   m_appList.erase (it);
-  m_sentList.insert (m_sentList.end (), item);
+  m_sentIndex[item->m_startSeq] = m_sentList.insert (m_sentList.end (), item);
   m_sentSize += item->m_packet->GetSize ();
 
+  if (item->m_lost && m_highestLost < item->m_startSeq + item->m_packet->GetSize ())
+    {
+      // The item was sent before (see ResetLastSegmentSent)
+      m_highestLost = item->m_startSeq + item->m_packet->GetSize ();
+    }
+
   return item;
 }
 
@@ -310,36 +320,33 @@ TcpTxBuffer::GetTransmittedSegment (uint32_t numBytes, const SequenceNumber32 &s
   NS_ASSERT (numBytes <= m_sentSize);
   NS_ASSERT (m_sentList.size () >= 1);
 
-  auto it = m_sentList.begin ();
+  auto index = m_sentIndex.find (seq);
   bool listEdited = false;
   uint32_t s = numBytes;
 
   // Avoid to merge different packet for this retransmission if flags are
   // different.
-  for (; it != m_sentList.end(); ++it)
+  if (index != m_sentIndex.end ())
     {
-      if ((*it)->m_startSeq == seq)
+      auto it = index->second;
+      auto next = it;
+      next++;
+      if (next != m_sentList.end ())
         {
-          auto next = it;
-          next++;
-          if (next != m_sentList.end ())
+          // Next is not sacked and have the same value for m_lost ... there is the possibility to merge
+          if ((! (*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-              // Next is not sacked and have the same value for m_lost ... there is the possibility to merge
-              if ((! (*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                  s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
-                }
-              else
-                {
-                  // Next is sacked... better to retransmit only the first segment
-                  s = std::min(s, (*it)->m_packet->GetSize ());
-                }
+              s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
             }
           else
             {
+              // Next is sacked... better to retransmit only the first segment
               s = std::min(s, (*it)->m_packet->GetSize ());
             }
-          break;
+        }
+      else
+        {
+          s = std::min(s, (*it)->m_packet->GetSize ());
         }
     }
 
@@ -436,12 +443,26 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
   TcpTxItem *outItem = nullptr;
   PacketList::iterator it = list.begin ();
   SequenceNumber32 beginOfCurrentPacket = listStartFrom;
+  bool isSentList = (&list == &m_sentList);
+  TcpTxBuffer *self = const_cast<TcpTxBuffer*> (this);
+
+  if (isSentList)
+    {
+      // Start from the item that contains seq
+      auto index = m_sentIndex.upper_bound (seq);
+      if (index != m_sentIndex.begin ())
+        {
+          --index;
+          it = index->second;
+          beginOfCurrentPacket = index->first;
+        }
+    }
 
   while (it != list.end ())
     {
       currentItem = *it;
       currentPacket = currentItem->m_packet;
-      NS_ASSERT_MSG (list != m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
+      NS_ASSERT_MSG (!isSentList || currentItem->m_startSeq >= m_firstByteSeq,
                      "start: " << m_firstByteSeq << " currentItem start: " <<
                      currentItem->m_startSeq);
 
@@ -471,7 +492,12 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
               SplitItems (firstPart, currentItem, seq - beginOfCurrentPacket);
 
               // insert firstPart before currentItem
-              list.insert (it, firstPart);
+              PacketList::iterator firstPartIt = list.insert (it, firstPart);
+              if (isSentList)
+                {
+                  self->m_sentIndex[firstPart->m_startSeq] = firstPartIt;
+                  self->m_sentIndex[currentItem->m_startSeq] = it;
+                }
               if (listEdited)
                 {
                   *listEdited = true;
@@ -518,6 +544,10 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
                   TcpTxItem *previous = *(--it);
 
                   list.erase (it);
+                  if (isSentList)
+                    {
+                      self->m_sentIndex.erase (currentItem->m_startSeq);
+                    }
 
                   MergeItems (previous, currentItem);
                   delete currentItem;
@@ -537,7 +567,12 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
               SplitItems (firstPart, currentItem, numBytes);
 
               // insert firstPart before currentItem
-              list.insert (it, firstPart);
+              PacketList::iterator firstPartIt = list.insert (it, firstPart);
+              if (isSentList)
+                {
+                  self->m_sentIndex[firstPart->m_startSeq] = firstPartIt;
+                  self->m_sentIndex[currentItem->m_startSeq] = it;
+                }
               if (listEdited)
                 {
                   *listEdited = true;
@@ -567,6 +602,10 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
 
           MergeItems (currentItem, next);
           list.erase (it);
+          if (isSentList)
+            {
+              self->m_sentIndex.erase (next->m_startSeq);
+            }
 
           delete next;
 
@@ -599,6 +638,8 @@ TcpTxBuffer::MergeItems (TcpTxItem *t1, TcpTxItem *t2) const
   // be updated in MarkTransmittedSegment.
   if (t1->m_retrans != t2->m_retrans)
     {
+      // The merged item can be returned again by NextSeg
+      m_nextSegFrom = std::min (m_nextSegFrom, t1->m_startSeq);
       if (t1->m_retrans)
         {
           TcpTxBuffer *self = const_cast<TcpTxBuffer*> (this);
@@ -650,16 +691,16 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked (const SequenceNumber32& ack) const
 {
   NS_LOG_FUNCTION (this);
-  for (const auto &it : m_sentList)
-     {
-       TcpTxItem *item = it;
-       Ptr<Packet> p = item->m_packet;
-       if (item->m_startSeq + p->GetSize () == ack && !item->m_sacked && item->m_retrans)
-         {
-           return true;
-         }
-     }
-  return false;
+  // Only the item that starts right before ack can end at ack
+  auto index = m_sentIndex.lower_bound (ack);
+  if (index == m_sentIndex.begin ())
+    {
+      return false;
+    }
+  --index;
+  TcpTxItem *item = *index->second;
+  Ptr<Packet> p = item->m_packet;
+  return item->m_startSeq + p->GetSize () == ack && !item->m_sacked && item->m_retrans;
 }
 
 void
@@ -707,6 +748,7 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
 
           RemoveFromCounts (item, pktSize);
 
+          m_sentIndex.erase (item->m_startSeq);
           i = m_sentList.erase (i);
           NS_LOG_INFO ("Removed " << *item << " lost: " << m_lostOut <<
                        " retrans: " << m_retrans << " sacked: " << m_sackedOut <<
@@ -726,7 +768,9 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
           NS_LOG_INFO (*item);
           // PacketTags are preserved when fragmenting
           item->m_packet = item->m_packet->CreateFragment (offset, pktSize);
+          m_sentIndex.erase (item->m_startSeq);
           item->m_startSeq += offset;
+          m_sentIndex[item->m_startSeq] = i;
           m_size -= offset;
           m_sentSize -= offset;
           m_firstByteSeq += offset;
@@ -745,6 +789,11 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
       m_firstByteSeq = seq;
     }
 
+  // The marks can not lag behind SND.UNA
+  m_lostUpTo = std::max (m_lostUpTo, m_firstByteSeq.Get ());
+  m_highestLost = std::max (m_highestLost, m_firstByteSeq.Get ());
+  m_nextSegFrom = std::max (m_nextSegFrom, m_firstByteSeq.Get ());
+
   if (!m_sentList.empty ())
     {
       TcpTxItem *head = m_sentList.front ();
@@ -756,6 +805,7 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
           // when adding Reno dupacks in the count.
           head->m_sacked = false;
           m_sackedOut -= head->m_packet->GetSize ();
+          m_lostUpTo = m_nextSegFrom = m_firstByteSeq;
           NS_LOG_INFO ("Moving the SACK flag from the HEAD to another segment");
           AddRenoSack ();
           MarkHeadAsLost ();
@@ -790,8 +840,8 @@ TcpTxBuffer::Update (const TcpOptionSack::SackList &list,
 
   for (auto option_it = list.begin (); option_it != list.end (); ++option_it)
     {
-      PacketList::iterator item_it = m_sentList.begin ();
-      SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
+      PacketList::iterator item_it = m_sentList.end ();
+      SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq + m_sentSize;
 
       if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
@@ -799,6 +849,14 @@ TcpTxBuffer::Update (const TcpOptionSack::SackList &list,
           return bytesSacked;
         }
 
+      // Items that start before the block can not be sacked by it
+      auto index = m_sentIndex.lower_bound ((*option_it).first);
+      if (index != m_sentIndex.end ())
+        {
+          item_it = index->second;
+          beginOfCurrentPacket = index->first;
+        }
+
       while (item_it != m_sentList.end ())
         {
           uint32_t pktSize = (*item_it)->m_packet->GetSize ();
@@ -892,6 +950,7 @@ TcpTxBuffer::UpdateLostCount ()
                    ", will start from item " << *(*m_highestSack.first));
     }
 
+  SequenceNumber32 lostUpTo = m_lostUpTo;
   for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
     {
       TcpTxItem *item = *it;
@@ -902,14 +961,28 @@ TcpTxBuffer::UpdateLostCount ()
 
       if (sacked >= m_dupAckThresh)
         {
+          if (item->m_startSeq < m_lostUpTo)
+            {
+              // The items below are already lost or sacked
+              break;
+            }
+          if (lostUpTo < item->m_startSeq)
+            {
+              lostUpTo = item->m_startSeq;
+            }
           if (!item->m_sacked && !item->m_lost)
             {
               item->m_lost = true;
               m_lostOut += item->m_packet->GetSize ();
+              if (m_highestLost < item->m_startSeq + item->m_packet->GetSize ())
+                {
+                  m_highestLost = item->m_startSeq + item->m_packet->GetSize ();
+                }
             }
         }
       beginOfCurrentPacket -= item->m_packet->GetSize ();
     }
+  m_lostUpTo = lostUpTo;
 
   if (sacked >= m_dupAckThresh)
     {
@@ -918,6 +991,10 @@ TcpTxBuffer::UpdateLostCount ()
         {
           item->m_lost = true;
           m_lostOut += item->m_packet->GetSize ();
+          if (m_highestLost < item->m_startSeq + item->m_packet->GetSize ())
+            {
+              m_highestLost = item->m_startSeq + item->m_packet->GetSize ();
+            }
         }
     }
   NS_LOG_INFO ("Status after the update: " << *this);
@@ -929,32 +1006,38 @@ TcpTxBuffer::IsLost (const SequenceNumber32 &seq) const
 {
   NS_LOG_FUNCTION (this << seq);
 
-  SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-  PacketList::const_iterator it;
-
   if (seq >= m_highestSack.second)
     {
       return false;
     }
 
-  // In theory, using a map and hints when inserting elements can improve
-  // performance
-  for (it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  // Start from the first item that begins at or after seq
+  auto index = m_sentIndex.lower_bound (seq);
+  if (index == m_sentIndex.end ())
+    {
+      return false;
+    }
+  SequenceNumber32 beginOfCurrentPacket = index->first;
+  PacketList::const_iterator it;
+
+  for (it = index->second; it != m_sentList.end (); ++it)
     {
-      // Search for the right iterator before calling IsLost()
-      if (beginOfCurrentPacket >= seq)
+      if (beginOfCurrentPacket >= m_highestLost)
         {
-          if ((*it)->m_lost == true)
-            {
-              NS_LOG_INFO ("seq=" << seq << " is lost because of lost flag");
-              return true;
-            }
+          // No item is lost from here on
+          return false;
+        }
 
-          if ((*it)->m_sacked == true)
-            {
-              NS_LOG_INFO ("seq=" << seq << " is not lost because of sacked flag");
-              return false;
-            }
+      if ((*it)->m_lost == true)
+        {
+          NS_LOG_INFO ("seq=" << seq << " is lost because of lost flag");
+          return true;
+        }
+
+      if ((*it)->m_sacked == true)
+        {
+          NS_LOG_INFO ("seq=" << seq << " is not lost because of sacked flag");
+          return false;
         }
 
       beginOfCurrentPacket += (*it)->m_packet->GetSize ();
@@ -981,19 +1064,49 @@ TcpTxBuffer::NextSeg (SequenceNumber32 *seq, SequenceNumber32 *seqHigh, bool isR
    *
    *     (1.c) IsLost (S2) returns true.
    */
-  PacketList::const_iterator it;
+  PacketList::const_iterator it = m_sentList.begin ();
   TcpTxItem *item;
   SequenceNumber32 seqPerRule3;
   bool isSeqPerRule3Valid = false;
+  bool isCandidateSeen = false;
   SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
 
-  for (it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  // The items before m_nextSegFrom are sacked or retransmitted
+  if (m_nextSegFrom > m_firstByteSeq)
+    {
+      auto index = m_sentIndex.lower_bound (m_nextSegFrom);
+      if (index == m_sentIndex.end ())
+        {
+          it = m_sentList.end ();
+          beginOfCurrentPkt = m_firstByteSeq + m_sentSize;
+        }
+      else
+        {
+          it = index->second;
+          beginOfCurrentPkt = index->first;
+        }
+    }
+
+  for (; it != m_sentList.end (); ++it)
     {
       item = *it;
 
+      if (beginOfCurrentPkt >= m_highestLost
+          && (!isRecovery || (isSeqPerRule3Valid && seqPerRule3.GetValue () != 0)))
+        {
+          // No item is lost from here on, and rule 3 has found its sequence
+          break;
+        }
+
       // Condition 1.a , 1.b , and 1.c
       if (item->m_retrans == false && item->m_sacked == false)
         {
+          if (!isCandidateSeen)
+            {
+              isCandidateSeen = true;
+              m_nextSegFrom = beginOfCurrentPkt;
+            }
+
           if (item->m_lost)
             {
               NS_LOG_INFO("IsLost, returning" << beginOfCurrentPkt);
@@ -1013,6 +1126,11 @@ TcpTxBuffer::NextSeg (SequenceNumber32 *seq, SequenceNumber32 *seqHigh, bool isR
       beginOfCurrentPkt += item->m_packet->GetSize ();
     }
 
+  if (!isCandidateSeen)
+    {
+      m_nextSegFrom = beginOfCurrentPkt;
+    }
+
   /* (2) If no sequence number 'S2' per rule (1) exists but there
    *     exists available unsent data and the receiver's advertised
    *     window allows, the sequence range of one segment of up to SMSS
@@ -1224,6 +1342,7 @@ TcpTxBuffer::ResetRenoSack ()
     }
 
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  m_lostUpTo = m_nextSegFrom = m_firstByteSeq;
 }
 
 void
@@ -1248,11 +1367,13 @@ TcpTxBuffer::ResetSentList ()
       m_sentList.pop_back ();
     }
 
+  m_sentIndex.clear ();
   m_sentSize = 0;
   m_lostOut = 0;
   m_retrans = 0;
   m_sackedOut = 0;
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  m_lostUpTo = m_highestLost = m_nextSegFrom = m_firstByteSeq;
 }
 
 void
@@ -1264,12 +1385,15 @@ TcpTxBuffer::ResetLastSegmentSent ()
       TcpTxItem *item = m_sentList.back ();
 
       m_sentList.pop_back ();
+      m_sentIndex.erase (item->m_startSeq);
       m_sentSize -= item->m_packet->GetSize ();
       if (item->m_retrans)
         {
           m_retrans -= item->m_packet->GetSize ();
         }
       m_appList.insert (m_appList.begin (), item);
+      m_lostUpTo = std::min (m_lostUpTo, item->m_startSeq);
+      m_nextSegFrom = std::min (m_nextSegFrom, item->m_startSeq);
     }
   ConsistencyCheck ();
 }
@@ -1316,6 +1440,9 @@ TcpTxBuffer::SetSentListLost (bool resetSack)
       (*it)->m_retrans = false;
     }
 
+  m_highestLost = m_firstByteSeq + m_sentSize;
+  m_nextSegFrom = m_firstByteSeq;
+
   NS_LOG_INFO ("Set sent list lost, status: " << *this);
   NS_ASSERT_MSG (m_sentSize >= m_sackedOut + m_lostOut, *this);
   ConsistencyCheck ();
@@ -1348,6 +1475,7 @@ TcpTxBuffer::DeleteRetransmittedFlagFromHead ()
     {
       m_sentList.front ()->m_retrans = false;
       m_retrans -= m_sentList.front ()->m_packet->GetSize ();
+      m_nextSegFrom = m_firstByteSeq;
     }
   ConsistencyCheck ();
 }
@@ -1377,6 +1505,10 @@ TcpTxBuffer::MarkHeadAsLost ()
           m_sentList.front()->m_lost = true;
           m_lostOut += m_sentList.front ()->m_packet->GetSize ();
         }
+
+      m_highestLost = std::max (m_highestLost, m_sentList.front ()->m_startSeq
+                                + m_sentList.front ()->m_packet->GetSize ());
+      m_nextSegFrom = m_firstByteSeq;
     }
   ConsistencyCheck ();
 }
@@ -1437,8 +1569,22 @@ TcpTxBuffer::ConsistencyCheck () const
   uint32_t lost = 0;
   uint32_t retrans = 0;
 
+  NS_ASSERT_MSG (m_sentIndex.size () == m_sentList.size (), "Indexed items: " <<
+                 m_sentIndex.size () << " sent items: " << m_sentList.size ());
+
   for (auto it = m_sentList.begin (); it != m_sentList.end (); ++it)
     {
+      const TcpTxItem *item = *it;
+      [[maybe_unused]] auto index = m_sentIndex.find (item->m_startSeq);
+      NS_ASSERT_MSG (index != m_sentIndex.end () && index->second == it,
+                     "Item " << *item << " is not indexed");
+      NS_ASSERT_MSG (item->m_startSeq >= m_lostUpTo || item->m_lost || item->m_sacked,
+                     "Item " << *item << " is below the lost mark " << m_lostUpTo);
+      NS_ASSERT_MSG (item->m_startSeq >= m_nextSegFrom || item->m_retrans || item->m_sacked,
+                     "Item " << *item << " is below the NextSeg mark " << m_nextSegFrom);
+      NS_ASSERT_MSG (!item->m_lost || item->m_startSeq + item->m_packet->GetSize () <= m_highestLost,
+                     "Item " << *item << " is above the highest lost " << m_highestLost);
+
       if ((*it)->m_sacked)
         {
           sacked += (*it)->m_packet->GetSize ();
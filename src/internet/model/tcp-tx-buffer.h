@@ -22,6 +22,7 @@
 #ifndef TCP_TX_BUFFER_H
 #define TCP_TX_BUFFER_H
 
+#include <map>
 #include "ns3/object.h"
 #include "ns3/traced-value.h"
 #include "ns3/sequence-number.h"
@@ -73,6 +74,16 @@ class Packet;
  * documentation) and maintaining the scoreboard is a matter of travelling the
  * list and set the SACK flag on the corresponding segment sent.
  *
+ * Since the sent list can hold a whole high-BDP window, it is indexed by the
+ * starting sequence number of its items, so that the scoreboard update and
+ * the other per-ACK queries start from the items they concern instead of
+ * walking the list from SND.UNA. Three conservative marks also bound the
+ * walks that remain: every item starting before m_lostUpTo is lost or
+ * sacked, every item starting before m_nextSegFrom is sacked or
+ * retransmitted (so it cannot be returned by NextSeg), and no item starting
+ * at or after m_highestLost is lost. The operations that clear these flags
+ * move the marks back.
+ *
  * Item properties
  * ---------------
  *
@@ -411,6 +422,7 @@ private:
   friend std::ostream & operator<< (std::ostream & os, TcpTxBuffer const & tcpTxBuf);
 
   typedef std::list<TcpTxItem*> PacketList; //!< container for data stored in the buffer
+  typedef std::map<SequenceNumber32, PacketList::iterator> PacketIndex; //!< index of the sent items by starting sequence
 
   /**
    * \brief Update the lost count
@@ -602,6 +614,7 @@ private:
 
   PacketList m_appList;  //!< Buffer for application data
   PacketList m_sentList; //!< Buffer for sent (but not acked) data
+  PacketIndex m_sentIndex; //!< Items of m_sentList by starting sequence
   uint32_t m_maxBuffer;  //!< Max number of data bytes in buffer (SND.WND)
   uint32_t m_size;       //!< Size of all data in this buffer
   uint32_t m_sentSize;   //!< Size of sent (and not discarded) segments
@@ -614,6 +627,10 @@ private:
   uint32_t m_sackedOut {0}; //!< Number of sacked bytes
   uint32_t m_retrans   {0}; //!< Number of retransmitted bytes
 
+  SequenceNumber32 m_lostUpTo;                //!< Items starting before it are lost or sacked
+  SequenceNumber32 m_highestLost;             //!< Items starting from it are not lost
+  mutable SequenceNumber32 m_nextSegFrom;     //!< Items starting before it are sacked or retransmitted
+
   uint32_t m_dupAckThresh {0}; //!< Duplicate Ack threshold from TcpSocketBase
   uint32_t m_segmentSize {0}; //!< Segment size from TcpSocketBase
   bool     m_renoSack {false}; //!< Indicates if AddRenoSack was called
@@ -0,0 +1,590 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv4-interface-address.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-net-device.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+/*
+ * The reference functions below are the linear scans the demultiplexers
+ * used before they indexed their end points.  They are run on the end
+ * points of the demux, in allocation order.
+ */
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Reference Ipv4EndPointDemux::LookupPortLocal
+ * \param endPoints the end points
+ * \param port the port
+ * \return true if an end point has this local port
+ */
+static bool
+RefLookupPortLocal (const Ipv4EndPointDemux::EndPoints &endPoints, uint16_t port)
+{
+  for (Ipv4EndPoint *endP : endPoints)
+    {
+      if (endP->GetLocalPort () == port)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Reference Ipv4EndPointDemux::LookupLocal
+ * \param endPoints the end points
+ * \param device the bound device
+ * \param addr the local address
+ * \param port the local port
+ * \return true if there is a match
+ */
+static bool
+RefLookupLocal (const Ipv4EndPointDemux::EndPoints &endPoints, Ptr<NetDevice> device,
+                Ipv4Address addr, uint16_t port)
+{
+  for (Ipv4EndPoint *endP : endPoints)
+    {
+      if (endP->GetLocalPort () == port
+          && endP->GetLocalAddress () == addr
+          && endP->GetBoundNetDevice () == device)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Reference Ipv4EndPointDemux::Lookup
+ * \param endPoints the end points
+ * \param daddr destination address
+ * \param dport destination port
+ * \param saddr source address
+ * \param sport source port
+ * \param incomingInterface the incoming interface
+ * \return the most exact matches
+ */
+static Ipv4EndPointDemux::EndPoints
+RefLookup (const Ipv4EndPointDemux::EndPoints &endPoints, Ipv4Address daddr, uint16_t dport,
+           Ipv4Address saddr, uint16_t sport, Ptr<Ipv4Interface> incomingInterface)
+{
+  Ipv4EndPointDemux::EndPoints retval[4];
+  for (Ipv4EndPoint *endP : endPoints)
+    {
+      if (!endP->IsRxEnabled () || endP->GetLocalPort () != dport)
+        {
+          continue;
+        }
+      if (endP->GetBoundNetDevice () && endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+        {
+          continue;
+        }
+      bool localExact = endP->GetLocalAddress () == daddr;
+      bool localWildCard = false;
+      if (!localExact)
+        {
+          localWildCard = endP->GetLocalAddress () == Ipv4Address::GetAny ();
+          for (uint32_t i = 0; !localWildCard && i < incomingInterface->GetNAddresses (); i++)
+            {
+              Ipv4InterfaceAddress addr = incomingInterface->GetAddress (i);
+              Ipv4Address net = addr.GetLocal ().CombineMask (addr.GetMask ());
+              localWildCard = endP->GetLocalAddress () == net && daddr.CombineMask (addr.GetMask ()) == net;
+            }
+          if (!localWildCard)
+            {
+              continue;
+            }
+        }
+      bool peerExact = endP->GetPeerPort () == sport && endP->GetPeerAddress () == saddr;
+      bool peerWildCard = endP->GetPeerPort () == 0 && endP->GetPeerAddress () == Ipv4Address::GetAny ();
+      if (localExact && peerExact)
+        {
+          retval[3].push_back (endP);
+        }
+      if (localWildCard && peerExact)
+        {
+          retval[2].push_back (endP);
+        }
+      if (localExact && peerWildCard)
+        {
+          retval[1].push_back (endP);
+        }
+      if (localWildCard && peerWildCard)
+        {
+          retval[0].push_back (endP);
+        }
+    }
+  for (int i = 3; i > 0; i--)
+    {
+      if (!retval[i].empty ())
+        {
+          return retval[i];
+        }
+    }
+  return retval[0];
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Reference Ipv4EndPointDemux::SimpleLookup
+ * \param endPoints the end points
+ * \param daddr destination address
+ * \param dport destination port
+ * \param saddr source address
+ * \param sport source port
+ * \return the exact match or the least generic one
+ */
+static Ipv4EndPoint *
+RefSimpleLookup (const Ipv4EndPointDemux::EndPoints &endPoints, Ipv4Address daddr, uint16_t dport,
+                 Ipv4Address saddr, uint16_t sport)
+{
+  uint32_t genericity = 3;
+  Ipv4EndPoint *generic = 0;
+  for (Ipv4EndPoint *endP : endPoints)
+    {
+      if (endP->GetLocalPort () != dport)
+        {
+          continue;
+        }
+      if (endP->GetLocalAddress () == daddr && endP->GetPeerPort () == sport
+          && endP->GetPeerAddress () == saddr)
+        {
+          return endP;
+        }
+      uint32_t tmp = (endP->GetLocalAddress () == Ipv4Address::GetAny ())
+        + (endP->GetPeerAddress () == Ipv4Address::GetAny ());
+      if (tmp < genericity)
+        {
+          generic = endP;
+          genericity = tmp;
+        }
+    }
+  return generic;
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Reference IPv6 lookups, as above.
+ * \param endPoints the end points
+ * \param daddr destination address
+ * \param dport destination port
+ * \param saddr source address
+ * \param sport source port
+ * \param incomingInterface the incoming interface
+ * \return the most exact matches
+ */
+static Ipv6EndPointDemux::EndPoints
+RefLookup (const Ipv6EndPointDemux::EndPoints &endPoints, Ipv6Address daddr, uint16_t dport,
+           Ipv6Address saddr, uint16_t sport, Ptr<Ipv6Interface> incomingInterface)
+{
+  Ipv6EndPointDemux::EndPoints retval[4];
+  for (Ipv6EndPoint *endP : endPoints)
+    {
+      if (!endP->IsRxEnabled () || endP->GetLocalPort () != dport)
+        {
+          continue;
+        }
+      if (endP->GetBoundNetDevice ()
+          && (!incomingInterface || endP->GetBoundNetDevice () != incomingInterface->GetDevice ()))
+        {
+          continue;
+        }
+      bool localWildCard = endP->GetLocalAddress () == Ipv6Address::GetAny ();
+      bool localExact = endP->GetLocalAddress () == daddr;
+      bool localAllRouters = endP->GetLocalAddress () == Ipv6Address::GetAllRoutersMulticast ();
+      if (!(localExact || localWildCard))
+        {
+          continue;
+        }
+      bool portExact = endP->GetPeerPort () == sport;
+      bool portWildCard = endP->GetPeerPort () == 0;
+      bool addrExact = endP->GetPeerAddress () == saddr;
+      bool addrWildCard = endP->GetPeerAddress () == Ipv6Address::GetAny ();
+      if (!(portExact || portWildCard) || !(addrExact || addrWildCard))
+        {
+          continue;
+        }
+      if (localWildCard && portWildCard && addrWildCard)
+        {
+          retval[0].push_back (endP);
+        }
+      if ((localExact || localAllRouters) && portWildCard && addrWildCard)
+        {
+          retval[1].push_back (endP);
+        }
+      if (localWildCard && portExact && addrExact)
+        {
+          retval[2].push_back (endP);
+        }
+      if (localExact && portExact && addrExact)
+        {
+          retval[3].push_back (endP);
+        }
+    }
+  for (int i = 3; i > 0; i--)
+    {
+      if (!retval[i].empty ())
+        {
+          return retval[i];
+        }
+    }
+  return retval[0];
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Ipv4EndPointDemux against the linear scans, on random end points
+ */
+class Ipv4EndPointDemuxTestCase : public TestCase
+{
+public:
+  Ipv4EndPointDemuxTestCase ();
+  virtual void DoRun (void);
+};
+
+Ipv4EndPointDemuxTestCase::Ipv4EndPointDemuxTestCase ()
+  : TestCase ("Ipv4EndPointDemux lookups match the linear scans")
+{
+}
+
+void
+Ipv4EndPointDemuxTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+
+  Ptr<SimpleNetDevice> dev1 = CreateObject<SimpleNetDevice> ();
+  Ptr<SimpleNetDevice> dev2 = CreateObject<SimpleNetDevice> ();
+  Ptr<Ipv4Interface> incoming = CreateObject<Ipv4Interface> ();
+  incoming->SetDevice (dev1);
+  incoming->AddAddress (Ipv4InterfaceAddress (Ipv4Address ("10.0.0.1"), Ipv4Mask ("255.255.255.0")));
+
+  std::vector<Ptr<NetDevice> > devices = {0, dev1, dev2};
+  std::vector<Ipv4Address> locals = {Ipv4Address::GetAny (), Ipv4Address ("10.0.0.1"),
+                                     Ipv4Address ("10.0.0.2"), Ipv4Address ("10.0.0.0"),
+                                     Ipv4Address ("10.0.1.1")};
+  std::vector<Ipv4Address> destinations = {Ipv4Address ("10.0.0.1"), Ipv4Address ("10.0.0.2"),
+                                           Ipv4Address ("10.0.0.255"), Ipv4Address ("10.0.1.1")};
+  std::vector<std::pair<Ipv4Address, uint16_t> > peers = {{Ipv4Address::GetAny (), 0},
+                                                          {Ipv4Address ("10.0.0.5"), 1000},
+                                                          {Ipv4Address ("10.0.0.6"), 1001},
+                                                          {Ipv4Address ("10.0.0.5"), 0},
+                                                          {Ipv4Address::GetAny (), 1000}};
+  std::vector<uint16_t> ports = {80, 81, 49153};
+
+  Ipv4EndPointDemux demux;
+  std::vector<Ipv4EndPoint *> endPoints;
+  uint16_t lastEphemeral = 49152;
+
+  for (uint32_t step = 0; step < 3000; step++)
+    {
+      Ptr<NetDevice> device = devices[rng->GetInteger (0, devices.size () - 1)];
+      Ipv4Address local = locals[rng->GetInteger (0, locals.size () - 1)];
+      uint16_t port = ports[rng->GetInteger (0, ports.size () - 1)];
+      std::pair<Ipv4Address, uint16_t> peer = peers[rng->GetInteger (0, peers.size () - 1)];
+      Ipv4EndPointDemux::EndPoints all = demux.GetAllEndPoints ();
+      Ipv4EndPoint *endPoint = 0;
+      switch (rng->GetInteger (0, endPoints.empty () ? 2 : 6))
+        {
+        case 0:
+          {
+            bool duplicate = RefLookupLocal (all, device, local, port) || RefLookupLocal (all, 0, local, port);
+            endPoint = demux.Allocate (device, local, port);
+            NS_TEST_ASSERT_MSG_EQ ((endPoint == 0), duplicate, "Wrong duplicate check");
+            break;
+          }
+        case 1:
+          endPoint = demux.Allocate (device, local, port, peer.first, peer.second);
+          break;
+        case 2:
+          {
+            uint16_t expected = lastEphemeral;
+            do
+              {
+                expected = expected == 65535 ? 49152 : expected + 1;
+              }
+            while (RefLookupPortLocal (all, expected));
+            endPoint = demux.Allocate (local);
+            NS_TEST_ASSERT_MSG_NE (endPoint, 0, "Ephemeral allocation failed");
+            NS_TEST_ASSERT_MSG_EQ (endPoint->GetLocalPort (), expected, "Wrong ephemeral port");
+            lastEphemeral = expected;
+            break;
+          }
+        case 3:
+          {
+            uint32_t i = rng->GetInteger (0, endPoints.size () - 1);
+            demux.DeAllocate (endPoints[i]);
+            endPoints.erase (endPoints.begin () + i);
+            break;
+          }
+        case 4:
+          endPoints[rng->GetInteger (0, endPoints.size () - 1)]->SetPeer (peer.first, peer.second);
+          break;
+        case 5:
+          endPoints[rng->GetInteger (0, endPoints.size () - 1)]->SetRxEnabled (rng->GetInteger (0, 3) != 0);
+          break;
+        case 6:
+          endPoints[rng->GetInteger (0, endPoints.size () - 1)]->SetLocalAddress (local);
+          break;
+        }
+      if (endPoint != 0)
+        {
+          if (device != 0)
+            {
+              endPoint->BindToNetDevice (device);
+            }
+          endPoints.push_back (endPoint);
+        }
+
+      all = demux.GetAllEndPoints ();
+      NS_TEST_ASSERT_MSG_EQ (all.size (), endPoints.size (), "Wrong number of end points");
+      for (uint32_t query = 0; query < 10; query++)
+        {
+          Ipv4Address daddr = destinations[rng->GetInteger (0, destinations.size () - 1)];
+          uint16_t dport = ports[rng->GetInteger (0, ports.size () - 1)];
+          std::pair<Ipv4Address, uint16_t> source = peers[rng->GetInteger (0, peers.size () - 1)];
+          NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (dport), RefLookupPortLocal (all, dport),
+                                 "Wrong LookupPortLocal for port " << dport);
+          NS_TEST_ASSERT_MSG_EQ (demux.LookupLocal (device, daddr, dport), RefLookupLocal (all, device, daddr, dport),
+                                 "Wrong LookupLocal for " << daddr << ":" << dport);
+          NS_TEST_ASSERT_MSG_EQ (demux.SimpleLookup (daddr, dport, source.first, source.second),
+                                 RefSimpleLookup (all, daddr, dport, source.first, source.second),
+                                 "Wrong SimpleLookup for " << daddr << ":" << dport);
+          Ipv4EndPointDemux::EndPoints expected = RefLookup (all, daddr, dport, source.first, source.second, incoming);
+          if (expected.size () > 1)
+            {
+              // Lookup aborts on ambiguous end points
+              continue;
+            }
+          Ipv4EndPointDemux::EndPoints found = demux.Lookup (daddr, dport, source.first, source.second, incoming);
+          NS_TEST_ASSERT_MSG_EQ ((found == expected), true,
+                                 "Wrong Lookup for " << daddr << ":" << dport << " from "
+                                                     << source.first << ":" << source.second);
+        }
+    }
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Ipv4EndPointDemux ephemeral port exhaustion
+ */
+class Ipv4EndPointDemuxEphemeralTestCase : public TestCase
+{
+public:
+  Ipv4EndPointDemuxEphemeralTestCase ();
+  virtual void DoRun (void);
+};
+
+Ipv4EndPointDemuxEphemeralTestCase::Ipv4EndPointDemuxEphemeralTestCase ()
+  : TestCase ("Ipv4EndPointDemux ephemeral port allocation wraps around and runs out")
+{
+}
+
+void
+Ipv4EndPointDemuxEphemeralTestCase::DoRun (void)
+{
+  Ipv4EndPointDemux demux;
+  // A port in use outside of the ephemeral range does not matter
+  demux.Allocate (0, Ipv4Address::GetAny (), 80);
+  // A bound port in the range is skipped
+  Ipv4EndPoint *bound = demux.Allocate (0, Ipv4Address::GetAny (), 49200);
+
+  std::vector<Ipv4EndPoint *> endPoints;
+  for (uint32_t port = 49153; port <= 65535; port++)
+    {
+      if (port == 49200)
+        {
+          continue;
+        }
+      Ipv4EndPoint *endPoint = demux.Allocate ();
+      NS_TEST_ASSERT_MSG_NE (endPoint, 0, "Ephemeral allocation failed");
+      NS_TEST_ASSERT_MSG_EQ (endPoint->GetLocalPort (), port, "Wrong ephemeral port");
+      endPoints.push_back (endPoint);
+    }
+  // Wraps around to the first port
+  Ipv4EndPoint *first = demux.Allocate ();
+  NS_TEST_ASSERT_MSG_NE (first, 0, "Ephemeral allocation failed");
+  NS_TEST_ASSERT_MSG_EQ (first->GetLocalPort (), 49152, "Wrong ephemeral port");
+  NS_TEST_ASSERT_MSG_EQ (demux.Allocate (), 0, "Allocation should fail when all the ports are in use");
+
+  demux.DeAllocate (endPoints[1000]);
+  demux.DeAllocate (bound);
+  // The search starts after the last allocated port (49152)
+  Ipv4EndPoint *endPoint = demux.Allocate ();
+  NS_TEST_ASSERT_MSG_NE (endPoint, 0, "Ephemeral allocation failed");
+  NS_TEST_ASSERT_MSG_EQ (endPoint->GetLocalPort (), 49200, "Wrong ephemeral port");
+  endPoint = demux.Allocate ();
+  NS_TEST_ASSERT_MSG_NE (endPoint, 0, "Ephemeral allocation failed");
+  NS_TEST_ASSERT_MSG_EQ (endPoint->GetLocalPort (), 50154, "Wrong ephemeral port");
+  NS_TEST_ASSERT_MSG_EQ (demux.Allocate (), 0, "Allocation should fail when all the ports are in use");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Ipv6EndPointDemux against the linear scans, on random end points
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+public:
+  Ipv6EndPointDemuxTestCase ();
+  virtual void DoRun (void);
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase ()
+  : TestCase ("Ipv6EndPointDemux lookups match the linear scans")
+{
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (2);
+
+  Ptr<SimpleNetDevice> dev1 = CreateObject<SimpleNetDevice> ();
+  Ptr<SimpleNetDevice> dev2 = CreateObject<SimpleNetDevice> ();
+  Ptr<Ipv6Interface> incoming = CreateObject<Ipv6Interface> ();
+  incoming->SetDevice (dev1);
+
+  std::vector<Ptr<NetDevice> > devices = {0, dev1, dev2};
+  std::vector<Ipv6Address> locals = {Ipv6Address::GetAny (), Ipv6Address ("2001:1::1"),
+                                     Ipv6Address ("2001:1::2"), Ipv6Address::GetAllRoutersMulticast ()};
+  std::vector<std::pair<Ipv6Address, uint16_t> > peers = {{Ipv6Address::GetAny (), 0},
+                                                          {Ipv6Address ("2001:2::5"), 1000},
+                                                          {Ipv6Address ("2001:2::6"), 1001},
+                                                          {Ipv6Address ("2001:2::5"), 0},
+                                                          {Ipv6Address::GetAny (), 1000}};
+  std::vector<uint16_t> ports = {80, 81, 49153};
+
+  Ipv6EndPointDemux demux;
+  std::vector<Ipv6EndPoint *> endPoints;
+
+  for (uint32_t step = 0; step < 3000; step++)
+    {
+      Ptr<NetDevice> device = devices[rng->GetInteger (0, devices.size () - 1)];
+      Ipv6Address local = locals[rng->GetInteger (0, locals.size () - 1)];
+      uint16_t port = ports[rng->GetInteger (0, ports.size () - 1)];
+      std::pair<Ipv6Address, uint16_t> peer = peers[rng->GetInteger (0, peers.size () - 1)];
+      Ipv6EndPoint *endPoint = 0;
+      switch (rng->GetInteger (0, endPoints.empty () ? 2 : 5))
+        {
+        case 0:
+          endPoint = demux.Allocate (device, local, port);
+          break;
+        case 1:
+          endPoint = demux.Allocate (device, local, port, peer.first, peer.second);
+          break;
+        case 2:
+          endPoint = demux.Allocate (local);
+          break;
+        case 3:
+          {
+            uint32_t i = rng->GetInteger (0, endPoints.size () - 1);
+            demux.DeAllocate (endPoints[i]);
+            endPoints.erase (endPoints.begin () + i);
+            break;
+          }
+        case 4:
+          endPoints[rng->GetInteger (0, endPoints.size () - 1)]->SetPeer (peer.first, peer.second);
+          break;
+        case 5:
+          endPoints[rng->GetInteger (0, endPoints.size () - 1)]->SetRxEnabled (rng->GetInteger (0, 3) != 0);
+          break;
+        }
+      if (endPoint != 0)
+        {
+          if (device != 0)
+            {
+              endPoint->BindToNetDevice (device);
+            }
+          endPoints.push_back (endPoint);
+        }
+
+      Ipv6EndPointDemux::EndPoints all = demux.GetEndPoints ();
+      NS_TEST_ASSERT_MSG_EQ (all.size (), endPoints.size (), "Wrong number of end points");
+      for (uint32_t query = 0; query < 10; query++)
+        {
+          Ipv6Address daddr = locals[rng->GetInteger (1, locals.size () - 1)];
+          uint16_t dport = ports[rng->GetInteger (0, ports.size () - 1)];
+          std::pair<Ipv6Address, uint16_t> source = peers[rng->GetInteger (0, peers.size () - 1)];
+          Ptr<Ipv6Interface> interface = rng->GetInteger (0, 3) == 0 ? 0 : incoming;
+          bool inUse = std::any_of (all.begin (), all.end (),
+                                    [dport] (Ipv6EndPoint *endP) { return endP->GetLocalPort () == dport; });
+          NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (dport), inUse, "Wrong LookupPortLocal for port " << dport);
+          Ipv6EndPointDemux::EndPoints expected = RefLookup (all, daddr, dport, source.first, source.second, interface);
+          if (expected.size () > 1)
+            {
+              // Lookup aborts on ambiguous end points
+              continue;
+            }
+          Ipv6EndPointDemux::EndPoints found = demux.Lookup (daddr, dport, source.first, source.second, interface);
+          NS_TEST_ASSERT_MSG_EQ ((found == expected), true,
+                                 "Wrong Lookup for " << daddr << ":" << dport << " from "
+                                                     << source.first << ":" << source.second);
+        }
+    }
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief End point demultiplexers TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+public:
+  EndPointDemuxTestSuite ()
+    : TestSuite ("end-point-demux", UNIT)
+  {
+    AddTestCase (new Ipv4EndPointDemuxTestCase (), TestCase::QUICK);
+    AddTestCase (new Ipv4EndPointDemuxEphemeralTestCase (), TestCase::QUICK);
+    AddTestCase (new Ipv6EndPointDemuxTestCase (), TestCase::QUICK);
+  }
+};
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
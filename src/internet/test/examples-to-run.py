@@ -9,6 +9,8 @@
 # See test.py for more information.
 cpp_examples = [
     ("main-simple", "True", "True"),
+    ("fib-lookup-benchmark --routes=1000 --lookups=10000 --linearLookups=100", "True", "False"),
+    ("end-point-demux-benchmark --connections=1000 --lookups=10000 --linearLookups=100", "True", "False"),
 ]
 
 # A list of Python examples to run in order to ensure that they remain
@@ -14,6 +14,9 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <algorithm>
+#include <map>
+#include <sstream>
 #include <vector>
 #include "ns3/boolean.h"
 #include "ns3/config.h"
@@ -1244,6 +1247,451 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting parallel and incremental SPF test
+ *
+ * The routing tables computed with several threads, and updated
+ * incrementally after changes of the topology, must be the same as the
+ * routing tables computed from scratch by a single thread, with their
+ * routes in the same order.
+ */
+class Ipv4GlobalRoutingSpfTestCase : public TestCase
+{
+public:
+  Ipv4GlobalRoutingSpfTestCase ();
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+
+protected:
+  /**
+   * Constructor of the derived test cases on the same topology.
+   * \param name the name of the test case
+   */
+  Ipv4GlobalRoutingSpfTestCase (std::string name);
+
+  /**
+   * \brief Get the routes of all the nodes, in the order of their tables.
+   * \return the routes of each node
+   */
+  std::vector<std::vector<std::string> > GetRoutes (void);
+  /**
+   * \brief Recompute the routes and compare them with the routes
+   * recomputed from scratch by a single thread.
+   * \param threads the number of SPF threads
+   * \param incremental whether to update the routes incrementally
+   * \param step description of the change of the topology
+   */
+  void CheckRoutes (uint32_t threads, bool incremental, std::string step);
+  /**
+   * \brief Add an interface, not connected to any other node, to a node
+   * \param node the index of the node
+   * \param address the address of the interface
+   * \param mask the mask of the interface
+   * \return the index of the interface
+   */
+  uint32_t AddStubInterface (uint32_t node, Ipv4Address address, Ipv4Mask mask);
+
+  NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+Ipv4GlobalRoutingSpfTestCase::Ipv4GlobalRoutingSpfTestCase ()
+  : TestCase ("Global routing with parallel and incremental SPF calculations")
+{
+}
+
+Ipv4GlobalRoutingSpfTestCase::Ipv4GlobalRoutingSpfTestCase (std::string name)
+  : TestCase (name)
+{
+}
+
+void
+Ipv4GlobalRoutingSpfTestCase::DoSetup ()
+{
+  // A 4x4 grid of point-to-point links, a LAN between nodes 0, 5 and 10,
+  // and a stub node 16 attached to node 15
+  const uint32_t side = 4;
+  m_nodes.Create (side * side + 1);
+
+  SimpleNetDeviceHelper p2pHelper;
+  p2pHelper.SetNetDevicePointToPointMode (true);
+  InternetStackHelper internet;
+  Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+  internet.SetRoutingHelper (ipv4RoutingHelper);
+  internet.Install (m_nodes);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.0.0", "255.255.255.252");
+  for (uint32_t i = 0; i < side * side; i++)
+    {
+      std::vector<uint32_t> neighbors;
+      if (i % side + 1 < side)
+        {
+          neighbors.push_back (i + 1);
+        }
+      if (i + side < side * side)
+        {
+          neighbors.push_back (i + side);
+        }
+      for (uint32_t j = 0; j < neighbors.size (); j++)
+        {
+          Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+          NetDeviceContainer link = p2pHelper.Install (m_nodes.Get (i), channel);
+          link.Add (p2pHelper.Install (m_nodes.Get (neighbors[j]), channel));
+          ipv4.Assign (link);
+          ipv4.NewNetwork ();
+        }
+    }
+  Ptr<SimpleChannel> stubChannel = CreateObject<SimpleChannel> ();
+  NetDeviceContainer stub = p2pHelper.Install (m_nodes.Get (side * side - 1), stubChannel);
+  stub.Add (p2pHelper.Install (m_nodes.Get (side * side), stubChannel));
+  ipv4.Assign (stub);
+
+  SimpleNetDeviceHelper lanHelper;
+  Ptr<SimpleChannel> lanChannel = CreateObject<SimpleChannel> ();
+  NetDeviceContainer lan;
+  lan.Add (lanHelper.Install (m_nodes.Get (0), lanChannel));
+  lan.Add (lanHelper.Install (m_nodes.Get (5), lanChannel));
+  lan.Add (lanHelper.Install (m_nodes.Get (10), lanChannel));
+  ipv4.SetBase ("10.2.0.0", "255.255.255.0");
+  ipv4.Assign (lan);
+}
+
+std::vector<std::vector<std::string> >
+Ipv4GlobalRoutingSpfTestCase::GetRoutes (void)
+{
+  std::vector<std::vector<std::string> > routes;
+  for (uint32_t i = 0; i < m_nodes.GetN (); i++)
+    {
+      Ptr<Ipv4GlobalRouting> routing = m_nodes.Get (i)->GetObject<Ipv4L3Protocol> ()
+        ->GetRoutingProtocol ()->GetObject<Ipv4GlobalRouting> ();
+      std::vector<std::string> nodeRoutes;
+      for (uint32_t j = 0; j < routing->GetNRoutes (); j++)
+        {
+          std::ostringstream oss;
+          oss << *routing->GetRoute (j);
+          nodeRoutes.push_back (oss.str ());
+        }
+      routes.push_back (nodeRoutes);
+    }
+  return routes;
+}
+
+void
+Ipv4GlobalRoutingSpfTestCase::CheckRoutes (uint32_t threads, bool incremental, std::string step)
+{
+  Config::SetGlobal ("GlobalRoutingSpfThreads", UintegerValue (threads));
+  Config::SetGlobal ("GlobalRoutingIncrementalSpf", BooleanValue (incremental));
+  Ipv4GlobalRoutingHelper::RecomputeRoutingTables ();
+  std::vector<std::vector<std::string> > routes = GetRoutes ();
+
+  Config::SetGlobal ("GlobalRoutingSpfThreads", UintegerValue (1));
+  Config::SetGlobal ("GlobalRoutingIncrementalSpf", BooleanValue (false));
+  Ipv4GlobalRoutingHelper::RecomputeRoutingTables ();
+  std::vector<std::vector<std::string> > expected = GetRoutes ();
+
+  for (uint32_t i = 0; i < m_nodes.GetN (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (routes[i].size (), expected[i].size (),
+                             step << ": wrong number of routes on node " << i);
+      for (uint32_t j = 0; j < std::min (routes[i].size (), expected[i].size ()); j++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (routes[i][j], expected[i][j],
+                                 step << ": wrong route " << j << " on node " << i);
+        }
+    }
+}
+
+uint32_t
+Ipv4GlobalRoutingSpfTestCase::AddStubInterface (uint32_t node, Ipv4Address address, Ipv4Mask mask)
+{
+  SimpleNetDeviceHelper helper;
+  NetDeviceContainer device = helper.Install (m_nodes.Get (node), CreateObject<SimpleChannel> ());
+  Ptr<Ipv4> ipv4 = m_nodes.Get (node)->GetObject<Ipv4> ();
+  uint32_t interface = ipv4->AddInterface (device.Get (0));
+  ipv4->AddAddress (interface, Ipv4InterfaceAddress (address, mask));
+  ipv4->SetUp (interface);
+  return interface;
+}
+
+void
+Ipv4GlobalRoutingSpfTestCase::DoRun ()
+{
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+  std::vector<std::vector<std::string> > routes = GetRoutes ();
+  for (uint32_t i = 0; i < m_nodes.GetN (); i++)
+    {
+      NS_TEST_EXPECT_MSG_GT (routes[i].size (), 0, "No route on node " << i);
+    }
+
+  CheckRoutes (4, false, "parallel");
+  CheckRoutes (1, true, "no change");
+
+  Ptr<Ipv4> ipv4 = m_nodes.Get (6)->GetObject<Ipv4> ();
+  ipv4->SetDown (1);
+  CheckRoutes (1, true, "link down");
+  CheckRoutes (4, true, "link down");
+  ipv4->SetUp (1);
+  CheckRoutes (1, true, "link up");
+
+  ipv4->SetMetric (2, 5);
+  CheckRoutes (4, true, "metric");
+
+  Ptr<Ipv4> lanIpv4 = m_nodes.Get (5)->GetObject<Ipv4> ();
+  uint32_t lanInterface = lanIpv4->GetNInterfaces () - 1;
+  lanIpv4->SetDown (lanInterface);
+  CheckRoutes (1, true, "LAN down");
+  lanIpv4->SetUp (lanInterface);
+  CheckRoutes (1, true, "LAN up");
+
+  Ptr<Ipv4> stubIpv4 = m_nodes.Get (15)->GetObject<Ipv4> ();
+  uint32_t stubInterface = stubIpv4->GetNInterfaces () - 1;
+  stubIpv4->SetDown (stubInterface);
+  CheckRoutes (1, true, "stub down");
+  stubIpv4->SetUp (stubInterface);
+  CheckRoutes (1, true, "stub up");
+
+  // The same network advertised by two routers, and a network including it
+  uint32_t duplicateInterface = AddStubInterface (3, Ipv4Address ("10.3.0.1"), Ipv4Mask ("/24"));
+  CheckRoutes (1, true, "stub network added");
+  AddStubInterface (12, Ipv4Address ("10.3.0.2"), Ipv4Mask ("/24"));
+  CheckRoutes (4, true, "duplicate stub network added");
+  AddStubInterface (9, Ipv4Address ("10.3.1.1"), Ipv4Mask ("/16"));
+  CheckRoutes (1, true, "overlapping stub network added");
+  m_nodes.Get (3)->GetObject<Ipv4> ()->SetDown (duplicateInterface);
+  CheckRoutes (1, true, "duplicate stub network removed");
+
+  Config::SetGlobal ("GlobalRoutingSpfThreads", UintegerValue (1));
+  Config::SetGlobal ("GlobalRoutingIncrementalSpf", BooleanValue (false));
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting test of a LAN reached through equal-cost paths
+ * which do not start at the same exit of the root.
+ */
+class EcmpLanTest : public TestCase
+{
+public:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+  EcmpLanTest ();
+private:
+  NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+EcmpLanTest::EcmpLanTest ()
+  : TestCase ("Global routing to a LAN reached through equal-cost paths")
+{
+}
+
+void
+EcmpLanTest::DoSetup ()
+{
+  // Node 0 is linked to nodes 1 and 2, which are on a LAN with node 3,
+  // itself linked to node 4
+  m_nodes.Create (5);
+
+  SimpleNetDeviceHelper p2pHelper;
+  p2pHelper.SetNetDevicePointToPointMode (true);
+  Ptr<SimpleChannel> channel01 = CreateObject <SimpleChannel> ();
+  NetDeviceContainer net01 = p2pHelper.Install (m_nodes.Get (0), channel01);
+  net01.Add (p2pHelper.Install (m_nodes.Get (1), channel01));
+  Ptr<SimpleChannel> channel02 = CreateObject <SimpleChannel> ();
+  NetDeviceContainer net02 = p2pHelper.Install (m_nodes.Get (0), channel02);
+  net02.Add (p2pHelper.Install (m_nodes.Get (2), channel02));
+  Ptr<SimpleChannel> channel34 = CreateObject <SimpleChannel> ();
+  NetDeviceContainer net34 = p2pHelper.Install (m_nodes.Get (3), channel34);
+  net34.Add (p2pHelper.Install (m_nodes.Get (4), channel34));
+
+  SimpleNetDeviceHelper lanHelper;
+  Ptr<SimpleChannel> lanChannel = CreateObject <SimpleChannel> ();
+  NetDeviceContainer lan = lanHelper.Install (m_nodes.Get (1), lanChannel);
+  lan.Add (lanHelper.Install (m_nodes.Get (2), lanChannel));
+  lan.Add (lanHelper.Install (m_nodes.Get (3), lanChannel));
+
+  InternetStackHelper internet;
+  Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+  internet.SetRoutingHelper (ipv4RoutingHelper);
+  internet.Install (m_nodes);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.252");
+  ipv4.Assign (net01);
+  ipv4.SetBase ("10.1.2.0", "255.255.255.252");
+  ipv4.Assign (net02);
+  ipv4.SetBase ("10.1.3.0", "255.255.255.252");
+  ipv4.Assign (net34);
+  ipv4.SetBase ("10.2.1.0", "255.255.255.0");
+  ipv4.Assign (lan);
+}
+
+void
+EcmpLanTest::DoRun ()
+{
+  // The LAN is reached from node 0 through nodes 1 and 2, and node 3
+  // through the LAN must inherit both exits
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  Ptr<Ipv4GlobalRouting> globalRouting0 = m_nodes.Get (0)->GetObject<Ipv4L3Protocol> ()
+    ->GetRoutingProtocol ()->GetObject <Ipv4GlobalRouting> ();
+  NS_TEST_ASSERT_MSG_NE (globalRouting0, 0, "Error-- no Ipv4GlobalRouting object");
+
+  std::vector<Ipv4Address> gateways;
+  for (uint32_t i = 0; i < globalRouting0->GetNRoutes (); i++)
+    {
+      Ipv4RoutingTableEntry* route = globalRouting0->GetRoute (i);
+      if (route->IsHost () && route->GetDest () == Ipv4Address ("10.1.3.1"))
+        {
+          gateways.push_back (route->GetGateway ());
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (gateways.size (), 2, "Error-- not two equal-cost routes to node 3");
+  NS_TEST_EXPECT_MSG_EQ (gateways[0], Ipv4Address ("10.1.1.2"), "Error-- wrong gateway");
+  NS_TEST_EXPECT_MSG_EQ (gateways[1], Ipv4Address ("10.1.2.2"), "Error-- wrong gateway");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Checks that the routes of the shared table of next hops, computed
+ * or mapped from the cache file, lead to the same paths as the routing
+ * tables of the routers.
+ */
+class Ipv4GlobalRoutingNextHopTableTestCase : public Ipv4GlobalRoutingSpfTestCase
+{
+public:
+  Ipv4GlobalRoutingNextHopTableTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Follow the routes from every node to every address of the
+   * interfaces up.
+   * \return the number of hops of each path, or -1 if the address is not reached
+   */
+  std::vector<int32_t> GetPaths (void);
+  /**
+   * \brief Recompute the routes in both modes and compare their paths.
+   * \param loaded whether the next hops must be loaded from the cache
+   * \param step description of the change of the topology
+   */
+  void CheckPaths (bool loaded, std::string step);
+};
+
+Ipv4GlobalRoutingNextHopTableTestCase::Ipv4GlobalRoutingNextHopTableTestCase ()
+  : Ipv4GlobalRoutingSpfTestCase ("Global routing with a shared table of next hops")
+{
+}
+
+std::vector<int32_t>
+Ipv4GlobalRoutingNextHopTableTestCase::GetPaths (void)
+{
+  std::map<Ipv4Address, uint32_t> owners;
+  for (uint32_t i = 0; i < m_nodes.GetN (); i++)
+    {
+      Ptr<Ipv4> ipv4 = m_nodes.Get (i)->GetObject<Ipv4> ();
+      for (uint32_t j = 1; j < ipv4->GetNInterfaces (); j++)
+        {
+          // The addresses of the interfaces down are not advertised
+          for (uint32_t k = 0; ipv4->IsUp (j) && k < ipv4->GetNAddresses (j); k++)
+            {
+              owners[ipv4->GetAddress (j, k).GetLocal ()] = i;
+            }
+        }
+    }
+  std::vector<int32_t> paths;
+  Ptr<Packet> packet = Create<Packet> ();
+  Socket::SocketErrno sockerr;
+  for (uint32_t i = 0; i < m_nodes.GetN (); i++)
+    {
+      for (std::map<Ipv4Address, uint32_t>::const_iterator dest = owners.begin (); dest != owners.end (); dest++)
+        {
+          Ipv4Header header;
+          header.SetDestination (dest->first);
+          uint32_t node = i;
+          int32_t hops = 0;
+          while (node != dest->second && hops <= static_cast<int32_t> (m_nodes.GetN ()))
+            {
+              Ptr<Ipv4RoutingProtocol> routing = m_nodes.Get (node)->GetObject<Ipv4> ()->GetRoutingProtocol ();
+              Ptr<Ipv4Route> route = routing->RouteOutput (packet, header, 0, sockerr);
+              if (route == 0)
+                {
+                  break;
+                }
+              Ipv4Address next = route->GetGateway () == Ipv4Address::GetZero () ? dest->first : route->GetGateway ();
+              if (owners.find (next) == owners.end ())
+                {
+                  break;
+                }
+              node = owners[next];
+              hops++;
+            }
+          paths.push_back (node == dest->second ? hops : -1);
+        }
+    }
+  return paths;
+}
+
+void
+Ipv4GlobalRoutingNextHopTableTestCase::CheckPaths (bool loaded, std::string step)
+{
+  Config::SetGlobal ("GlobalRoutingNextHopTable", BooleanValue (false));
+  Ipv4GlobalRoutingHelper::RecomputeRoutingTables ();
+  std::vector<int32_t> expected = GetPaths ();
+
+  Config::SetGlobal ("GlobalRoutingNextHopTable", BooleanValue (true));
+  Ipv4GlobalRoutingHelper::RecomputeRoutingTables ();
+  for (uint32_t i = 0; i < m_nodes.GetN (); i++)
+    {
+      Ptr<Ipv4GlobalRouting> routing = m_nodes.Get (i)->GetObject<Ipv4L3Protocol> ()
+        ->GetRoutingProtocol ()->GetObject<Ipv4GlobalRouting> ();
+      NS_TEST_EXPECT_MSG_EQ (routing->GetNRoutes (), 0, step << ": routes in the table of node " << i);
+      NS_TEST_ASSERT_MSG_NE (routing->GetNextHopTable (), 0, step << ": no next hops on node " << i);
+      NS_TEST_EXPECT_MSG_EQ (routing->GetNextHopTable ()->IsLoaded (), loaded,
+                             step << ": next hops wrongly (not) loaded on node " << i);
+    }
+  std::vector<int32_t> paths = GetPaths ();
+
+  NS_TEST_ASSERT_MSG_EQ (paths.size (), expected.size (), step << ": wrong number of paths");
+  for (uint32_t i = 0; i < paths.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_GT (expected[i], -1, step << ": unreachable address in path " << i);
+      NS_TEST_EXPECT_MSG_EQ (paths[i], expected[i], step << ": wrong length of path " << i);
+    }
+}
+
+void
+Ipv4GlobalRoutingNextHopTableTestCase::DoRun ()
+{
+  Config::SetGlobal ("GlobalRoutingNextHopCache", StringValue (CreateTempDirFilename ("global-next-hops")));
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  CheckPaths (false, "computed");
+  CheckPaths (true, "cached");
+
+  Config::SetGlobal ("GlobalRoutingSpfThreads", UintegerValue (4));
+  Ptr<Ipv4> ipv4 = m_nodes.Get (6)->GetObject<Ipv4> ();
+  ipv4->SetDown (1);
+  CheckPaths (false, "link down");
+  ipv4->SetUp (1);
+  CheckPaths (false, "link up");
+  CheckPaths (true, "link up, cached");
+
+  Config::SetGlobal ("GlobalRoutingSpfThreads", UintegerValue (1));
+  Config::SetGlobal ("GlobalRoutingNextHopTable", BooleanValue (false));
+  Config::SetGlobal ("GlobalRoutingNextHopCache", StringValue (""));
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -1265,8 +1713,11 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite ()
     AddTestCase (new TwoLanTest, TestCase::QUICK);
     AddTestCase (new BridgeTest, TestCase::QUICK);
     AddTestCase (new TwoBridgeTest, TestCase::QUICK);
+    AddTestCase (new EcmpLanTest, TestCase::QUICK);
     AddTestCase (new Ipv4DynamicGlobalRoutingTestCase, TestCase::QUICK);
     AddTestCase (new Ipv4GlobalRoutingSlash32TestCase, TestCase::QUICK);
+    AddTestCase (new Ipv4GlobalRoutingSpfTestCase, TestCase::QUICK);
+    AddTestCase (new Ipv4GlobalRoutingNextHopTableTestCase, TestCase::QUICK);
   }
 
 static Ipv4GlobalRoutingTestSuite g_globalRoutingTestSuite; //!< Static variable for test initialization
@@ -21,6 +21,7 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/ipv4-static-routing-helper.h"
 #include "ns3/node.h"
 #include "ns3/node-container.h"
@@ -201,6 +202,99 @@ Ipv4StaticRoutingSlash32TestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 StaticRouting route selection: longest mask, then lowest
+ * metric, the last route added winning ties, and updates after removals.
+ */
+class Ipv4StaticRoutingSelectionTestCase : public TestCase
+{
+public:
+  Ipv4StaticRoutingSelectionTestCase ();
+
+private:
+  /**
+   * \brief Get the gateway of the route to a destination.
+   * \param routing The routing protocol.
+   * \param dest The destination address.
+   * \return The gateway, or 255.255.255.255 if there is no route.
+   */
+  Ipv4Address GetGateway (Ptr<Ipv4StaticRouting> routing, std::string dest);
+
+  virtual void DoRun (void);
+};
+
+Ipv4StaticRoutingSelectionTestCase::Ipv4StaticRoutingSelectionTestCase ()
+  : TestCase ("Static routing route selection")
+{
+}
+
+Ipv4Address
+Ipv4StaticRoutingSelectionTestCase::GetGateway (Ptr<Ipv4StaticRouting> routing, std::string dest)
+{
+  Ipv4Header header;
+  header.SetDestination (Ipv4Address (dest.c_str ()));
+  Socket::SocketErrno sockerr;
+  Ptr<Ipv4Route> route = routing->RouteOutput (Create<Packet> (), header, 0, sockerr);
+  return route ? route->GetGateway () : Ipv4Address::GetBroadcast ();
+}
+
+void
+Ipv4StaticRoutingSelectionTestCase::DoRun (void)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.Install (node);
+
+  SimpleNetDeviceHelper devHelper;
+  NetDeviceContainer devices = devHelper.Install (node);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.0.0.0", "255.255.255.0");
+  ipv4.Assign (devices);
+
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  Ptr<Ipv4StaticRouting> routing = ipv4RoutingHelper.GetStaticRouting (node->GetObject<Ipv4> ());
+  routing->AddNetworkRouteTo (Ipv4Address ("192.168.0.0"), Ipv4Mask ("/16"), Ipv4Address ("10.0.0.1"), 1, 5);
+  routing->AddNetworkRouteTo (Ipv4Address ("192.168.1.0"), Ipv4Mask ("/24"), Ipv4Address ("10.0.0.2"), 1, 10);
+  routing->AddNetworkRouteTo (Ipv4Address ("192.168.1.0"), Ipv4Mask ("/24"), Ipv4Address ("10.0.0.3"), 1, 10);
+  routing->AddNetworkRouteTo (Ipv4Address ("192.168.1.0"), Ipv4Mask ("/24"), Ipv4Address ("10.0.0.4"), 1, 20);
+  routing->AddHostRouteTo (Ipv4Address ("192.168.1.1"), Ipv4Address ("10.0.0.5"), 1, 30);
+  routing->AddHostRouteTo (Ipv4Address ("192.168.1.1"), Ipv4Address ("10.0.0.6"), 1, 1);
+  // Already present
+  routing->AddNetworkRouteTo (Ipv4Address ("192.168.1.0"), Ipv4Mask ("/24"), Ipv4Address ("10.0.0.2"), 1, 10);
+  uint32_t nRoutes = routing->GetNRoutes ();
+
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "192.168.2.1"), Ipv4Address ("10.0.0.1"), "Wrong /16 route");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "192.168.1.2"), Ipv4Address ("10.0.0.3"), "Wrong choice among equal metrics");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "192.168.1.1"), Ipv4Address ("10.0.0.5"), "The first /32 route wins");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "172.16.0.1"), Ipv4Address::GetBroadcast (), "No route expected");
+
+  // Remove the route via 10.0.0.3, then the one via 10.0.0.5
+  for (uint32_t i = 0; i < routing->GetNRoutes (); i++)
+    {
+      if (routing->GetRoute (i).GetGateway () == Ipv4Address ("10.0.0.3"))
+        {
+          routing->RemoveRoute (i);
+          break;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "192.168.1.2"), Ipv4Address ("10.0.0.2"), "Removed route still used");
+  for (uint32_t i = 0; i < routing->GetNRoutes (); i++)
+    {
+      if (routing->GetRoute (i).GetGateway () == Ipv4Address ("10.0.0.5"))
+        {
+          routing->RemoveRoute (i);
+          break;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "192.168.1.1"), Ipv4Address ("10.0.0.6"), "Removed route still used");
+  NS_TEST_EXPECT_MSG_EQ (routing->GetNRoutes (), nRoutes - 2, "Wrong number of routes");
+
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -217,6 +311,7 @@ Ipv4StaticRoutingTestSuite::Ipv4StaticRoutingTestSuite ()
   : TestSuite ("ipv4-static-routing", UNIT)
 {
   AddTestCase (new Ipv4StaticRoutingSlash32TestCase, TestCase::QUICK);
+  AddTestCase (new Ipv4StaticRoutingSelectionTestCase, TestCase::QUICK);
 }
 
 static Ipv4StaticRoutingTestSuite ipv4StaticRoutingTestSuite; //!< Static variable for test initialization
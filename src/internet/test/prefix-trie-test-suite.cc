@@ -0,0 +1,316 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/prefix-trie.h"
+#include "ns3/random-variable-stream.h"
+
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Print a vector of values
+ * \param values the values
+ * \return the values, separated by spaces
+ */
+static std::string
+ToString (const std::vector<uint32_t> &values)
+{
+  std::ostringstream oss;
+  for (std::vector<uint32_t>::const_iterator it = values.begin (); it != values.end (); it++)
+    {
+      oss << *it << " ";
+    }
+  return oss.str ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief PrefixTrie IPv4 lookups
+ */
+class PrefixTrieIpv4TestCase : public TestCase
+{
+public:
+  PrefixTrieIpv4TestCase ();
+  virtual void DoRun (void);
+};
+
+PrefixTrieIpv4TestCase::PrefixTrieIpv4TestCase ()
+  : TestCase ("PrefixTrie lookups of IPv4 addresses")
+{
+}
+
+void
+PrefixTrieIpv4TestCase::DoRun (void)
+{
+  PrefixTrie<uint32_t> trie;
+  std::vector<uint32_t> values;
+
+  trie.Lookup (Ipv4Address ("10.1.2.3"), values);
+  NS_TEST_EXPECT_MSG_EQ (values.size (), 0, "Empty trie");
+
+  trie.Insert (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/16"), 0);
+  trie.Insert (Ipv4Address ("10.0.0.0"), Ipv4Mask ("/8"), 1);
+  trie.Insert (Ipv4Address ("10.1.2.3"), Ipv4Mask::GetOnes (), 2);
+  trie.Insert (Ipv4Address ("0.0.0.0"), Ipv4Mask::GetZero (), 3);
+  trie.Insert (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/16"), 4);
+  trie.Insert (Ipv4Address ("10.128.0.0"), Ipv4Mask ("/9"), 5);
+  // The host bits of the network are ignored
+  trie.Insert (Ipv4Address ("10.1.2.200"), Ipv4Mask ("/24"), 6);
+  // Non-contiguous mask
+  trie.Insert (Ipv4Address ("0.0.0.3"), Ipv4Mask ("0.0.0.255"), 7);
+  NS_TEST_EXPECT_MSG_EQ (trie.GetN (), 8, "Wrong number of values");
+
+  trie.Lookup (Ipv4Address ("10.1.2.3"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "0 1 2 3 4 6 7 ", "Matches not in insertion order");
+  trie.Lookup (Ipv4Address ("10.1.2.4"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "0 1 3 4 6 ", "Wrong matches");
+  trie.Lookup (Ipv4Address ("10.200.0.3"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "1 3 5 7 ", "Wrong matches");
+  trie.Lookup (Ipv4Address ("192.168.0.1"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "3 ", "Only the default route matches");
+
+  trie.Find (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/16"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "0 4 ", "Wrong values of the network");
+  trie.Find (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/15"), values);
+  NS_TEST_EXPECT_MSG_EQ (values.size (), 0, "No value for this network");
+  trie.Find (Ipv4Address ("10.1.2.0"), Ipv4Mask ("/24"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "6 ", "Wrong values of the network");
+  trie.Find (Ipv4Address ("1.2.3.3"), Ipv4Mask ("0.0.0.255"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "7 ", "Wrong values of the irregular network");
+
+  trie.Clear ();
+  NS_TEST_EXPECT_MSG_EQ (trie.GetN (), 0, "Trie not cleared");
+  trie.Lookup (Ipv4Address ("10.1.2.3"), values);
+  NS_TEST_EXPECT_MSG_EQ (values.size (), 0, "Trie not cleared");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief PrefixTrie IPv6 lookups
+ */
+class PrefixTrieIpv6TestCase : public TestCase
+{
+public:
+  PrefixTrieIpv6TestCase ();
+  virtual void DoRun (void);
+};
+
+PrefixTrieIpv6TestCase::PrefixTrieIpv6TestCase ()
+  : TestCase ("PrefixTrie lookups of IPv6 addresses")
+{
+}
+
+void
+PrefixTrieIpv6TestCase::DoRun (void)
+{
+  PrefixTrie<uint32_t> trie;
+  std::vector<uint32_t> values;
+
+  trie.Insert (Ipv6Address ("2001:db8::"), Ipv6Prefix (32), 0);
+  trie.Insert (Ipv6Address ("2001:db8:1::"), Ipv6Prefix (48), 1);
+  trie.Insert (Ipv6Address ("2001:db8:1::1"), Ipv6Prefix (128), 2);
+  trie.Insert (Ipv6Address ("::"), Ipv6Prefix::GetZero (), 3);
+  trie.Insert (Ipv6Address ("2001:db8:8000::"), Ipv6Prefix (33), 4);
+
+  trie.Lookup (Ipv6Address ("2001:db8:1::1"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "0 1 2 3 ", "Wrong matches");
+  trie.Lookup (Ipv6Address ("2001:db8:1::2"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "0 1 3 ", "Wrong matches");
+  trie.Lookup (Ipv6Address ("2001:db8:8001::2"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "0 3 4 ", "Wrong matches");
+  trie.Lookup (Ipv6Address ("fe80::1"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "3 ", "Only the default route matches");
+
+  trie.Find (Ipv6Address ("2001:db8:1::1"), Ipv6Prefix (128), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "2 ", "Wrong values of the host");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief PrefixTrie erasures
+ */
+class PrefixTrieEraseTestCase : public TestCase
+{
+public:
+  PrefixTrieEraseTestCase ();
+  virtual void DoRun (void);
+};
+
+PrefixTrieEraseTestCase::PrefixTrieEraseTestCase ()
+  : TestCase ("PrefixTrie erasures of values")
+{
+}
+
+void
+PrefixTrieEraseTestCase::DoRun (void)
+{
+  PrefixTrie<uint32_t> trie;
+  std::vector<uint32_t> values;
+
+  trie.Insert (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/16"), 0);
+  trie.Insert (Ipv4Address ("10.0.0.0"), Ipv4Mask ("/8"), 1);
+  trie.Insert (Ipv4Address ("10.1.2.3"), Ipv4Mask::GetOnes (), 2);
+  trie.Insert (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/16"), 3);
+  trie.Insert (Ipv4Address ("10.1.2.0"), Ipv4Mask ("/24"), 4);
+  trie.Insert (Ipv4Address ("0.0.0.3"), Ipv4Mask ("0.0.0.255"), 5);
+  trie.Insert (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/16"), 6);
+
+  NS_TEST_EXPECT_MSG_EQ (trie.Erase (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/16"), 7), false, "No such value");
+  NS_TEST_EXPECT_MSG_EQ (trie.Erase (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/15"), 0), false, "No such network");
+  NS_TEST_EXPECT_MSG_EQ (trie.Erase (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/16"), 3), true, "Value not erased");
+  trie.Find (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/16"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "0 6 ", "Other values of the network changed");
+  trie.Lookup (Ipv4Address ("10.1.2.3"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "0 1 2 4 5 6 ", "Matches not in insertion order");
+
+  // The /24 node branches to the host: erasing its value keeps the host
+  NS_TEST_EXPECT_MSG_EQ (trie.Erase (Ipv4Address ("10.1.2.0"), Ipv4Mask ("/24"), 4), true, "Value not erased");
+  trie.Lookup (Ipv4Address ("10.1.2.3"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "0 1 2 5 6 ", "Wrong matches");
+  trie.Find (Ipv4Address ("10.1.2.3"), Ipv4Mask::GetOnes (), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "2 ", "Host lost");
+
+  NS_TEST_EXPECT_MSG_EQ (trie.Erase (Ipv4Address ("1.2.3.3"), Ipv4Mask ("0.0.0.255"), 5), true, "Irregular value not erased");
+  NS_TEST_EXPECT_MSG_EQ (trie.Erase (Ipv4Address ("0.0.0.3"), Ipv4Mask ("0.0.0.255"), 5), false, "Irregular value erased twice");
+  NS_TEST_EXPECT_MSG_EQ (trie.GetN (), 4, "Wrong number of values");
+
+  NS_TEST_EXPECT_MSG_EQ (trie.Erase (Ipv4Address ("10.1.2.3"), Ipv4Mask::GetOnes (), 2), true, "Value not erased");
+  NS_TEST_EXPECT_MSG_EQ (trie.Erase (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/16"), 0), true, "Value not erased");
+  NS_TEST_EXPECT_MSG_EQ (trie.Erase (Ipv4Address ("10.1.0.0"), Ipv4Mask ("/16"), 6), true, "Value not erased");
+  trie.Lookup (Ipv4Address ("10.1.2.3"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "1 ", "Wrong matches");
+  NS_TEST_EXPECT_MSG_EQ (trie.Erase (Ipv4Address ("10.0.0.0"), Ipv4Mask ("/8"), 1), true, "Value not erased");
+  NS_TEST_EXPECT_MSG_EQ (trie.GetN (), 0, "Trie not empty");
+  trie.Lookup (Ipv4Address ("10.1.2.3"), values);
+  NS_TEST_EXPECT_MSG_EQ (values.size (), 0, "Trie not empty");
+
+  trie.Insert (Ipv6Address ("2001:db8::"), Ipv6Prefix (32), 0);
+  trie.Insert (Ipv6Address ("2001:db8:1::"), Ipv6Prefix (48), 1);
+  trie.Insert (Ipv6Address ("2001:db8:1::1"), Ipv6Prefix (128), 2);
+  NS_TEST_EXPECT_MSG_EQ (trie.Erase (Ipv6Address ("2001:db8:1::"), Ipv6Prefix (48), 1), true, "Value not erased");
+  trie.Lookup (Ipv6Address ("2001:db8:1::1"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "0 2 ", "Wrong matches");
+  NS_TEST_EXPECT_MSG_EQ (trie.Erase (Ipv6Address ("2001:db8::"), Ipv6Prefix (32), 0), true, "Value not erased");
+  trie.Lookup (Ipv6Address ("2001:db8:1::1"), values);
+  NS_TEST_EXPECT_MSG_EQ (ToString (values), "2 ", "Wrong matches");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief PrefixTrie lookups compared with a linear scan of random prefixes
+ */
+class PrefixTrieRandomTestCase : public TestCase
+{
+public:
+  PrefixTrieRandomTestCase ();
+  virtual void DoRun (void);
+};
+
+PrefixTrieRandomTestCase::PrefixTrieRandomTestCase ()
+  : TestCase ("PrefixTrie lookups of random prefixes")
+{
+}
+
+void
+PrefixTrieRandomTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+
+  // Short addresses, so that many prefixes overlap
+  std::vector<std::pair<Ipv4Address, Ipv4Mask> > routes;
+  PrefixTrie<uint32_t> trie;
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      Ipv4Address network (rng->GetInteger (0, 0xffff) << 16);
+      Ipv4Mask mask ((std::string ("/") + std::to_string (rng->GetInteger (0, 32))).c_str ());
+      routes.push_back (std::make_pair (network, mask));
+      trie.Insert (network, mask, i);
+    }
+
+  std::vector<uint32_t> values;
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      Ipv4Address address ((rng->GetInteger (0, 0xffff) << 16) | rng->GetInteger (0, 3));
+      std::vector<uint32_t> expected;
+      for (uint32_t j = 0; j < routes.size (); j++)
+        {
+          if (routes[j].second.IsMatch (address, routes[j].first))
+            {
+              expected.push_back (j);
+            }
+        }
+      trie.Lookup (address, values);
+      NS_TEST_ASSERT_MSG_EQ (ToString (values), ToString (expected), "Wrong matches for " << address);
+    }
+
+  // Erase half of the prefixes, the lookups still match a linear scan
+  std::vector<bool> erased (routes.size (), false);
+  for (uint32_t i = 0; i < routes.size (); i += 2)
+    {
+      NS_TEST_ASSERT_MSG_EQ (trie.Erase (routes[i].first, routes[i].second, i), true, "Value not erased");
+      erased[i] = true;
+    }
+  NS_TEST_EXPECT_MSG_EQ (trie.GetN (), routes.size () / 2, "Wrong number of values");
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      Ipv4Address address ((rng->GetInteger (0, 0xffff) << 16) | rng->GetInteger (0, 3));
+      std::vector<uint32_t> expected;
+      for (uint32_t j = 0; j < routes.size (); j++)
+        {
+          if (!erased[j] && routes[j].second.IsMatch (address, routes[j].first))
+            {
+              expected.push_back (j);
+            }
+        }
+      trie.Lookup (address, values);
+      NS_TEST_ASSERT_MSG_EQ (ToString (values), ToString (expected), "Wrong matches for " << address << " after erasures");
+    }
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief PrefixTrie TestSuite
+ */
+class PrefixTrieTestSuite : public TestSuite
+{
+public:
+  PrefixTrieTestSuite ()
+    : TestSuite ("prefix-trie", UNIT)
+  {
+    AddTestCase (new PrefixTrieIpv4TestCase (), TestCase::QUICK);
+    AddTestCase (new PrefixTrieIpv6TestCase (), TestCase::QUICK);
+    AddTestCase (new PrefixTrieEraseTestCase (), TestCase::QUICK);
+    AddTestCase (new PrefixTrieRandomTestCase (), TestCase::QUICK);
+  }
+};
+
+static PrefixTrieTestSuite g_prefixTrieTestSuite; //!< Static variable for test initialization
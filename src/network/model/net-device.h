@@ -359,6 +359,17 @@ public:
    */
   virtual bool SupportsSendFrom (void) const = 0;
 
+  /**
+   * \return true if this interface splits the super-segments (see
+   *         SegmentationTag) it is given into frames, false otherwise (the
+   *         default).
+   *
+   * The network layer only hands down packets larger than the MTU to the
+   * interfaces which support segmentation offload, and splits them itself
+   * for the others.
+   */
+  virtual bool SupportsSegmentationOffload (void) const;
+
 };
 
 } // namespace ns3
@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/fluid-queue.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * FluidBacklog unit tests: growth, saturation, loss and drain of the
+ * background backlog.
+ */
+class FluidBacklogTestCase : public TestCase
+{
+public:
+  FluidBacklogTestCase ();
+  virtual void DoRun (void);
+};
+
+FluidBacklogTestCase::FluidBacklogTestCase ()
+  : TestCase ("Evolution of the fluid backlog")
+{
+}
+
+void
+FluidBacklogTestCase::DoRun (void)
+{
+  FluidBacklog fluid;
+  fluid.SetLinkRate (DataRate ("8Mbps"));    // 1 MB/s
+  fluid.SetBufferSize (100000);
+
+  // 6 + 4 Mbps = 10 Mbps during [1s, 2s], i.e., 250 KB/s more than the link
+  fluid.AddFlow (DataRate ("6Mbps"), Seconds (1), Seconds (3));
+  fluid.AddFlow (DataRate ("4Mbps"), Seconds (1), Seconds (1.2));
+
+  fluid.Update (Seconds (1));
+  NS_TEST_EXPECT_MSG_EQ_TOL (fluid.GetBacklog (), 0, 1e-6, "No backlog before the flows start");
+  NS_TEST_EXPECT_MSG_EQ (fluid.GetRate (), 10000000, "Wrong aggregate rate");
+
+  fluid.Update (Seconds (1.1));
+  NS_TEST_EXPECT_MSG_EQ_TOL (fluid.GetBacklog (), 25000, 1e-3, "Wrong backlog growth");
+  NS_TEST_EXPECT_MSG_EQ (fluid.IsFull (), false, "The buffer is not full yet");
+
+  // After 0.2 s the backlog is 50000 bytes, then it drains at 250 KB/s
+  fluid.Update (Seconds (1.3));
+  NS_TEST_EXPECT_MSG_EQ (fluid.GetRate (), 6000000, "The second flow has stopped");
+  NS_TEST_EXPECT_MSG_EQ_TOL (fluid.GetBacklog (), 25000, 1e-3, "Wrong backlog drain");
+
+  fluid.Update (Seconds (2));
+  NS_TEST_EXPECT_MSG_EQ_TOL (fluid.GetBacklog (), 0, 1e-6, "The backlog is empty");
+  NS_TEST_EXPECT_MSG_EQ_TOL (fluid.GetLostBytes (), 0, 1e-6, "Nothing lost");
+
+  // Overload: 16 Mbps on a 8 Mbps link fills 100 KB in 0.1 s, then loses 1 MB/s
+  fluid.AddFlow (DataRate ("10Mbps"), Seconds (2), Seconds (2.5));
+  fluid.Update (Seconds (2.1));
+  NS_TEST_EXPECT_MSG_EQ (fluid.IsFull (), true, "The buffer is full");
+  fluid.Update (Seconds (2.3));
+  NS_TEST_EXPECT_MSG_EQ_TOL (fluid.GetBacklog (), 100000, 1e-3, "The backlog is bounded");
+  NS_TEST_EXPECT_MSG_EQ_TOL (fluid.GetLostBytes (), 200000, 1e-3, "Wrong amount of lost fluid");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * FluidQueue unit tests: ready times and drops of foreground packets.
+ */
+class FluidQueueTestCase : public TestCase
+{
+public:
+  FluidQueueTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Enqueue a packet and dequeue it at once
+   * \param queue the queue
+   * \param expectedWait the expected waiting time due to the background
+   */
+  void EnqueueDequeue (Ptr<FluidQueue<Packet> > queue, Time expectedWait);
+  /**
+   * Enqueue many packets in an overloaded queue and check the loss ratio
+   * \param queue the queue
+   */
+  void CheckDrops (Ptr<FluidQueue<Packet> > queue);
+  /**
+   * Check the total rate of the active background flows
+   * \param queue the queue
+   * \param expectedRate the expected rate, in bit/s
+   */
+  void CheckRate (Ptr<FluidQueue<Packet> > queue, uint64_t expectedRate);
+};
+
+FluidQueueTestCase::FluidQueueTestCase ()
+  : TestCase ("Foreground packets in a fluid queue")
+{
+}
+
+void
+FluidQueueTestCase::EnqueueDequeue (Ptr<FluidQueue<Packet> > queue, Time expectedWait)
+{
+  NS_TEST_EXPECT_MSG_EQ (queue->Enqueue (Create<Packet> (100)), true, "Packet not enqueued");
+  NS_TEST_EXPECT_MSG_NE (queue->Dequeue (), 0, "Packet not dequeued");
+  NS_TEST_EXPECT_MSG_EQ_TOL ((queue->GetReadyTime () - Simulator::Now ()).GetSeconds (),
+                             expectedWait.GetSeconds (), 1e-5, "Wrong ready time");
+}
+
+void
+FluidQueueTestCase::CheckDrops (Ptr<FluidQueue<Packet> > queue)
+{
+  uint32_t accepted = 0;
+  const uint32_t n = 10000;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      if (queue->Enqueue (Create<Packet> (100)))
+        {
+          accepted++;
+          queue->Dequeue ();
+        }
+    }
+  // 16 Mbps offered to a 8 Mbps link: half of the traffic is lost
+  NS_TEST_EXPECT_MSG_EQ_TOL (accepted / static_cast<double> (n), 0.5, 0.03, "Wrong loss ratio");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetTotalDroppedPackets (), n - accepted, "Drops not traced");
+}
+
+void
+FluidQueueTestCase::CheckRate (Ptr<FluidQueue<Packet> > queue, uint64_t expectedRate)
+{
+  NS_TEST_EXPECT_MSG_EQ (queue->GetBackgroundRate (), expectedRate,
+                         "Wrong background rate at " << Simulator::Now ().As (Time::S));
+}
+
+void
+FluidQueueTestCase::DoRun (void)
+{
+  Ptr<FluidQueue<Packet> > queue = CreateObject<FluidQueue<Packet> > ();
+  queue->SetAttribute ("FluidBufferSize", UintegerValue (100000));
+  queue->SetLinkRate (DataRate ("8Mbps"));
+  queue->AssignStreams (1);
+  queue->AddBackgroundFlow (DataRate ("10Mbps"), Seconds (1), Seconds (2));
+  queue->AddBackgroundFlow (DataRate ("6Mbps"), Seconds (1), Seconds (1.2));
+
+  // No background yet
+  Simulator::Schedule (Seconds (0.5), &FluidQueueTestCase::EnqueueDequeue, this, queue, Seconds (0));
+  // 1 MB/s of excess for 0.01 s: 10000 bytes, i.e., 10 ms at 8 Mbps
+  Simulator::Schedule (Seconds (1.01), &FluidQueueTestCase::EnqueueDequeue, this, queue, MilliSeconds (10));
+  // The buffer is full from 1.1 s
+  Simulator::Schedule (Seconds (1.15), &FluidQueueTestCase::CheckDrops, this, queue);
+  // The flows start and stop without events
+  Simulator::Schedule (Seconds (1.1), &FluidQueueTestCase::CheckRate, this, queue, 16000000);
+  Simulator::Schedule (Seconds (1.5), &FluidQueueTestCase::CheckRate, this, queue, 10000000);
+  Simulator::Schedule (Seconds (2.5), &FluidQueueTestCase::CheckRate, this, queue, 0);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Fluid Queue TestSuite
+ */
+class FluidQueueTestSuite : public TestSuite
+{
+public:
+  FluidQueueTestSuite ()
+    : TestSuite ("fluid-queue", UNIT)
+  {
+    AddTestCase (new FluidBacklogTestCase (), TestCase::QUICK);
+    AddTestCase (new FluidQueueTestCase (), TestCase::QUICK);
+  }
+};
+
+static FluidQueueTestSuite g_fluidQueueTestSuite; //!< Static variable for test initialization
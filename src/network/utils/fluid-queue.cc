@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "fluid-queue.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FluidQueue");
+
+NS_OBJECT_TEMPLATE_CLASS_DEFINE (FluidQueue,Packet);
+
+FluidBacklog::FluidBacklog ()
+  : m_linkRate (0),
+    m_bufferSize (0),
+    m_lastUpdate (Seconds (0)),
+    m_rate (0),
+    m_backlog (0),
+    m_lost (0)
+{
+}
+
+void
+FluidBacklog::SetLinkRate (DataRate rate)
+{
+  m_linkRate = rate;
+}
+
+DataRate
+FluidBacklog::GetLinkRate (void) const
+{
+  return m_linkRate;
+}
+
+void
+FluidBacklog::SetBufferSize (uint32_t bytes)
+{
+  m_bufferSize = bytes;
+  if (m_backlog > m_bufferSize)
+    {
+      m_lost += m_backlog - m_bufferSize;
+      m_backlog = m_bufferSize;
+    }
+}
+
+uint32_t
+FluidBacklog::GetBufferSize (void) const
+{
+  return m_bufferSize;
+}
+
+void
+FluidBacklog::AddFlow (DataRate rate, Time start, Time stop)
+{
+  NS_ASSERT_MSG (start <= stop, "A flow cannot stop before it starts");
+  int64_t bps = static_cast<int64_t> (rate.GetBitRate ());
+  // Changes in the past take effect at the next update
+  m_changes.emplace (std::max (start, m_lastUpdate), bps);
+  m_changes.emplace (std::max (stop, m_lastUpdate), -bps);
+}
+
+void
+FluidBacklog::Update (Time now)
+{
+  auto it = m_changes.begin ();
+  while (it != m_changes.end () && it->first <= now)
+    {
+      Integrate (it->first - m_lastUpdate);
+      m_lastUpdate = it->first;
+      m_rate += it->second;
+      it = m_changes.erase (it);
+    }
+  NS_ASSERT (m_rate >= 0);
+  Integrate (now - m_lastUpdate);
+  m_lastUpdate = now;
+}
+
+void
+FluidBacklog::Integrate (Time dt)
+{
+  if (!dt.IsStrictlyPositive ())
+    {
+      return;
+    }
+  double netRate = (m_rate - static_cast<double> (m_linkRate.GetBitRate ())) / 8;
+  m_backlog += netRate * dt.GetSeconds ();
+  if (m_backlog < 0)
+    {
+      m_backlog = 0;
+    }
+  else if (m_backlog > m_bufferSize)
+    {
+      m_lost += m_backlog - m_bufferSize;
+      m_backlog = m_bufferSize;
+    }
+}
+
+double
+FluidBacklog::GetBacklog (void) const
+{
+  return m_backlog;
+}
+
+uint64_t
+FluidBacklog::GetRate (void) const
+{
+  return static_cast<uint64_t> (m_rate);
+}
+
+double
+FluidBacklog::GetLostBytes (void) const
+{
+  return m_lost;
+}
+
+bool
+FluidBacklog::IsFull (void) const
+{
+  // Tolerate the rounding errors of the integration
+  return m_backlog >= m_bufferSize - 1.0;
+}
+
+} // namespace ns3
@@ -0,0 +1,441 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLUID_QUEUE_H
+#define FLUID_QUEUE_H
+
+#include "ns3/queue.h"
+#include "ns3/data-rate.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/uinteger.h"
+#include <deque>
+#include <map>
+
+namespace ns3 {
+
+/**
+ * \ingroup queue
+ *
+ * \brief Fluid model of the backlog created on a link by background traffic
+ *
+ * The background traffic is described by its aggregate rate, a piecewise
+ * constant function of time built by adding flows (each one with a constant
+ * rate between a start and a stop time). The backlog B(t) follows
+ *
+ *     dB/dt = R(t) - C   (bounded by 0 and by the buffer size)
+ *
+ * where R(t) is the aggregate rate and C is the link rate. The fluid that
+ * does not fit in the buffer is lost. The state is advanced lazily, when it
+ * is queried, so that the background traffic does not generate any event,
+ * whatever the number of flows.
+ */
+class FluidBacklog
+{
+public:
+  FluidBacklog ();
+
+  /**
+   * \brief Set the rate at which the backlog is drained
+   * \param rate the link rate
+   */
+  void SetLinkRate (DataRate rate);
+  /**
+   * \return the rate at which the backlog is drained
+   */
+  DataRate GetLinkRate (void) const;
+  /**
+   * \brief Set the buffer size
+   * \param bytes the maximum backlog, in bytes
+   */
+  void SetBufferSize (uint32_t bytes);
+  /**
+   * \return the buffer size, in bytes
+   */
+  uint32_t GetBufferSize (void) const;
+  /**
+   * \brief Add a background flow
+   * \param rate the rate of the flow
+   * \param start the time at which the flow starts
+   * \param stop the time at which the flow stops
+   */
+  void AddFlow (DataRate rate, Time start, Time stop);
+  /**
+   * \brief Bring the backlog up to date
+   * \param now the current time
+   */
+  void Update (Time now);
+  /**
+   * \return the backlog, in bytes, at the time of the last update
+   */
+  double GetBacklog (void) const;
+  /**
+   * \return the aggregate background rate, in bit/s, at the time of the
+   * last update
+   */
+  uint64_t GetRate (void) const;
+  /**
+   * \return the amount of background traffic lost, in bytes, until the time
+   * of the last update
+   */
+  double GetLostBytes (void) const;
+  /**
+   * \return true if the buffer was full at the time of the last update
+   */
+  bool IsFull (void) const;
+
+private:
+  /**
+   * \brief Advance the backlog by a time interval at the current rate
+   * \param dt the time interval
+   */
+  void Integrate (Time dt);
+
+  DataRate m_linkRate;                     //!< Link rate
+  uint32_t m_bufferSize;                   //!< Buffer size, in bytes
+  std::multimap<Time, int64_t> m_changes;  //!< Future rate changes, in bit/s
+  Time m_lastUpdate;                       //!< Time of the last update
+  int64_t m_rate;                          //!< Aggregate rate, in bit/s
+  double m_backlog;                        //!< Backlog, in bytes
+  double m_lost;                           //!< Lost background traffic, in bytes
+};
+
+/**
+ * \ingroup queue
+ *
+ * \brief A FIFO packet queue sharing the link with fluid background traffic
+ *
+ * This queue is meant to be used as the transmit queue of a device (such as
+ * PointToPointNetDevice or CsmaNetDevice) to study large networks in which
+ * most of the traffic on some links is not simulated packet by packet.
+ * The packets enqueued in this queue (the foreground traffic) are simulated
+ * discretely, and see the background traffic through a FluidBacklog:
+ *
+ * - when the fluid buffer is full and the background rate exceeds the link
+ *   rate, an arriving packet is dropped (before being enqueued, hence
+ *   through the usual Drop and DropBeforeEnqueue traces) with the
+ *   probability 1 - C/R(t) that any byte arriving at a full buffer is lost;
+ * - a packet that is accepted cannot start its transmission before the
+ *   background backlog found at its arrival has been transmitted, i.e.,
+ *   before its arrival time plus B(t)/C. Devices get this time through
+ *   GetReadyTime () after dequeuing the packet, and hold their transmitter
+ *   until then.
+ *
+ * The foreground traffic is assumed to be a small fraction of the link load,
+ * and is not added to the fluid backlog. Otherwise, the queue behaves as a
+ * DropTailQueue, whose MaxSize applies to the foreground packets.
+ */
+template <typename Item>
+class FluidQueue : public Queue<Item>
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief FluidQueue Constructor
+   */
+  FluidQueue ();
+
+  virtual ~FluidQueue ();
+
+  virtual bool Enqueue (Ptr<Item> item);
+  virtual Ptr<Item> Dequeue (void);
+  virtual Ptr<Item> Remove (void);
+  virtual Ptr<const Item> Peek (void) const;
+
+  /**
+   * \brief Add a background flow sharing the link
+   * \param rate the rate of the flow
+   * \param start the time at which the flow starts (absolute)
+   * \param stop the time at which the flow stops (absolute)
+   */
+  void AddBackgroundFlow (DataRate rate, Time start, Time stop);
+  /**
+   * \brief Set the link rate, used to drain the background backlog
+   *
+   * Devices call this method with their data rate.
+   *
+   * \param rate the link rate
+   */
+  void SetLinkRate (DataRate rate);
+  /**
+   * \return the earliest time at which the last dequeued item can start
+   * its transmission
+   */
+  Time GetReadyTime (void) const;
+  /**
+   * \return the background backlog, in bytes
+   */
+  double GetBackgroundBacklog (void);
+  /**
+   * \return the aggregate background rate, in bit/s
+   */
+  uint64_t GetBackgroundRate (void);
+  /**
+   * \return the amount of background traffic lost so far, in bytes
+   */
+  double GetBackgroundLostBytes (void);
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model.  Return the number of streams (possibly zero) that
+   * have been assigned.
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
+
+private:
+  using Queue<Item>::begin;
+  using Queue<Item>::end;
+  using Queue<Item>::DoEnqueue;
+  using Queue<Item>::DoDequeue;
+  using Queue<Item>::DoRemove;
+  using Queue<Item>::DoPeek;
+  using Queue<Item>::DropBeforeEnqueue;
+
+  /**
+   * \brief Set the fluid buffer size
+   * \param bytes the buffer size, in bytes
+   */
+  void SetBufferSize (uint32_t bytes);
+  /**
+   * \return the fluid buffer size, in bytes
+   */
+  uint32_t GetBufferSize (void) const;
+
+  FluidBacklog m_fluid;                  //!< Background traffic
+  std::deque<Time> m_readyTimes;         //!< Ready times of the queued items
+  Time m_lastReadyTime;                  //!< Ready time of the last dequeued item
+  Ptr<UniformRandomVariable> m_uniform;  //!< Drop decisions
+
+  NS_LOG_TEMPLATE_DECLARE;     //!< redefinition of the log component
+};
+
+
+/**
+ * Implementation of the templates declared above.
+ */
+
+template <typename Item>
+TypeId
+FluidQueue<Item>::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FluidQueue<" + GetTypeParamName<FluidQueue<Item> > () + ">")
+    .SetParent<Queue<Item> > ()
+    .SetGroupName ("Network")
+    .template AddConstructor<FluidQueue<Item> > ()
+    .AddAttribute ("MaxSize",
+                   "The max queue size (foreground packets)",
+                   QueueSizeValue (QueueSize ("100p")),
+                   MakeQueueSizeAccessor (&QueueBase::SetMaxSize,
+                                          &QueueBase::GetMaxSize),
+                   MakeQueueSizeChecker ())
+    .AddAttribute ("FluidBufferSize",
+                   "The buffer available to the background traffic, in bytes",
+                   UintegerValue (100000),
+                   MakeUintegerAccessor (&FluidQueue<Item>::SetBufferSize,
+                                         &FluidQueue<Item>::GetBufferSize),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+template <typename Item>
+FluidQueue<Item>::FluidQueue () :
+  Queue<Item> (),
+  NS_LOG_TEMPLATE_DEFINE ("FluidQueue")
+{
+  NS_LOG_FUNCTION (this);
+  m_uniform = CreateObject<UniformRandomVariable> ();
+}
+
+template <typename Item>
+FluidQueue<Item>::~FluidQueue ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+template <typename Item>
+bool
+FluidQueue<Item>::Enqueue (Ptr<Item> item)
+{
+  NS_LOG_FUNCTION (this << item);
+
+  Time now = Simulator::Now ();
+  m_fluid.Update (now);
+
+  if (m_fluid.IsFull () && m_fluid.GetRate () > m_fluid.GetLinkRate ().GetBitRate ())
+    {
+      double lossProbability = 1.0 - static_cast<double> (m_fluid.GetLinkRate ().GetBitRate ())
+                                     / m_fluid.GetRate ();
+      if (m_uniform->GetValue () < lossProbability)
+        {
+          NS_LOG_LOGIC ("Fluid buffer full, dropping " << item);
+          DropBeforeEnqueue (item);
+          return false;
+        }
+    }
+
+  if (!DoEnqueue (end (), item))
+    {
+      return false;
+    }
+  Time wait = Seconds (0);
+  if (m_fluid.GetLinkRate ().GetBitRate () > 0)
+    {
+      wait = m_fluid.GetLinkRate ().CalculateBytesTxTime (static_cast<uint32_t> (m_fluid.GetBacklog ()));
+    }
+  m_readyTimes.push_back (now + wait);
+  return true;
+}
+
+template <typename Item>
+Ptr<Item>
+FluidQueue<Item>::Dequeue (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<Item> item = DoDequeue (begin ());
+
+  if (item != 0)
+    {
+      m_lastReadyTime = m_readyTimes.front ();
+      m_readyTimes.pop_front ();
+    }
+
+  NS_LOG_LOGIC ("Popped " << item);
+
+  return item;
+}
+
+template <typename Item>
+Ptr<Item>
+FluidQueue<Item>::Remove (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<Item> item = DoRemove (begin ());
+
+  if (item != 0)
+    {
+      m_readyTimes.pop_front ();
+    }
+
+  NS_LOG_LOGIC ("Removed " << item);
+
+  return item;
+}
+
+template <typename Item>
+Ptr<const Item>
+FluidQueue<Item>::Peek (void) const
+{
+  NS_LOG_FUNCTION (this);
+
+  return DoPeek (begin ());
+}
+
+template <typename Item>
+void
+FluidQueue<Item>::AddBackgroundFlow (DataRate rate, Time start, Time stop)
+{
+  NS_LOG_FUNCTION (this << rate << start << stop);
+  m_fluid.AddFlow (rate, start, stop);
+}
+
+template <typename Item>
+void
+FluidQueue<Item>::SetLinkRate (DataRate rate)
+{
+  NS_LOG_FUNCTION (this << rate);
+  if (rate != m_fluid.GetLinkRate ())
+    {
+      m_fluid.Update (Simulator::Now ());
+      m_fluid.SetLinkRate (rate);
+    }
+}
+
+template <typename Item>
+Time
+FluidQueue<Item>::GetReadyTime (void) const
+{
+  return m_lastReadyTime;
+}
+
+template <typename Item>
+double
+FluidQueue<Item>::GetBackgroundBacklog (void)
+{
+  m_fluid.Update (Simulator::Now ());
+  return m_fluid.GetBacklog ();
+}
+
+template <typename Item>
+uint64_t
+FluidQueue<Item>::GetBackgroundRate (void)
+{
+  m_fluid.Update (Simulator::Now ());
+  return m_fluid.GetRate ();
+}
+
+template <typename Item>
+double
+FluidQueue<Item>::GetBackgroundLostBytes (void)
+{
+  m_fluid.Update (Simulator::Now ());
+  return m_fluid.GetLostBytes ();
+}
+
+template <typename Item>
+int64_t
+FluidQueue<Item>::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  m_uniform->SetStream (stream);
+  return 1;
+}
+
+template <typename Item>
+void
+FluidQueue<Item>::SetBufferSize (uint32_t bytes)
+{
+  NS_LOG_FUNCTION (this << bytes);
+  m_fluid.SetBufferSize (bytes);
+}
+
+template <typename Item>
+uint32_t
+FluidQueue<Item>::GetBufferSize (void) const
+{
+  return m_fluid.GetBufferSize ();
+}
+
+// The following explicit template instantiation declaration prevents all the
+// translation units including this header file to implicitly instantiate the
+// FluidQueue<Packet> class. The unique instance of this class is explicitly
+// created through the macro NS_OBJECT_TEMPLATE_CLASS_DEFINE (FluidQueue,Packet),
+// which is included in fluid-queue.cc
+extern template class FluidQueue<Packet>;
+
+} // namespace ns3
+
+#endif /* FLUID_QUEUE_H */
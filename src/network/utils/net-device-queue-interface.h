@@ -131,6 +131,20 @@ public:
    */
   virtual void NotifyTransmittedBytes (uint32_t bytes);
 
+  /**
+   * \brief Set whether the netdevice reports the completion of its transmissions
+   * \param enable true if the netdevice calls NotifyTransmittedBytes when it
+   *        has finished transmitting a packet
+   *
+   * By default, the bytes of a packet are reported to the queue limits object
+   * as transmitted when the packet is dequeued from the device queue. Devices
+   * that report them when the transmission is completed, as the Linux drivers
+   * do by calling netdev_tx_completed_queue, also account for the packet being
+   * transmitted, so that the queue limits are only increased when the link
+   * actually starves.
+   */
+  void SetTxCompletionByDevice (bool enable);
+
   /**
    * \brief Reset queue limits state
    */
@@ -206,6 +220,7 @@ public:
 private:
   bool m_stoppedByDevice;         //!< True if the queue has been stopped by the device
   bool m_stoppedByQueueLimits;    //!< True if the queue has been stopped by a queue limits object
+  bool m_txCompletionByDevice;    //!< True if the device reports the completed transmissions
   Ptr<QueueLimits> m_queueLimits; //!< Queue limits object
   WakeCallback m_wakeCallback;    //!< Wake callback
   Ptr<NetDevice> m_device;        //!< the netdevice aggregated to the NetDeviceQueueInterface
@@ -364,8 +379,11 @@ NetDeviceQueue::PacketDequeued (QueueType* queue, Ptr<const typename QueueType::
 {
   NS_LOG_FUNCTION (this << queue << item);
 
-  // Inform BQL
-  NotifyTransmittedBytes (item->GetSize ());
+  // Inform BQL, unless the device does it when the transmission is completed
+  if (!m_txCompletionByDevice)
+    {
+      NotifyTransmittedBytes (item->GetSize ());
+    }
 
   NS_ASSERT_MSG (m_device, "Aggregated NetDevice not set");
   // After dequeuing a packet, if there is room for another packet we
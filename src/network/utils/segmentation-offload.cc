@@ -0,0 +1,318 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "segmentation-offload.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SegmentationOffload");
+
+NS_OBJECT_ENSURE_REGISTERED (SegmentationTag);
+NS_OBJECT_ENSURE_REGISTERED (CoalescingTag);
+
+TypeId
+SegmentationTag::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SegmentationTag")
+    .SetParent<Tag> ()
+    .SetGroupName ("Network")
+    .AddConstructor<SegmentationTag> ()
+  ;
+  return tid;
+}
+
+TypeId
+SegmentationTag::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+uint32_t
+SegmentationTag::GetSerializedSize (void) const
+{
+  return 2;
+}
+
+void
+SegmentationTag::Serialize (TagBuffer buf) const
+{
+  buf.WriteU16 (m_segmentSize);
+}
+
+void
+SegmentationTag::Deserialize (TagBuffer buf)
+{
+  m_segmentSize = buf.ReadU16 ();
+}
+
+void
+SegmentationTag::Print (std::ostream &os) const
+{
+  os << "SegmentSize=" << m_segmentSize;
+}
+
+SegmentationTag::SegmentationTag ()
+  : m_segmentSize (0)
+{
+}
+
+SegmentationTag::SegmentationTag (uint16_t segmentSize)
+  : m_segmentSize (segmentSize)
+{
+}
+
+uint16_t
+SegmentationTag::GetSegmentSize (void) const
+{
+  return m_segmentSize;
+}
+
+TypeId
+CoalescingTag::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CoalescingTag")
+    .SetParent<Tag> ()
+    .SetGroupName ("Network")
+    .AddConstructor<CoalescingTag> ()
+  ;
+  return tid;
+}
+
+TypeId
+CoalescingTag::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+uint32_t
+CoalescingTag::GetSerializedSize (void) const
+{
+  return 12;
+}
+
+void
+CoalescingTag::Serialize (TagBuffer buf) const
+{
+  buf.WriteU64 (m_superSegment);
+  buf.WriteU16 (m_index);
+  buf.WriteU16 (m_count);
+}
+
+void
+CoalescingTag::Deserialize (TagBuffer buf)
+{
+  m_superSegment = buf.ReadU64 ();
+  m_index = buf.ReadU16 ();
+  m_count = buf.ReadU16 ();
+}
+
+void
+CoalescingTag::Print (std::ostream &os) const
+{
+  os << "SuperSegment=" << m_superSegment << " Frame=" << m_index << "/" << m_count;
+}
+
+CoalescingTag::CoalescingTag ()
+  : m_superSegment (0),
+    m_index (0),
+    m_count (0)
+{
+}
+
+CoalescingTag::CoalescingTag (uint64_t superSegment, uint16_t index, uint16_t count)
+  : m_superSegment (superSegment),
+    m_index (index),
+    m_count (count)
+{
+}
+
+uint64_t
+CoalescingTag::GetSuperSegment (void) const
+{
+  return m_superSegment;
+}
+
+uint16_t
+CoalescingTag::GetIndex (void) const
+{
+  return m_index;
+}
+
+uint16_t
+CoalescingTag::GetCount (void) const
+{
+  return m_count;
+}
+
+std::map<uint16_t, std::pair<SegmentationOffload::SegmentCallback, SegmentationOffload::CoalesceCallback> > &
+SegmentationOffload::GetRegistry (void)
+{
+  static std::map<uint16_t, std::pair<SegmentCallback, CoalesceCallback> > registry;
+  return registry;
+}
+
+void
+SegmentationOffload::Register (uint16_t protocol, SegmentCallback segment, CoalesceCallback coalesce)
+{
+  NS_LOG_FUNCTION (protocol);
+  GetRegistry ()[protocol] = std::make_pair (segment, coalesce);
+}
+
+std::list<Ptr<Packet> >
+SegmentationOffload::Segment (Ptr<const Packet> packet, uint16_t protocol)
+{
+  NS_LOG_FUNCTION (packet << protocol);
+  std::list<Ptr<Packet> > frames;
+  Ptr<Packet> p = packet->Copy ();
+  SegmentationTag tag;
+  if (!p->RemovePacketTag (tag))
+    {
+      frames.push_back (p);
+      return frames;
+    }
+  std::map<uint16_t, std::pair<SegmentCallback, CoalesceCallback> >::const_iterator it = GetRegistry ().find (protocol);
+  if (it == GetRegistry ().end ())
+    {
+      NS_LOG_LOGIC ("No segmentation offload for protocol " << protocol);
+      frames.push_back (p);
+      return frames;
+    }
+  frames = it->second.first (p, tag.GetSegmentSize ());
+  // The packets of a TCP connection may share the uid of the packet of the
+  // application they are made of, so number the super-segments instead
+  static uint64_t superSegment = 0;
+  superSegment++;
+  uint16_t index = 0;
+  for (std::list<Ptr<Packet> >::iterator f = frames.begin (); f != frames.end (); f++, index++)
+    {
+      CoalescingTag old;
+      (*f)->RemovePacketTag (old);
+      (*f)->RemovePacketTag (tag);
+      (*f)->AddPacketTag (CoalescingTag (superSegment, index, frames.size ()));
+    }
+  NS_LOG_LOGIC ("Super-segment " << superSegment << " split into " << frames.size () << " frames");
+  return frames;
+}
+
+std::list<Ptr<Packet> >
+SegmentationOffload::Coalesce (const std::list<Ptr<Packet> > &frames, uint16_t protocol)
+{
+  NS_LOG_FUNCTION (frames.size () << protocol);
+  std::map<uint16_t, std::pair<SegmentCallback, CoalesceCallback> >::const_iterator it = GetRegistry ().find (protocol);
+  if (it == GetRegistry ().end ())
+    {
+      return frames;
+    }
+  return it->second.second (frames);
+}
+
+ReceiveCoalescer::ReceiveCoalescer ()
+  : m_superSegment (0),
+    m_protocol (0),
+    m_timeout (Seconds (0))
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+ReceiveCoalescer::SetDeliverCallback (DeliverCallback deliver)
+{
+  NS_LOG_FUNCTION (this);
+  m_deliver = deliver;
+}
+
+void
+ReceiveCoalescer::SetFlushTimeout (Time timeout)
+{
+  NS_LOG_FUNCTION (this << timeout);
+  m_timeout = timeout;
+}
+
+void
+ReceiveCoalescer::Receive (Ptr<Packet> packet, uint16_t protocol, const Address &from)
+{
+  NS_LOG_FUNCTION (this << packet << protocol << from);
+  CoalescingTag tag;
+  if (!packet->PeekPacketTag (tag))
+    {
+      Flush ();
+      m_deliver (packet, protocol, from);
+      return;
+    }
+  if (!m_frames.empty () && (tag.GetSuperSegment () != m_superSegment || protocol != m_protocol))
+    {
+      Flush ();
+    }
+  if (m_frames.empty ())
+    {
+      m_superSegment = tag.GetSuperSegment ();
+      m_protocol = protocol;
+      m_from = from;
+    }
+  m_frames.push_back (packet);
+  if (tag.GetIndex () + 1 >= tag.GetCount ())
+    {
+      Flush ();
+    }
+  else if (!m_timeout.IsZero ())
+    {
+      m_flushEvent.Cancel ();
+      m_flushEvent = Simulator::Schedule (m_timeout, &ReceiveCoalescer::Flush, this);
+    }
+}
+
+void
+ReceiveCoalescer::NotifyDrop (Ptr<const Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
+  CoalescingTag tag;
+  if (!m_frames.empty () && packet->PeekPacketTag (tag)
+      && tag.GetSuperSegment () == m_superSegment && tag.GetIndex () + 1 >= tag.GetCount ())
+    {
+      Flush ();
+    }
+}
+
+void
+ReceiveCoalescer::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_flushEvent.Cancel ();
+  if (m_frames.empty ())
+    {
+      return;
+    }
+  std::list<Ptr<Packet> > frames;
+  frames.swap (m_frames);
+  for (std::list<Ptr<Packet> >::iterator it = frames.begin (); it != frames.end (); it++)
+    {
+      CoalescingTag tag;
+      (*it)->RemovePacketTag (tag);
+    }
+  if (frames.size () > 1)
+    {
+      frames = SegmentationOffload::Coalesce (frames, m_protocol);
+      NS_LOG_LOGIC ("Super-segment " << m_superSegment << " coalesced into " << frames.size () << " packets");
+    }
+  for (std::list<Ptr<Packet> >::iterator it = frames.begin (); it != frames.end (); it++)
+    {
+      m_deliver (*it, m_protocol, m_from);
+    }
+}
+
+} // namespace ns3
@@ -106,6 +106,47 @@ PointToPointChannel::TransmitStart (
   return true;
 }
 
+bool
+PointToPointChannel::TransmitInTrain (Ptr<const Packet> p,
+                                      Ptr<PointToPointNetDevice> src,
+                                      Time txTime,
+                                      uint32_t maxTrainSize)
+{
+  NS_LOG_FUNCTION (this << p << src << maxTrainSize);
+  NS_LOG_LOGIC ("UID is " << p->GetUid () << ")");
+
+  NS_ASSERT (m_link[0].m_state != INITIALIZING);
+  NS_ASSERT (m_link[1].m_state != INITIALIZING);
+
+  uint32_t wire = src == m_link[0].m_src ? 0 : 1;
+  Time rxTime = Simulator::Now () + txTime + m_delay;
+
+  //
+  // The frames are sent one after the other over the wire, so they arrive
+  // in order and the pending event of the train, if some of its frames have
+  // not been received yet, also comes in time for this one.
+  //
+  Ptr<PointToPointTrain> train = m_link[wire].m_train;
+  if (train && train->next < train->frames.size () && train->frames.size () < maxTrainSize)
+    {
+      NS_ASSERT (train->frames.back ().rxTime <= rxTime);
+      train->frames.push_back ({p->Copy (), rxTime});
+    }
+  else
+    {
+      train = Create<PointToPointTrain> ();
+      train->frames.push_back ({p->Copy (), rxTime});
+      m_link[wire].m_train = train;
+      Simulator::ScheduleWithContext (m_link[wire].m_dst->GetNode ()->GetId (),
+                                      txTime + m_delay, &PointToPointNetDevice::ReceiveTrain,
+                                      m_link[wire].m_dst, train);
+    }
+
+  // Call the tx anim callback on the net device
+  m_txrxPointToPoint (p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
+  return true;
+}
+
 std::size_t
 PointToPointChannel::GetNDevices (void) const
 {
@@ -20,8 +20,10 @@
 #define POINT_TO_POINT_CHANNEL_H
 
 #include <list>
+#include <vector>
 #include "ns3/channel.h"
 #include "ns3/ptr.h"
+#include "ns3/packet.h"
 #include "ns3/nstime.h"
 #include "ns3/data-rate.h"
 #include "ns3/traced-callback.h"
@@ -29,7 +31,26 @@
 namespace ns3 {
 
 class PointToPointNetDevice;
-class Packet;
+
+/**
+ * \ingroup point-to-point
+ * \brief Frames in flight back-to-back over a wire of a PointToPointChannel,
+ * received through a single pending event.
+ */
+struct PointToPointTrain : public SimpleRefCount<PointToPointTrain>
+{
+  /**
+   * \brief A frame of the train
+   */
+  struct Frame
+  {
+    Ptr<Packet> packet; //!< The frame, until it is received
+    Time rxTime;        //!< Time at which the last bit of the frame arrives
+  };
+
+  std::vector<Frame> frames; //!< Frames, in transmission order
+  std::size_t next {0};      //!< Index of the next frame to be received
+};
 
 /**
  * \ingroup point-to-point
@@ -80,6 +101,24 @@ public:
    */
   virtual bool TransmitStart (Ptr<const Packet> p, Ptr<PointToPointNetDevice> src, Time txTime);
 
+  /**
+   * \brief Transmit a packet over this channel, as part of a train
+   *
+   * Like TransmitStart (), but if the frames previously sent over the same
+   * wire are still in flight and fewer than maxTrainSize, the packet is
+   * appended to their train instead of being given its own receive event:
+   * the pending ReceiveTrain event of the receiving device delivers each
+   * frame of the train at its own arrival time.
+   *
+   * \param p Packet to transmit
+   * \param src Source PointToPointNetDevice
+   * \param txTime Transmit time to apply
+   * \param maxTrainSize Maximum number of frames in a train
+   * \returns true if successful (currently always true)
+   */
+  virtual bool TransmitInTrain (Ptr<const Packet> p, Ptr<PointToPointNetDevice> src,
+                                Time txTime, uint32_t maxTrainSize);
+
   /**
    * \brief Get number of devices on this channel
    * \returns number of devices on this channel
@@ -199,6 +238,7 @@ public:
     WireState                  m_state; //!< State of the link
     Ptr<PointToPointNetDevice> m_src;   //!< First NetDevice
     Ptr<PointToPointNetDevice> m_dst;   //!< Second NetDevice
+    Ptr<PointToPointTrain>     m_train; //!< Last train sent over the wire
   };
 
   Link    m_link[N_DEVICES]; //!< Link model
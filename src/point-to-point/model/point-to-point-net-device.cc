@@ -18,6 +18,8 @@
 
 #include "ns3/log.h"
 #include "ns3/queue.h"
+#include "ns3/fluid-queue.h"
+#include "ns3/net-device-queue-interface.h"
 #include "ns3/simulator.h"
 #include "ns3/mac48-address.h"
 #include "ns3/llc-snap-header.h"
@@ -25,6 +27,7 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
 #include "point-to-point-net-device.h"
 #include "point-to-point-channel.h"
 #include "ppp-header.h"
@@ -67,6 +70,22 @@ PointToPointNetDevice::GetTypeId (void)
                    TimeValue (Seconds (0.0)),
                    MakeTimeAccessor (&PointToPointNetDevice::m_tInterframeGap),
                    MakeTimeChecker ())
+    .AddAttribute ("MaxTrainSize",
+                   "The maximum number of back-to-back frames in flight on "
+                   "the channel that are received through a single pending "
+                   "event (a train) instead of one event each. The frames "
+                   "are sent and received, and the traces fired, at the same "
+                   "times as without trains. A value of 1 disables trains.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&PointToPointNetDevice::m_maxTrainSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("ReceiveCoalescing",
+                   "Whether the received frames of a super-segment are "
+                   "coalesced before being forwarded up the stack, like "
+                   "the generic receive offload of Linux.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&PointToPointNetDevice::m_receiveCoalescing),
+                   MakeBooleanChecker ())
 
     //
     // Transmit queueing discipline for the device which includes its own set
@@ -177,9 +196,13 @@ PointToPointNetDevice::PointToPointNetDevice ()
     m_txMachineState (READY),
     m_channel (0),
     m_linkUp (false),
-    m_currentPkt (0)
+    m_currentPkt (0),
+    m_maxTrainSize (1),
+    m_fluidQueueCheck (0),
+    m_receiveCoalescing (true)
 {
   NS_LOG_FUNCTION (this);
+  m_rxCoalescer.SetDeliverCallback (MakeCallback (&PointToPointNetDevice::ForwardUp, this));
 }
 
 PointToPointNetDevice::~PointToPointNetDevice ()
@@ -215,14 +238,58 @@ PointToPointNetDevice::DoDispose ()
   m_receiveErrorModel = 0;
   m_currentPkt = 0;
   m_queue = 0;
+  m_fluidQueue = 0;
+  m_fluidQueueCheck = 0;
+  m_netDeviceQueue = 0;
+  m_txFrames.clear ();
+  m_txSuperSegment = 0;
   NetDevice::DoDispose ();
 }
 
+void
+PointToPointNetDevice::NotifyNewAggregate (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_netDeviceQueue == 0)
+    {
+      Ptr<NetDeviceQueueInterface> ndqi = GetObject<NetDeviceQueueInterface> ();
+      if (ndqi != 0)
+        {
+          m_netDeviceQueue = ndqi->GetTxQueue (0);
+          m_netDeviceQueue->SetTxCompletionByDevice (true);
+        }
+    }
+  NetDevice::NotifyNewAggregate ();
+}
+
+void
+PointToPointNetDevice::NotifyTxCompletion (Ptr<const Packet> p)
+{
+  //
+  // The queue limits account for the super-segment dequeued, so report it
+  // once its last frame has been transmitted.
+  //
+  if (m_txSuperSegment != 0)
+    {
+      if (!m_txFrames.empty ())
+        {
+          return;
+        }
+      p = m_txSuperSegment;
+      m_txSuperSegment = 0;
+    }
+  if (m_netDeviceQueue != 0)
+    {
+      m_netDeviceQueue->NotifyTransmittedBytes (p->GetSize ());
+    }
+}
+
 void
 PointToPointNetDevice::SetDataRate (DataRate bps)
 {
   NS_LOG_FUNCTION (this);
   m_bps = bps;
+  UpdateFluidQueue ();
 }
 
 void
@@ -244,6 +311,20 @@ PointToPointNetDevice::TransmitStart (Ptr<Packet> p)
   // schedule an event that will be executed when the transmission is complete.
   //
   NS_ASSERT_MSG (m_txMachineState == READY, "Must be READY to transmit");
+
+  //
+  // With a FluidQueue, the packet cannot leave before the background traffic
+  // queued ahead of it has been drained.  The device stays busy meanwhile.
+  //
+  if (m_fluidQueue && m_fluidQueue->GetReadyTime () > Simulator::Now ())
+    {
+      Time wait = m_fluidQueue->GetReadyTime () - Simulator::Now ();
+      NS_LOG_LOGIC ("Background backlog, wait for " << wait.As (Time::S));
+      m_txMachineState = BUSY;
+      Simulator::Schedule (wait, &PointToPointNetDevice::FluidWaitComplete, this, p);
+      return true;
+    }
+
   m_txMachineState = BUSY;
   m_currentPkt = p;
   m_phyTxBeginTrace (m_currentPkt);
@@ -254,7 +335,15 @@ PointToPointNetDevice::TransmitStart (Ptr<Packet> p)
   NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << txCompleteTime.As (Time::S));
   Simulator::Schedule (txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
 
-  bool result = m_channel->TransmitStart (p, this, txTime);
+  bool result;
+  if (m_maxTrainSize > 1)
+    {
+      result = m_channel->TransmitInTrain (p, this, txTime, m_maxTrainSize);
+    }
+  else
+    {
+      result = m_channel->TransmitStart (p, this, txTime);
+    }
   if (result == false)
     {
       m_phyTxDropTrace (p);
@@ -262,6 +351,15 @@ PointToPointNetDevice::TransmitStart (Ptr<Packet> p)
   return result;
 }
 
+void
+PointToPointNetDevice::FluidWaitComplete (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  NS_ASSERT_MSG (m_txMachineState == BUSY, "Must be BUSY while waiting");
+  m_txMachineState = READY;
+  TransmitStart (p);
+}
+
 void
 PointToPointNetDevice::TransmitComplete (void)
 {
@@ -279,9 +377,10 @@ PointToPointNetDevice::TransmitComplete (void)
   NS_ASSERT_MSG (m_currentPkt != 0, "PointToPointNetDevice::TransmitComplete(): m_currentPkt zero");
 
   m_phyTxEndTrace (m_currentPkt);
+  NotifyTxCompletion (m_currentPkt);
   m_currentPkt = 0;
 
-  Ptr<Packet> p = m_queue->Dequeue ();
+  Ptr<Packet> p = DequeueFrame ();
   if (p == 0)
     {
       NS_LOG_LOGIC ("No pending packets in device queue after tx complete");
@@ -305,6 +404,8 @@ PointToPointNetDevice::Attach (Ptr<PointToPointChannel> ch)
 
   m_channel->Attach (this);
 
+  UpdateFluidQueue ();
+
   //
   // This device is up whenever it is attached to a channel.  A better plan
   // would be to have the link come up when both devices are attached, but this
@@ -319,6 +420,25 @@ PointToPointNetDevice::SetQueue (Ptr<Queue<Packet> > q)
 {
   NS_LOG_FUNCTION (this << q);
   m_queue = q;
+  UpdateFluidQueue ();
+}
+
+void
+PointToPointNetDevice::UpdateFluidQueue (void)
+{
+  //
+  // The queue may also have been replaced through the TxQueue attribute, so
+  // look again for a FluidQueue whenever it changes.
+  //
+  if (PeekPointer (m_queue) != m_fluidQueueCheck)
+    {
+      m_fluidQueueCheck = PeekPointer (m_queue);
+      m_fluidQueue = DynamicCast<FluidQueue<Packet> > (m_queue);
+    }
+  if (m_fluidQueue)
+    {
+      m_fluidQueue->SetLinkRate (m_bps);
+    }
 }
 
 void
@@ -341,6 +461,7 @@ PointToPointNetDevice::Receive (Ptr<Packet> packet)
       // corrupted packet, don't forward this packet up, let it go.
       //
       m_phyRxDropTrace (packet);
+      m_rxCoalescer.NotifyDrop (packet);
     }
   else 
     {
@@ -374,7 +495,87 @@ PointToPointNetDevice::Receive (Ptr<Packet> packet)
         }
 
       m_macRxTrace (originalPacket);
-      m_rxCallback (this, packet, protocol, GetRemote ());
+      if (m_receiveCoalescing)
+        {
+          m_rxCoalescer.Receive (packet, protocol, GetRemote ());
+        }
+      else
+        {
+          CoalescingTag tag;
+          packet->RemovePacketTag (tag);
+          m_rxCallback (this, packet, protocol, GetRemote ());
+        }
+    }
+}
+
+void
+PointToPointNetDevice::ForwardUp (Ptr<Packet> packet, uint16_t protocol, const Address &from)
+{
+  NS_LOG_FUNCTION (this << packet << protocol << from);
+  m_rxCallback (this, packet, protocol, from);
+}
+
+Ptr<Packet>
+PointToPointNetDevice::DequeueFrame (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_txFrames.empty ())
+    {
+      Ptr<Packet> frame = m_txFrames.front ();
+      m_txFrames.pop_front ();
+      return frame;
+    }
+
+  Ptr<Packet> p = m_queue->Dequeue ();
+  SegmentationTag tag;
+  if (p == 0 || !p->PeekPacketTag (tag))
+    {
+      return p;
+    }
+
+  //
+  // Split the super-segment below the point-to-point protocol header, and
+  // put a copy of the header on every frame.
+  //
+  Ptr<Packet> packet = p->Copy ();
+  uint16_t protocol = 0;
+  ProcessHeader (packet, protocol);
+  std::list<Ptr<Packet> > frames = SegmentationOffload::Segment (packet, protocol);
+  for (std::list<Ptr<Packet> >::iterator it = frames.begin (); it != frames.end (); it++)
+    {
+      AddHeader (*it, protocol);
+      m_txFrames.push_back (*it);
+    }
+  NS_LOG_LOGIC ("Super-segment " << p->GetUid () << " split into " << m_txFrames.size () << " frames");
+  m_txSuperSegment = p;
+  Ptr<Packet> frame = m_txFrames.front ();
+  m_txFrames.pop_front ();
+  return frame;
+}
+
+void
+PointToPointNetDevice::ReceiveTrain (Ptr<PointToPointTrain> train)
+{
+  NS_LOG_FUNCTION (this << train->frames.size () << train->next);
+
+  //
+  // Receive the frames which arrive now, then wait for the next one.  The
+  // channel may append frames to the train meanwhile.
+  //
+  Time now = Simulator::Now ();
+  do
+    {
+      Ptr<Packet> packet = train->frames[train->next].packet;
+      train->frames[train->next++].packet = 0;
+      Receive (packet);
+    }
+  while (train->next < train->frames.size ()
+         && train->frames[train->next].rxTime == now);
+
+  if (train->next < train->frames.size ())
+    {
+      Simulator::Schedule (train->frames[train->next].rxTime - now,
+                           &PointToPointNetDevice::ReceiveTrain, this, train);
     }
 }
 
@@ -534,6 +735,7 @@ PointToPointNetDevice::Send (
   //
   // We should enqueue and dequeue the packet to hit the tracing hooks.
   //
+  UpdateFluidQueue ();
   if (m_queue->Enqueue (packet))
     {
       //
@@ -541,7 +743,7 @@ PointToPointNetDevice::Send (
       // 
       if (m_txMachineState == READY)
         {
-          packet = m_queue->Dequeue ();
+          packet = DequeueFrame ();
           m_snifferTrace (packet);
           m_promiscSnifferTrace (packet);
           bool ret = TransmitStart (packet);
@@ -598,6 +800,13 @@ PointToPointNetDevice::SetPromiscReceiveCallback (NetDevice::PromiscReceiveCallb
   m_promiscCallback = cb;
 }
 
+bool
+PointToPointNetDevice::SupportsSegmentationOffload (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return true;
+}
+
 bool
 PointToPointNetDevice::SupportsSendFrom (void) const
 {
@@ -30,11 +30,16 @@
 #include "ns3/data-rate.h"
 #include "ns3/ptr.h"
 #include "ns3/mac48-address.h"
+#include "ns3/segmentation-offload.h"
+#include <deque>
 
 namespace ns3 {
 
 template <typename Item> class Queue;
+template <typename Item> class FluidQueue;
+class NetDeviceQueue;
 class PointToPointChannel;
+struct PointToPointTrain;
 class ErrorModel;
 
 /**
@@ -149,6 +154,20 @@ public:
    */
   void Receive (Ptr<Packet> p);
 
+  /**
+   * Receive a train of frames from a connected PointToPointChannel.
+   *
+   * This method is called by the channel when the last bit of the first
+   * frame of the train has arrived at the device (see
+   * PointToPointChannel::TransmitInTrain). The frame is passed to Receive (),
+   * together with any following frame that arrives at the same time, and the
+   * method is rescheduled for the arrival of the next frame of the train, if
+   * any.
+   *
+   * \param train the train being received
+   */
+  void ReceiveTrain (Ptr<PointToPointTrain> train);
+
   // The remaining methods are documented in ns3::NetDevice*
 
   virtual void SetIfIndex (const uint32_t index);
@@ -189,6 +208,7 @@ public:
 
   virtual void SetPromiscReceiveCallback (PromiscReceiveCallback cb);
   virtual bool SupportsSendFrom (void) const;
+  virtual bool SupportsSegmentationOffload (void) const;
 
 protected:
   /**
@@ -224,8 +244,43 @@ private:
    */
   virtual void DoDispose (void);
 
+  /**
+   * \brief Get the transmission queue of the NetDeviceQueueInterface
+   * aggregated to this device, if any, whose queue limits are notified of
+   * the completed transmissions
+   */
+  virtual void NotifyNewAggregate (void);
+
 private:
 
+  /**
+   * \brief Report the completion of the transmission of a packet to the
+   * queue limits, if any
+   *
+   * \param p the packet
+   */
+  void NotifyTxCompletion (Ptr<const Packet> p);
+
+  /**
+   * \brief Get the next frame to transmit
+   *
+   * The frames of the last super-segment (see SegmentationTag) dequeued
+   * come first.  A super-segment dequeued is split into frames, which are
+   * transmitted back-to-back.
+   *
+   * \return the frame, or 0 if there is none
+   */
+  Ptr<Packet> DequeueFrame (void);
+
+  /**
+   * \brief Forward a received packet up the protocol stack
+   *
+   * \param packet the packet
+   * \param protocol the protocol number
+   * \param from the address of the sender
+   */
+  void ForwardUp (Ptr<Packet> packet, uint16_t protocol, const Address &from);
+
   /**
    * \returns the address of the remote device connected to this device
    * through the point to point channel.
@@ -267,6 +322,20 @@ private:
    */
   bool TransmitStart (Ptr<Packet> p);
 
+  /**
+   * End the wait imposed on a packet by the background traffic of a
+   * FluidQueue and start transmitting the packet.
+   *
+   * \param p the packet
+   */
+  void FluidWaitComplete (Ptr<Packet> p);
+
+  /**
+   * Look for a FluidQueue in the transmit queue, if the queue changed, and
+   * keep its link rate in sync with the data rate of the device.
+   */
+  void UpdateFluidQueue (void);
+
   /**
    * Stop Sending a Packet Down the Wire and Begin the Interframe Gap.
    *
@@ -456,6 +525,14 @@ private:
   uint32_t m_mtu;
 
   Ptr<Packet> m_currentPkt; //!< Current packet processed
+  uint32_t m_maxTrainSize;  //!< Maximum number of packets in a train
+  Ptr<FluidQueue<Packet> > m_fluidQueue; //!< The transmit queue, if it is a FluidQueue
+  Queue<Packet> *m_fluidQueueCheck;      //!< The transmit queue last looked at by UpdateFluidQueue
+  Ptr<NetDeviceQueue> m_netDeviceQueue;  //!< The transmission queue of the NetDeviceQueueInterface
+  std::deque<Ptr<Packet> > m_txFrames;   //!< Frames of the super-segment being transmitted
+  Ptr<Packet> m_txSuperSegment;          //!< Super-segment being transmitted
+  bool m_receiveCoalescing;              //!< Whether the frames of super-segments are coalesced
+  ReceiveCoalescer m_rxCoalescer;        //!< Coalescer of the received frames
 
   /**
    * \brief PPP to Ethernet protocol number mapping
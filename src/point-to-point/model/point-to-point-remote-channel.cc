@@ -73,4 +73,14 @@ PointToPointRemoteChannel::TransmitStart (
   return true;
 }
 
+bool
+PointToPointRemoteChannel::TransmitInTrain (Ptr<const Packet> p,
+                                            Ptr<PointToPointNetDevice> src,
+                                            Time txTime,
+                                            uint32_t maxTrainSize)
+{
+  NS_LOG_FUNCTION (this << p << src << maxTrainSize);
+  return TransmitStart (p, src, txTime);
+}
+
 } // namespace ns3
@@ -68,6 +68,20 @@ public:
    */
   virtual bool TransmitStart (Ptr<const Packet> p, Ptr<PointToPointNetDevice> src,
                               Time txTime);
+
+  /**
+   * \brief Transmit the packet as part of a train
+   *
+   * Each frame is sent to the remote rank separately, as by TransmitStart ().
+   *
+   * \param p Packet to transmit
+   * \param src Source PointToPointNetDevice
+   * \param txTime Transmit time to apply
+   * \param maxTrainSize Maximum number of frames in a train (unused)
+   * \returns true if successful (currently always true)
+   */
+  virtual bool TransmitInTrain (Ptr<const Packet> p, Ptr<PointToPointNetDevice> src,
+                                Time txTime, uint32_t maxTrainSize);
 };
 
 } // namespace ns3
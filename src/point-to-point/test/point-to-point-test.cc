@@ -20,12 +20,18 @@
 
 #include "ns3/test.h"
 #include "ns3/drop-tail-queue.h"
+#include "ns3/fluid-queue.h"
 #include "ns3/simulator.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/queue-limits.h"
+#include "ns3/uinteger.h"
+#include "ns3/pointer.h"
 
+#include <vector>
 #include <string>
+#include <sstream>
 
 using namespace ns3;
 
@@ -130,6 +136,424 @@ PointToPointTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \brief Test the transmission of trains of back-to-back frames
+ *
+ * Bursts of packets of different sizes are sent over a link with and
+ * without trains. The traces of the devices, of their queues and of the
+ * channel must fire at the same times, in the same order, and no more
+ * events may be executed when trains are enabled.
+ */
+class PointToPointTrainTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointTrainTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Send bursts of packets over a link and record the traces
+   *
+   * \param maxTrainSize The MaxTrainSize attribute of the devices
+   * \return The number of events executed by the simulator
+   */
+  uint64_t RunBurst (uint32_t maxTrainSize);
+  /**
+   * \brief Send one packet to the device specified
+   *
+   * \param device NetDevice to send to.
+   * \param size Size of the packet.
+   */
+  void SendOnePacket (Ptr<PointToPointNetDevice> device, uint32_t size);
+  /**
+   * \brief Record a packet trace
+   *
+   * \param context The name of the trace source.
+   * \param pkt The traced packet.
+   */
+  void Trace (std::string context, Ptr<const Packet> pkt);
+  /**
+   * \brief Record the channel trace
+   *
+   * \param pkt The transmitted packet.
+   * \param src The sending device.
+   * \param dst The receiving device.
+   * \param txTime The transmission time.
+   * \param rxTime The reception time.
+   */
+  void TraceTxRx (Ptr<const Packet> pkt, Ptr<NetDevice> src, Ptr<NetDevice> dst, Time txTime, Time rxTime);
+
+  std::vector<std::string> m_timeline; //!< time, trace source and packet size of each trace
+};
+
+PointToPointTrainTest::PointToPointTrainTest ()
+  : TestCase ("PointToPoint trains of back-to-back frames")
+{
+}
+
+void
+PointToPointTrainTest::SendOnePacket (Ptr<PointToPointNetDevice> device, uint32_t size)
+{
+  device->Send (Create<Packet> (size), device->GetBroadcast (), 0x800);
+}
+
+void
+PointToPointTrainTest::Trace (std::string context, Ptr<const Packet> pkt)
+{
+  std::ostringstream oss;
+  oss << Simulator::Now ().GetPicoSeconds () << " " << context << " " << pkt->GetSize ();
+  m_timeline.push_back (oss.str ());
+}
+
+void
+PointToPointTrainTest::TraceTxRx (Ptr<const Packet> pkt, Ptr<NetDevice> src, Ptr<NetDevice> dst, Time txTime, Time rxTime)
+{
+  std::ostringstream oss;
+  oss << Simulator::Now ().GetPicoSeconds () << " TxRx " << pkt->GetSize ()
+      << " " << src->GetIfIndex () << " " << txTime.GetPicoSeconds ()
+      << " " << rxTime.GetPicoSeconds ();
+  m_timeline.push_back (oss.str ());
+}
+
+uint64_t
+PointToPointTrainTest::RunBurst (uint32_t maxTrainSize)
+{
+  m_timeline.clear ();
+
+  Ptr<Node> a = CreateObject<Node> ();
+  Ptr<Node> b = CreateObject<Node> ();
+  Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointChannel> channel = CreateObjectWithAttributes<PointToPointChannel> ("Delay", TimeValue (MicroSeconds (3)));
+
+  for (auto dev : {devA, devB})
+    {
+      dev->SetAttribute ("MaxTrainSize", UintegerValue (maxTrainSize));
+      dev->SetAttribute ("InterframeGap", TimeValue (NanoSeconds (96)));
+      dev->SetDataRate (DataRate ("1Gbps"));
+      dev->Attach (channel);
+      dev->SetAddress (Mac48Address::Allocate ());
+      Ptr<DropTailQueue<Packet> > queue = CreateObject<DropTailQueue<Packet> > ();
+      queue->SetMaxSize (QueueSize ("1000p"));
+      dev->SetQueue (queue);
+    }
+  a->AddDevice (devA);
+  b->AddDevice (devB);
+
+  for (auto dev : {devA, devB})
+    {
+      std::string name = dev == devA ? "A " : "B ";
+      for (std::string source : {"MacTx", "MacRx", "PhyTxBegin", "PhyTxEnd",
+                                 "PhyRxEnd", "Sniffer", "PromiscSniffer"})
+        {
+          dev->TraceConnect (source, name + source, MakeCallback (&PointToPointTrainTest::Trace, this));
+        }
+      for (std::string source : {"Enqueue", "Dequeue"})
+        {
+          dev->GetQueue ()->TraceConnect (source, name + source, MakeCallback (&PointToPointTrainTest::Trace, this));
+        }
+    }
+  channel->TraceConnectWithoutContext ("TxRxPointToPoint", MakeCallback (&PointToPointTrainTest::TraceTxRx, this));
+
+  // Bursts in both directions, the second one from A starting while the
+  // first is still queued
+  for (uint32_t burst = 0; burst < 2; burst++)
+    {
+      for (uint32_t i = 0; i < 50; i++)
+        {
+          Simulator::Schedule (MicroSeconds (10 + 100 * burst),
+                               &PointToPointTrainTest::SendOnePacket, this, devA, 64 + 29 * i);
+        }
+    }
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      Simulator::Schedule (MicroSeconds (12),
+                           &PointToPointTrainTest::SendOnePacket, this, devB, 1500 - 31 * i);
+    }
+
+  Simulator::Run ();
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+  return events;
+}
+
+void
+PointToPointTrainTest::DoRun (void)
+{
+  uint64_t refEvents = RunBurst (1);
+  std::vector<std::string> refTimeline = m_timeline;
+  NS_TEST_ASSERT_MSG_GT (refTimeline.size (), 120 * 8, "Missing traces without trains");
+
+  for (uint32_t maxTrainSize : {2, 8, 64})
+    {
+      uint64_t events = RunBurst (maxTrainSize);
+      NS_TEST_ASSERT_MSG_EQ (m_timeline.size (), refTimeline.size (), "Different number of traces with trains of " << maxTrainSize);
+      for (std::size_t i = 0; i < m_timeline.size (); i++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (m_timeline[i], refTimeline[i], "Different trace " << i << " with trains of " << maxTrainSize);
+        }
+      NS_TEST_EXPECT_MSG_LT_OR_EQ (events, refEvents, "Trains of " << maxTrainSize << " executed more events");
+    }
+}
+
+/**
+ * \brief Queue limits recording the notifications of the device
+ */
+class RecordingQueueLimits : public QueueLimits
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  virtual void Reset ()
+  {
+  }
+  virtual void Completed (uint32_t count)
+  {
+    m_completed.push_back (std::make_pair (Simulator::Now (), count));
+  }
+  virtual int32_t Available () const
+  {
+    return 0;
+  }
+  virtual void Queued (uint32_t count)
+  {
+    m_queued += count;
+  }
+
+  std::vector<std::pair<Time, uint32_t> > m_completed; //!< time and size of the completions
+  uint32_t m_queued {0};                                //!< queued bytes
+};
+
+TypeId
+RecordingQueueLimits::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::RecordingQueueLimits")
+    .SetParent<QueueLimits> ()
+    .SetGroupName ("PointToPoint")
+    .AddConstructor<RecordingQueueLimits> ()
+  ;
+  return tid;
+}
+
+/**
+ * \brief Test the notifications of the device to the queue limits
+ *
+ * The bytes of a packet must be reported as transmitted when the
+ * transmission of the packet is completed, not when it is dequeued.
+ */
+class PointToPointQueueLimitsTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointQueueLimitsTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Send one packet to the device specified
+   *
+   * \param device NetDevice to send to.
+   * \param size Size of the packet.
+   */
+  void SendOnePacket (Ptr<PointToPointNetDevice> device, uint32_t size);
+};
+
+PointToPointQueueLimitsTest::PointToPointQueueLimitsTest ()
+  : TestCase ("PointToPoint notification of the completed transmissions")
+{
+}
+
+void
+PointToPointQueueLimitsTest::SendOnePacket (Ptr<PointToPointNetDevice> device, uint32_t size)
+{
+  device->Send (Create<Packet> (size), device->GetBroadcast (), 0x800);
+}
+
+void
+PointToPointQueueLimitsTest::DoRun (void)
+{
+  Ptr<Node> a = CreateObject<Node> ();
+  Ptr<Node> b = CreateObject<Node> ();
+  Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel> ();
+
+  for (auto dev : {devA, devB})
+    {
+      dev->SetDataRate (DataRate ("8Mbps"));
+      dev->Attach (channel);
+      dev->SetAddress (Mac48Address::Allocate ());
+      dev->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+    }
+  a->AddDevice (devA);
+  b->AddDevice (devB);
+
+  Ptr<NetDeviceQueueInterface> ndqi = CreateObject<NetDeviceQueueInterface> ();
+  ndqi->GetTxQueue (0)->ConnectQueueTraces (devA->GetQueue ());
+  devA->AggregateObject (ndqi);
+  Ptr<RecordingQueueLimits> limits = CreateObject<RecordingQueueLimits> ();
+  ndqi->GetTxQueue (0)->SetQueueLimits (limits);
+
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Simulator::Schedule (Seconds (1), &PointToPointQueueLimitsTest::SendOnePacket, this, devA, 998);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // 1000 bytes (with the PPP header) take 1 ms at 8 Mbps
+  NS_TEST_EXPECT_MSG_EQ (limits->m_queued, 3000, "Wrong number of queued bytes");
+  NS_TEST_ASSERT_MSG_EQ (limits->m_completed.size (), 3, "Wrong number of completions");
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (limits->m_completed[i].first, Seconds (1) + MilliSeconds (i + 1),
+                             "Wrong time of completion " << i);
+      NS_TEST_EXPECT_MSG_EQ (limits->m_completed[i].second, 1000, "Wrong size of completion " << i);
+    }
+}
+
+/**
+ * \brief Test a device whose transmit queue is a FluidQueue
+ *
+ * A packet sent behind a background backlog must wait for the backlog to be
+ * drained, and the packets sent while the fluid buffer is full must be
+ * dropped with probability 1 - C/R. The FluidQueue is set through the TxQueue
+ * attribute, after the data rate of the device.
+ */
+class PointToPointFluidQueueTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointFluidQueueTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Send one packet to the device specified
+   *
+   * \param device NetDevice to send to.
+   */
+  void SendOnePacket (Ptr<PointToPointNetDevice> device);
+  /**
+   * \brief Record the reception of a packet
+   *
+   * \param dev The receiving device.
+   * \param pkt The received packet.
+   * \param mode The protocol mode used.
+   * \param sender The sender address.
+   *
+   * \return A boolean indicating packet handled properly.
+   */
+  bool RxPacket (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender);
+  /**
+   * \brief Count a packet dropped by the sending device
+   *
+   * \param pkt The dropped packet.
+   */
+  void MacTxDrop (Ptr<const Packet> pkt);
+
+  std::vector<Time> m_rxTimes; //!< receive time of each packet
+  uint32_t m_drops {0};        //!< number of packets dropped by the sender
+};
+
+PointToPointFluidQueueTest::PointToPointFluidQueueTest ()
+  : TestCase ("PointToPoint with background traffic in a FluidQueue")
+{
+}
+
+void
+PointToPointFluidQueueTest::SendOnePacket (Ptr<PointToPointNetDevice> device)
+{
+  device->Send (Create<Packet> (100), device->GetBroadcast (), 0x800);
+}
+
+bool
+PointToPointFluidQueueTest::RxPacket (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender)
+{
+  m_rxTimes.push_back (Simulator::Now ());
+  return true;
+}
+
+void
+PointToPointFluidQueueTest::MacTxDrop (Ptr<const Packet> pkt)
+{
+  m_drops++;
+}
+
+void
+PointToPointFluidQueueTest::DoRun (void)
+{
+  Ptr<Node> a = CreateObject<Node> ();
+  Ptr<Node> b = CreateObject<Node> ();
+  Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel> ();
+
+  for (auto dev : {devA, devB})
+    {
+      dev->SetDataRate (DataRate ("8Mbps"));
+      dev->Attach (channel);
+      dev->SetAddress (Mac48Address::Allocate ());
+    }
+  a->AddDevice (devA);
+  b->AddDevice (devB);
+
+  Ptr<FluidQueue<Packet> > queue = CreateObject<FluidQueue<Packet> > ();
+  queue->SetAttribute ("FluidBufferSize", UintegerValue (100000));
+  queue->SetAttribute ("MaxSize", QueueSizeValue (QueueSize ("100000p")));
+  queue->AssignStreams (1);
+  queue->AddBackgroundFlow (DataRate ("10Mbps"), Seconds (1), Seconds (2));
+  queue->AddBackgroundFlow (DataRate ("6Mbps"), Seconds (1), Seconds (1.2));
+  devA->SetAttribute ("TxQueue", PointerValue (queue));
+  devB->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+
+  devB->SetReceiveCallback (MakeCallback (&PointToPointFluidQueueTest::RxPacket, this));
+  devA->TraceConnectWithoutContext ("MacTxDrop", MakeCallback (&PointToPointFluidQueueTest::MacTxDrop, this));
+
+  // No background yet, then 1 MB/s of excess for 10 ms: 10000 bytes, i.e.,
+  // 10 ms at 8 Mbps
+  Simulator::Schedule (Seconds (0.5), &PointToPointFluidQueueTest::SendOnePacket, this, devA);
+  Simulator::Schedule (Seconds (1.01), &PointToPointFluidQueueTest::SendOnePacket, this, devA);
+  // The buffer is full from 1.1 s, and 10 Mbps are offered after 1.2 s
+  const uint32_t n = 2000;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Simulator::Schedule (Seconds (1.3) + MicroSeconds (250 * i),
+                           &PointToPointFluidQueueTest::SendOnePacket, this, devA);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_rxTimes.size (), n + 2 - m_drops, "Packets lost");
+  Time txTime = m_rxTimes[0] - Seconds (0.5);
+  NS_TEST_EXPECT_MSG_EQ_TOL ((m_rxTimes[1] - Seconds (1.01) - txTime).GetSeconds (), 0.01, 1e-5,
+                             "Packet not delayed by the background backlog");
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_drops / static_cast<double> (n), 0.2, 0.03, "Wrong loss ratio");
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -146,6 +570,9 @@ PointToPointTestSuite::PointToPointTestSuite ()
   : TestSuite ("devices-point-to-point", UNIT)
 {
   AddTestCase (new PointToPointTest, TestCase::QUICK);
+  AddTestCase (new PointToPointTrainTest, TestCase::QUICK);
+  AddTestCase (new PointToPointQueueLimitsTest, TestCase::QUICK);
+  AddTestCase (new PointToPointFluidQueueTest, TestCase::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
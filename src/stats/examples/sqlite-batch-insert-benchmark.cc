@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures the insertion rate (rows per second) of an SQLite
+// table, filled either one row at a time, as SQLiteOutput users typically
+// do, or with an ns3::SQLiteBatchInsert, optionally with a background writer
+// thread and write-ahead logging.
+//
+// Example:
+//
+//     ./ns3 run "sqlite-batch-insert-benchmark --rows=1000000 --batchSize=10000"
+//
+// Each row mimics a packet trace record (time, node, size, text tag).
+// The row-at-a-time case commits a transaction (and syncs the journal) per
+// row, so it is run on --perRowRows rows only.
+//
+
+#include "ns3/core-module.h"
+#include "ns3/sqlite-output.h"
+#include "ns3/sqlite-batch-insert.h"
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * Print the insertion rate of a run.
+ * \param label description of the run
+ * \param rows number of inserted rows
+ * \param ms elapsed wall clock time, in milliseconds
+ */
+static void
+Report (const std::string &label, uint64_t rows, int64_t ms)
+{
+  double rate = ms > 0 ? rows * 1000.0 / ms : 0;
+  std::cout << std::left << std::setw (36) << label
+            << std::right << std::setw (10) << rows << " rows "
+            << std::setw (8) << ms << " ms "
+            << std::setw (12) << std::fixed << std::setprecision (0) << rate
+            << " rows/s" << std::endl;
+}
+
+/**
+ * Open an empty database with the benchmark table.
+ * \param file database file name
+ * \param wal use write-ahead logging
+ * \return the database
+ */
+static Ptr<SQLiteOutput>
+OpenDb (const std::string &file, bool wal)
+{
+  std::remove (file.c_str ());
+  std::remove ((file + "-wal").c_str ());
+  std::remove ((file + "-shm").c_str ());
+  Ptr<SQLiteOutput> db = Create<SQLiteOutput> (file, "ns-3-sqlite-batch-insert-benchmark-sem");
+  if (wal)
+    {
+      db->SetWalMode ();
+    }
+  db->SpinExec ("CREATE TABLE rx (time REAL, node INTEGER, size INTEGER, tag TEXT)");
+  return db;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t rows = 200000;
+  uint32_t perRowRows = 1000;
+  uint32_t batchSize = 10000;
+  bool wal = true;
+  std::string file = "sqlite-batch-insert-benchmark.db";
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("rows", "Number of rows inserted in batched runs", rows);
+  cmd.AddValue ("perRowRows", "Number of rows inserted in the row-at-a-time run", perRowRows);
+  cmd.AddValue ("batchSize", "Rows per transaction", batchSize);
+  cmd.AddValue ("wal", "Use write-ahead logging", wal);
+  cmd.AddValue ("file", "Database file", file);
+  cmd.Parse (argc, argv);
+
+  const std::string insertCmd = "INSERT INTO rx VALUES (?, ?, ?, ?)";
+  SystemWallClockMs clock;
+
+  // One prepared statement and one implicit transaction per row
+  {
+    Ptr<SQLiteOutput> db = OpenDb (file, wal);
+    clock.Start ();
+    for (uint32_t i = 0; i < perRowRows; ++i)
+      {
+        sqlite3_stmt *stmt;
+        db->SpinPrepare (&stmt, insertCmd);
+        db->Bind (stmt, 1, MicroSeconds (i));
+        db->Bind (stmt, 2, i % 100);
+        db->Bind (stmt, 3, 1500U);
+        db->Bind (stmt, 4, std::string ("data"));
+        db->SpinExec (stmt);
+      }
+    Report ("row at a time", perRowRows, clock.End ());
+  }
+
+  for (bool background : {false, true})
+    {
+      Ptr<SQLiteOutput> db = OpenDb (file, wal);
+      clock.Start ();
+      {
+        SQLiteBatchInsert insert (db, insertCmd, batchSize, background);
+        for (uint32_t i = 0; i < rows; ++i)
+          {
+            insert.Insert (MicroSeconds (i), i % 100, 1500U, "data");
+          }
+        insert.Flush ();
+      }
+      std::ostringstream label;
+      label << "batched (" << batchSize << (background ? ", background)" : ")");
+      Report (label.str (), rows, clock.End ());
+    }
+
+  std::remove (file.c_str ());
+  std::remove ((file + "-wal").c_str ());
+  std::remove ((file + "-shm").c_str ());
+  return 0;
+}
@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "sqlite-batch-insert.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SQLiteBatchInsert");
+
+SQLiteBatchInsert::SQLiteBatchInsert (const Ptr<SQLiteOutput> &db,
+                                      const std::string &cmd,
+                                      uint32_t batchSize, bool background)
+  : m_db (db),
+    m_batchSize (batchSize),
+    m_background (background)
+{
+  NS_LOG_FUNCTION (this << cmd << batchSize << background);
+  NS_ABORT_MSG_IF (batchSize == 0, "The batch size must be positive");
+
+  bool ok = m_db->SpinPrepare (&m_stmt, cmd);
+  NS_ABORT_MSG_UNLESS (ok, "Failed to prepare " << cmd);
+  m_nColumns = static_cast<uint32_t> (sqlite3_bind_parameter_count (m_stmt));
+  NS_ABORT_MSG_IF (m_nColumns == 0, "No placeholders in " << cmd);
+  m_current.reserve (static_cast<std::size_t> (m_nColumns) * m_batchSize);
+
+  if (m_background)
+    {
+      m_worker = std::thread (&SQLiteBatchInsert::DoWork, this);
+    }
+}
+
+SQLiteBatchInsert::~SQLiteBatchInsert ()
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+  if (m_background)
+    {
+      {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        m_stop = true;
+      }
+      m_cv.notify_all ();
+      m_worker.join ();
+    }
+  SQLiteOutput::SpinFinalize (m_stmt);
+}
+
+uint64_t
+SQLiteBatchInsert::GetCommittedRows () const
+{
+  std::lock_guard<std::mutex> lock (m_mutex);
+  return m_committed;
+}
+
+uint32_t
+SQLiteBatchInsert::GetNColumns () const
+{
+  return m_nColumns;
+}
+
+void
+SQLiteBatchInsert::AppendInteger (int64_t value)
+{
+  Field f;
+  f.type = Field::INTEGER;
+  f.integer = value;
+  m_current.push_back (std::move (f));
+}
+
+void
+SQLiteBatchInsert::AppendReal (double value)
+{
+  Field f;
+  f.type = Field::REAL;
+  f.real = value;
+  m_current.push_back (std::move (f));
+}
+
+void
+SQLiteBatchInsert::AppendText (const std::string &value)
+{
+  Field f;
+  f.type = Field::TEXT;
+  f.text = value;
+  m_current.push_back (std::move (f));
+}
+
+void
+SQLiteBatchInsert::EndRow ()
+{
+  if (++m_rows < m_batchSize)
+    {
+      return;
+    }
+
+  if (m_background)
+    {
+      {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        m_pending.push_back (std::move (m_current));
+      }
+      m_cv.notify_all ();
+      m_current = Batch ();
+      m_current.reserve (static_cast<std::size_t> (m_nColumns) * m_batchSize);
+    }
+  else
+    {
+      Write (m_current);
+      m_current.clear ();
+    }
+  m_rows = 0;
+}
+
+void
+SQLiteBatchInsert::Flush ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!m_background)
+    {
+      if (m_rows > 0)
+        {
+          Write (m_current);
+          m_current.clear ();
+          m_rows = 0;
+        }
+      return;
+    }
+
+  std::unique_lock<std::mutex> lock (m_mutex);
+  if (m_rows > 0)
+    {
+      m_pending.push_back (std::move (m_current));
+      m_current = Batch ();
+      m_rows = 0;
+      m_cv.notify_all ();
+    }
+  m_cv.wait (lock, [this] { return m_pending.empty () && !m_busy; });
+}
+
+void
+SQLiteBatchInsert::Write (const Batch &batch)
+{
+  NS_LOG_FUNCTION (this << batch.size () / m_nColumns);
+
+  bool ok = m_db->SpinExec ("BEGIN TRANSACTION");
+  NS_ABORT_MSG_UNLESS (ok, "Failed to begin the transaction");
+
+  for (std::size_t row = 0; row < batch.size (); row += m_nColumns)
+    {
+      SQLiteOutput::SpinReset (m_stmt);
+      for (uint32_t col = 0; col < m_nColumns; ++col)
+        {
+          const Field &f = batch[row + col];
+          int pos = static_cast<int> (col + 1);
+          int rc = SQLITE_OK;
+          switch (f.type)
+            {
+            case Field::INTEGER:
+              rc = sqlite3_bind_int64 (m_stmt, pos, f.integer);
+              break;
+            case Field::REAL:
+              rc = sqlite3_bind_double (m_stmt, pos, f.real);
+              break;
+            case Field::TEXT:
+              rc = sqlite3_bind_text (m_stmt, pos, f.text.c_str (), -1, SQLITE_STATIC);
+              break;
+            }
+          NS_ABORT_MSG_UNLESS (rc == SQLITE_OK, "Failed to bind column " << pos);
+        }
+      int rc = SQLiteOutput::SpinStep (m_stmt);
+      NS_ABORT_MSG_UNLESS (rc == SQLITE_DONE, "Failed to insert a row, error " << rc);
+    }
+  // Do not keep references to the text fields of the batch
+  SQLiteOutput::SpinReset (m_stmt);
+  sqlite3_clear_bindings (m_stmt);
+
+  ok = m_db->SpinExec ("COMMIT TRANSACTION");
+  NS_ABORT_MSG_UNLESS (ok, "Failed to commit the transaction");
+
+  std::lock_guard<std::mutex> lock (m_mutex);
+  m_committed += batch.size () / m_nColumns;
+}
+
+void
+SQLiteBatchInsert::DoWork ()
+{
+  std::unique_lock<std::mutex> lock (m_mutex);
+  while (true)
+    {
+      m_cv.wait (lock, [this] { return m_stop || !m_pending.empty (); });
+      if (m_pending.empty ())
+        {
+          return;
+        }
+      Batch batch = std::move (m_pending.front ());
+      m_pending.pop_front ();
+      m_busy = true;
+
+      lock.unlock ();
+      Write (batch);
+      lock.lock ();
+
+      m_busy = false;
+      m_cv.notify_all ();
+    }
+}
+
+} // namespace ns3
@@ -49,6 +49,14 @@ SQLiteOutput::SetJournalInMemory ()
   SpinExec ("PRAGMA journal_mode = MEMORY");
 }
 
+void
+SQLiteOutput::SetWalMode ()
+{
+  NS_LOG_FUNCTION (this);
+  SpinExec ("PRAGMA journal_mode = WAL");
+  SpinExec ("PRAGMA synchronous = NORMAL");
+}
+
 bool
 SQLiteOutput::SpinExec (const std::string &cmd) const
 {
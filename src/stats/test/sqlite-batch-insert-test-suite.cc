@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/sqlite-batch-insert.h"
+#include "ns3/sqlite-output.h"
+#include "ns3/nstime.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Check that every buffered row reaches the database, with and
+ * without the background writer, whatever the batch boundaries.
+ */
+class SQLiteBatchInsertTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param batchSize rows per transaction
+   * \param background use the worker thread
+   */
+  SQLiteBatchInsertTestCase (uint32_t batchSize, bool background);
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_batchSize;   //!< Rows per transaction
+  bool m_background;      //!< Use the worker thread
+};
+
+SQLiteBatchInsertTestCase::SQLiteBatchInsertTestCase (uint32_t batchSize, bool background)
+  : TestCase ("Batch size " + std::to_string (batchSize) + (background ? ", background" : "")),
+    m_batchSize (batchSize),
+    m_background (background)
+{
+}
+
+void
+SQLiteBatchInsertTestCase::DoRun (void)
+{
+  const uint32_t nRows = 1000;
+  std::string file = CreateTempDirFilename ("sqlite-batch-insert-"
+                                            + std::to_string (m_batchSize)
+                                            + (m_background ? "-bg" : "") + ".db");
+  std::remove (file.c_str ());
+
+  Ptr<SQLiteOutput> db = Create<SQLiteOutput> (file, "ns-3-sqlite-batch-insert-test-sem");
+  db->SetWalMode ();
+  bool ok = db->SpinExec ("CREATE TABLE t (id INTEGER, value REAL, name TEXT, time REAL)");
+  NS_TEST_ASSERT_MSG_EQ (ok, true, "Cannot create the table");
+
+  {
+    SQLiteBatchInsert insert (db, "INSERT INTO t VALUES (?, ?, ?, ?)", m_batchSize, m_background);
+    NS_TEST_ASSERT_MSG_EQ (insert.GetNColumns (), 4, "Wrong number of columns");
+    for (uint32_t i = 0; i < nRows; ++i)
+      {
+        insert.Insert (i, i * 0.5, "row" + std::to_string (i), MilliSeconds (i));
+      }
+    insert.Flush ();
+    NS_TEST_EXPECT_MSG_EQ (insert.GetCommittedRows (), nRows, "Rows still buffered after Flush");
+
+    // Rows inserted after a flush are written by the destructor
+    insert.Insert (nRows, 0.0, "last", Seconds (0));
+  }
+
+  sqlite3_stmt *stmt;
+  ok = db->SpinPrepare (&stmt, "SELECT COUNT(*), SUM(id), SUM(value), MAX(time) FROM t");
+  NS_TEST_ASSERT_MSG_EQ (ok, true, "Cannot prepare the query");
+  NS_TEST_ASSERT_MSG_EQ (SQLiteOutput::SpinStep (stmt), SQLITE_ROW, "Query failed");
+  NS_TEST_EXPECT_MSG_EQ (db->RetrieveColumn<uint32_t> (stmt, 0), nRows + 1, "Wrong row count");
+  NS_TEST_EXPECT_MSG_EQ (db->RetrieveColumn<uint32_t> (stmt, 1), nRows * (nRows + 1) / 2, "Wrong id sum");
+  NS_TEST_EXPECT_MSG_EQ_TOL (db->RetrieveColumn<double> (stmt, 2), 0.25 * nRows * (nRows - 1), 1e-6,
+                             "Wrong value sum");
+  NS_TEST_EXPECT_MSG_EQ_TOL (db->RetrieveColumn<double> (stmt, 3), (nRows - 1) / 1000.0, 1e-9,
+                             "Wrong time");
+  SQLiteOutput::SpinFinalize (stmt);
+
+  ok = db->SpinPrepare (&stmt, "SELECT name FROM t WHERE id = 42");
+  NS_TEST_ASSERT_MSG_EQ (ok, true, "Cannot prepare the query");
+  NS_TEST_ASSERT_MSG_EQ (SQLiteOutput::SpinStep (stmt), SQLITE_ROW, "Query failed");
+  NS_TEST_EXPECT_MSG_EQ (std::string (reinterpret_cast<const char *> (sqlite3_column_text (stmt, 0))),
+                         "row42", "Wrong text column");
+  SQLiteOutput::SpinFinalize (stmt);
+
+  db = nullptr;
+  std::remove (file.c_str ());
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief SQLiteBatchInsert TestSuite
+ */
+class SQLiteBatchInsertTestSuite : public TestSuite
+{
+public:
+  SQLiteBatchInsertTestSuite ();
+};
+
+SQLiteBatchInsertTestSuite::SQLiteBatchInsertTestSuite ()
+  : TestSuite ("sqlite-batch-insert", UNIT)
+{
+  AddTestCase (new SQLiteBatchInsertTestCase (1, false), TestCase::QUICK);
+  AddTestCase (new SQLiteBatchInsertTestCase (64, false), TestCase::QUICK);
+  AddTestCase (new SQLiteBatchInsertTestCase (1000, false), TestCase::QUICK);
+  AddTestCase (new SQLiteBatchInsertTestCase (64, true), TestCase::QUICK);
+  AddTestCase (new SQLiteBatchInsertTestCase (5000, true), TestCase::QUICK);
+}
+
+static SQLiteBatchInsertTestSuite g_sqliteBatchInsertTestSuite; //!< Static variable for test initialization
@@ -19,20 +19,26 @@
 // directory, converted into system tests.  Writing a test suite
 // to test Csma itself is for further study.
 
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include "ns3/address.h"
 #include "ns3/application-container.h"
 #include "ns3/bridge-helper.h"
 #include "ns3/callback.h"
 #include "ns3/config.h"
+#include "ns3/csma-channel.h"
 #include "ns3/csma-helper.h"
 #include "ns3/csma-star-helper.h"
+#include "ns3/csma-net-device.h"
+#include "ns3/fluid-queue.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
 #include "ns3/ipv4-global-routing-helper.h"
 #include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/net-device-queue-interface.h"
 #include "ns3/node.h"
 #include "ns3/data-rate.h"
 #include "ns3/node-container.h"
@@ -42,11 +48,13 @@
 #include "ns3/packet-socket-helper.h"
 #include "ns3/packet-socket-address.h"
 #include "ns3/pointer.h"
+#include "ns3/queue-limits.h"
 #include "ns3/simple-channel.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/v4ping-helper.h"
 
 using namespace ns3;
@@ -1009,6 +1017,411 @@ CsmaRawIpSocketTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_count, 10, "Node 3 should have received 10 packets");
 }
 
+/**
+ * \ingroup system-tests-csma
+ * 
+ * \brief CSMA shared delivery test.
+ *
+ * Check that delivering the packets to all the devices of the channel in a
+ * single event does not change what the devices receive, nor when.
+ */
+class CsmaSharedDeliveryTestCase : public TestCase
+{
+public:
+  CsmaSharedDeliveryTestCase ();
+  virtual ~CsmaSharedDeliveryTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run the scenario.
+   * \param sharedDelivery the value of the SharedDelivery attribute
+   * \return the receptions, as "context time size" strings
+   */
+  std::vector<std::string> RunScenario (bool sharedDelivery);
+
+  /**
+   * Sink called when a packet is received by a device.
+   * \param context the context of the trace source
+   * \param p the received packet
+   */
+  void MacRx (std::string context, Ptr<const Packet> p);
+  std::vector<std::string> m_receptions; //!< Receptions of the current run
+};
+
+// Add some help text to this case to describe what it is intended to test
+CsmaSharedDeliveryTestCase::CsmaSharedDeliveryTestCase ()
+  : TestCase ("Shared delivery of packets on Carrier Sense Multiple Access (CSMA) networks")
+{
+}
+
+CsmaSharedDeliveryTestCase::~CsmaSharedDeliveryTestCase ()
+{
+}
+
+void
+CsmaSharedDeliveryTestCase::MacRx (std::string context, Ptr<const Packet> p)
+{
+  // The context is "/NodeList/<id>/DeviceList/..."
+  uint32_t nodeId = std::stoul (context.substr (std::string ("/NodeList/").size ()));
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetContext (), nodeId, "Reception in the wrong context: " << context);
+
+  std::ostringstream oss;
+  oss << context << " " << Simulator::Now ().GetNanoSeconds () << " " << p->GetSize ();
+  m_receptions.push_back (oss.str ());
+}
+
+// Network topology
+//
+//       n0    n1   n2   ...   n9
+//       |     |    |          |
+//       ===========================
+//                  LAN
+//
+// - CBR/UDP flows from n0 to n1 and from n9 to n0, plus ARP broadcasts
+//
+std::vector<std::string>
+CsmaSharedDeliveryTestCase::RunScenario (bool sharedDelivery)
+{
+  m_receptions.clear ();
+
+  NodeContainer nodes;
+  nodes.Create (10);
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", DataRateValue (5000000));
+  csma.SetChannelAttribute ("Delay", TimeValue (MilliSeconds (2)));
+  csma.SetChannelAttribute ("SharedDelivery", BooleanValue (sharedDelivery));
+  NetDeviceContainer devices = csma.Install (nodes);
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+
+  // Both runs must draw the same random numbers (e.g., for the ARP jitter
+  // and the backoff of the devices)
+  int64_t stream = 0;
+  stream += csma.AssignStreams (devices, stream);
+  stream += internet.AssignStreams (nodes, stream);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = ipv4.Assign (devices);
+
+  uint16_t port = 9;   // Discard port (RFC 863)
+
+  OnOffHelper onoff ("ns3::UdpSocketFactory", 
+                     Address (InetSocketAddress (interfaces.GetAddress (1), port)));
+  onoff.SetConstantRate (DataRate (500000));
+  ApplicationContainer app = onoff.Install (nodes.Get (0));
+  app.Start (Seconds (1.0));
+  app.Stop (Seconds (2.0));
+
+  onoff.SetAttribute ("Remote", 
+                      AddressValue (InetSocketAddress (interfaces.GetAddress (0), port)));
+  app = onoff.Install (nodes.Get (9));
+  app.Start (Seconds (1.1));
+  app.Stop (Seconds (2.0));
+  onoff.AssignStreams (NodeContainer (nodes.Get (0), nodes.Get (9)), stream);
+
+  PacketSinkHelper sink ("ns3::UdpSocketFactory",
+                         Address (InetSocketAddress (Ipv4Address::GetAny (), port)));
+  app = sink.Install (NodeContainer (nodes.Get (0), nodes.Get (1)));
+  app.Start (Seconds (0.0));
+
+  Config::Connect ("/NodeList/*/DeviceList/*/$ns3::CsmaNetDevice/MacRx",
+                   MakeCallback (&CsmaSharedDeliveryTestCase::MacRx, this));
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  return m_receptions;
+}
+
+void
+CsmaSharedDeliveryTestCase::DoRun (void)
+{
+  std::vector<std::string> perDevice = RunScenario (false);
+  std::vector<std::string> shared = RunScenario (true);
+
+  NS_TEST_ASSERT_MSG_GT (perDevice.size (), 200, "Too few packets received");
+  NS_TEST_ASSERT_MSG_EQ (shared.size (), perDevice.size (), "Different number of receptions");
+  for (std::size_t i = 0; i < perDevice.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (shared[i], perDevice[i], "Different reception " << i);
+    }
+}
+
+/**
+ * \ingroup system-tests-csma
+ * 
+ * \brief CSMA device with background traffic in a FluidQueue.
+ *
+ * A packet sent behind a background backlog must wait for the backlog to be
+ * drained, and the packets sent while the fluid buffer is full must be
+ * dropped with probability 1 - C/R.
+ */
+class CsmaFluidQueueTestCase : public TestCase
+{
+public:
+  CsmaFluidQueueTestCase ();
+  virtual ~CsmaFluidQueueTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Send a packet from a device.
+   * \param device the sending device
+   */
+  void SendOnePacket (Ptr<CsmaNetDevice> device);
+  /**
+   * Receive callback of the receiving device.
+   * \param dev the receiving device
+   * \param pkt the received packet
+   * \param mode the protocol number
+   * \param sender the sender address
+   * \return true
+   */
+  bool RxPacket (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender);
+  /**
+   * Sink called when the sending device drops a packet.
+   * \param p the dropped packet
+   */
+  void MacTxDrop (Ptr<const Packet> p);
+  std::vector<Time> m_rxTimes; //!< Receive time of each packet
+  uint32_t m_drops;            //!< Number of packets dropped by the sender
+};
+
+// Add some help text to this case to describe what it is intended to test
+CsmaFluidQueueTestCase::CsmaFluidQueueTestCase ()
+  : TestCase ("Background traffic in a FluidQueue on Carrier Sense Multiple Access (CSMA) networks"),
+    m_drops (0)
+{
+}
+
+CsmaFluidQueueTestCase::~CsmaFluidQueueTestCase ()
+{
+}
+
+void
+CsmaFluidQueueTestCase::SendOnePacket (Ptr<CsmaNetDevice> device)
+{
+  device->Send (Create<Packet> (100), device->GetBroadcast (), 0x800);
+}
+
+bool
+CsmaFluidQueueTestCase::RxPacket (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender)
+{
+  m_rxTimes.push_back (Simulator::Now ());
+  return true;
+}
+
+void
+CsmaFluidQueueTestCase::MacTxDrop (Ptr<const Packet> p)
+{
+  m_drops++;
+}
+
+void
+CsmaFluidQueueTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", DataRateValue (DataRate ("8Mbps")));
+  NetDeviceContainer devices = csma.Install (nodes);
+  Ptr<CsmaNetDevice> sender = DynamicCast<CsmaNetDevice> (devices.Get (0));
+  Ptr<CsmaNetDevice> receiver = DynamicCast<CsmaNetDevice> (devices.Get (1));
+
+  // Replace the queue of the sender through the TxQueue attribute
+  Ptr<FluidQueue<Packet> > queue = CreateObject<FluidQueue<Packet> > ();
+  queue->SetAttribute ("FluidBufferSize", UintegerValue (100000));
+  queue->SetAttribute ("MaxSize", QueueSizeValue (QueueSize ("100000p")));
+  queue->AssignStreams (1);
+  queue->AddBackgroundFlow (DataRate ("10Mbps"), Seconds (1), Seconds (2));
+  queue->AddBackgroundFlow (DataRate ("6Mbps"), Seconds (1), Seconds (1.2));
+  sender->SetAttribute ("TxQueue", PointerValue (queue));
+
+  receiver->SetReceiveCallback (MakeCallback (&CsmaFluidQueueTestCase::RxPacket, this));
+  sender->TraceConnectWithoutContext ("MacTxDrop", MakeCallback (&CsmaFluidQueueTestCase::MacTxDrop, this));
+
+  // No background yet, then 1 MB/s of excess for 10 ms: 10000 bytes, i.e.,
+  // 10 ms at 8 Mbps
+  Simulator::Schedule (Seconds (0.5), &CsmaFluidQueueTestCase::SendOnePacket, this, sender);
+  Simulator::Schedule (Seconds (1.01), &CsmaFluidQueueTestCase::SendOnePacket, this, sender);
+  // The buffer is full from 1.1 s, and 10 Mbps are offered after 1.2 s
+  const uint32_t n = 2000;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Simulator::Schedule (Seconds (1.3) + MicroSeconds (250 * i),
+                           &CsmaFluidQueueTestCase::SendOnePacket, this, sender);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_rxTimes.size (), n + 2 - m_drops, "Packets lost");
+  Time txTime = m_rxTimes[0] - Seconds (0.5);
+  NS_TEST_EXPECT_MSG_EQ_TOL ((m_rxTimes[1] - Seconds (1.01) - txTime).GetSeconds (), 0.01, 1e-5,
+                             "Packet not delayed by the background backlog");
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_drops / static_cast<double> (n), 0.2, 0.03, "Wrong loss ratio");
+}
+
+/**
+ * \ingroup system-tests-csma
+ * 
+ * \brief Queue limits recording the notifications of a CSMA device.
+ */
+class CsmaRecordingQueueLimits : public QueueLimits
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  virtual void Reset ()
+  {
+  }
+  virtual void Completed (uint32_t count)
+  {
+    m_completed.push_back (std::make_pair (Simulator::Now (), count));
+  }
+  virtual int32_t Available () const
+  {
+    return 0;
+  }
+  virtual void Queued (uint32_t count)
+  {
+    m_queued.push_back (count);
+  }
+
+  std::vector<std::pair<Time, uint32_t> > m_completed; //!< Time and size of the completions
+  std::vector<uint32_t> m_queued;                       //!< Size of the queued packets
+};
+
+TypeId
+CsmaRecordingQueueLimits::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CsmaRecordingQueueLimits")
+    .SetParent<QueueLimits> ()
+    .SetGroupName ("Csma")
+    .AddConstructor<CsmaRecordingQueueLimits> ()
+  ;
+  return tid;
+}
+
+/**
+ * \ingroup system-tests-csma
+ * 
+ * \brief CSMA notification of the completed transmissions to the queue limits.
+ *
+ * Every packet dequeued by the device must be reported exactly once, when
+ * its transmission completes, when it is aborted after too many backoffs, or
+ * when it is dropped because the send side of the device is disabled.
+ */
+class CsmaQueueLimitsTestCase : public TestCase
+{
+public:
+  CsmaQueueLimitsTestCase ();
+  virtual ~CsmaQueueLimitsTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Send a packet from a device.
+   * \param device the sending device
+   * \param size the size of the packet
+   */
+  void SendOnePacket (Ptr<CsmaNetDevice> device, uint32_t size);
+  /**
+   * Sink called when a device drops a packet at the physical layer.
+   * \param p the dropped packet
+   */
+  void PhyTxDrop (Ptr<const Packet> p);
+  std::vector<Time> m_drops; //!< Time of the drops of the first device
+};
+
+// Add some help text to this case to describe what it is intended to test
+CsmaQueueLimitsTestCase::CsmaQueueLimitsTestCase ()
+  : TestCase ("Notification of the completed transmissions on Carrier Sense Multiple Access (CSMA) networks")
+{
+}
+
+CsmaQueueLimitsTestCase::~CsmaQueueLimitsTestCase ()
+{
+}
+
+void
+CsmaQueueLimitsTestCase::SendOnePacket (Ptr<CsmaNetDevice> device, uint32_t size)
+{
+  device->Send (Create<Packet> (size), device->GetBroadcast (), 0x800);
+}
+
+void
+CsmaQueueLimitsTestCase::PhyTxDrop (Ptr<const Packet> p)
+{
+  m_drops.push_back (Simulator::Now ());
+}
+
+void
+CsmaQueueLimitsTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", DataRateValue (DataRate ("8Mbps")));
+  NetDeviceContainer devices = csma.Install (nodes);
+  Ptr<CsmaNetDevice> device = DynamicCast<CsmaNetDevice> (devices.Get (0));
+  Ptr<CsmaNetDevice> other = DynamicCast<CsmaNetDevice> (devices.Get (1));
+
+  Ptr<CsmaRecordingQueueLimits> limits = CreateObject<CsmaRecordingQueueLimits> ();
+  device->GetObject<NetDeviceQueueInterface> ()->GetTxQueue (0)->SetQueueLimits (limits);
+  device->TraceConnectWithoutContext ("PhyTxDrop", MakeCallback (&CsmaQueueLimitsTestCase::PhyTxDrop, this));
+
+  // Give up after a single backoff of 10 us at most
+  device->SetBackoffParams (MicroSeconds (10), 1, 1, 1, 1);
+
+  // 1000 bytes (with the Ethernet header and trailer) take 1 ms at 8 Mbps:
+  // the first packet is transmitted, the second one is aborted since the
+  // other device keeps the channel busy, the third one is transmitted, and
+  // the fourth one, queued behind it, is dropped since the send side of the
+  // device is disabled meanwhile.
+  Simulator::Schedule (Seconds (1), &CsmaQueueLimitsTestCase::SendOnePacket, this, device, 982);
+  Simulator::Schedule (Seconds (2), &CsmaQueueLimitsTestCase::SendOnePacket, this, other, 982);
+  Simulator::Schedule (Seconds (2) + MicroSeconds (100), &CsmaQueueLimitsTestCase::SendOnePacket, this, device, 982);
+  Simulator::Schedule (Seconds (3), &CsmaQueueLimitsTestCase::SendOnePacket, this, device, 982);
+  Simulator::Schedule (Seconds (3), &CsmaQueueLimitsTestCase::SendOnePacket, this, device, 982);
+  Simulator::Schedule (Seconds (3) + MicroSeconds (500), &CsmaNetDevice::SetSendEnable, device, false);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (limits->m_queued.size (), 4, "Wrong number of queued packets");
+  NS_TEST_ASSERT_MSG_EQ (limits->m_completed.size (), 4, "Wrong number of completions");
+  NS_TEST_ASSERT_MSG_EQ (m_drops.size (), 2, "Wrong number of drops");
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (limits->m_queued[i], 1000, "Wrong size of queued packet " << i);
+      NS_TEST_EXPECT_MSG_EQ (limits->m_completed[i].second, 1000, "Wrong size of completion " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (limits->m_completed[0].first, Seconds (1) + MilliSeconds (1),
+                         "The transmission was not reported when completed");
+  NS_TEST_EXPECT_MSG_EQ (limits->m_completed[1].first, m_drops[0],
+                         "The aborted transmission was not reported when aborted");
+  NS_TEST_EXPECT_MSG_LT (limits->m_completed[1].first, Seconds (2) + MilliSeconds (1),
+                         "The transmission was not aborted during the other transmission");
+  NS_TEST_EXPECT_MSG_EQ (limits->m_completed[2].first, Seconds (3) + MilliSeconds (1),
+                         "The transmission was not reported when completed");
+  NS_TEST_EXPECT_MSG_EQ (limits->m_completed[3].first, m_drops[1],
+                         "The dropped packet was not reported when dropped");
+  NS_TEST_EXPECT_MSG_GT (limits->m_completed[3].first, limits->m_completed[2].first,
+                         "The dropped packet was not reported after the previous one");
+}
+
 /**
  * \ingroup system-tests-csma
  * 
@@ -1230,6 +1643,9 @@ CsmaSystemTestSuite::CsmaSystemTestSuite ()
   AddTestCase (new CsmaPingTestCase, TestCase::QUICK);
   AddTestCase (new CsmaRawIpSocketTestCase, TestCase::QUICK);
   AddTestCase (new CsmaStarTestCase, TestCase::QUICK);
+  AddTestCase (new CsmaSharedDeliveryTestCase, TestCase::QUICK);
+  AddTestCase (new CsmaFluidQueueTestCase, TestCase::QUICK);
+  AddTestCase (new CsmaQueueLimitsTestCase, TestCase::QUICK);
 }
 
 /// Do not forget to allocate an instance of this TestSuite
@@ -0,0 +1,306 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "ns3/error-model.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/csma-helper.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv6-address-helper.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/bulk-send-helper.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/node-container.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("Ns3TcpSegmentationOffloadTest");
+
+/**
+ * \ingroup system-tests-tcp
+ *
+ * \brief Transfer with TCP segmentation offload and receive coalescing.
+ *
+ * A bulk transfer is run with super-segments, over a device which splits
+ * them (point-to-point or CSMA) or over a device which does not support it
+ * (simple), where the network layer splits them.  The test checks that all
+ * the data is received, that no frame larger than the MTU is sent, that
+ * super-segments are actually handed down, and that the receiver gets
+ * coalesced packets if and only if the device coalesces them.
+ */
+class Ns3TcpSegmentationOffloadTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   *
+   * \param device The device type: "p2p", "csma" or "simple".
+   * \param ipv6 Whether IPv6 is used instead of IPv4.
+   * \param coalescing Whether the receiving device coalesces the frames.
+   * \param errorRate The packet error rate of the receiving device.
+   */
+  Ns3TcpSegmentationOffloadTestCase (std::string device, bool ipv6, bool coalescing, double errorRate);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Record a frame sent by the sending device.
+   * \param p The frame.
+   */
+  void PhyTx (Ptr<const Packet> p);
+  /**
+   * Record an IPv4 packet sent by the sender.
+   * \param p The packet, with its IPv4 header.
+   * \param ipv4 The IPv4 protocol.
+   * \param interface The interface index.
+   */
+  void Ipv4Tx (Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface);
+  /**
+   * Record an IPv6 packet sent by the sender.
+   * \param p The packet, with its IPv6 header.
+   * \param ipv6 The IPv6 protocol.
+   * \param interface The interface index.
+   */
+  void Ipv6Tx (Ptr<const Packet> p, Ptr<Ipv6> ipv6, uint32_t interface);
+  /**
+   * Record a packet received by the sink.
+   * \param p The packet.
+   * \param address The address of the sender.
+   */
+  void SinkRx (Ptr<const Packet> p, const Address &address);
+
+  std::string m_device;     //!< Device type.
+  bool m_ipv6;              //!< Whether IPv6 is used.
+  bool m_coalescing;        //!< Whether the receiving device coalesces the frames.
+  double m_errorRate;       //!< Packet error rate.
+  uint32_t m_maxFrame;      //!< Largest frame sent, without link layer header.
+  uint32_t m_maxIp;         //!< Largest packet sent by the network layer.
+  uint32_t m_maxRx;         //!< Largest packet received by the sink.
+};
+
+Ns3TcpSegmentationOffloadTestCase::Ns3TcpSegmentationOffloadTestCase (std::string device, bool ipv6,
+                                                                      bool coalescing, double errorRate)
+  : TestCase ("Check TCP segmentation offload over " + device + (ipv6 ? " with IPv6" : " with IPv4")
+              + (coalescing ? ", with" : ", without") + " receive coalescing"
+              + (errorRate > 0 ? " and losses" : "")),
+    m_device (device),
+    m_ipv6 (ipv6),
+    m_coalescing (coalescing),
+    m_errorRate (errorRate),
+    m_maxFrame (0),
+    m_maxIp (0),
+    m_maxRx (0)
+{
+}
+
+void
+Ns3TcpSegmentationOffloadTestCase::PhyTx (Ptr<const Packet> p)
+{
+  // PPP header, or Ethernet header and trailer
+  uint32_t overhead = m_device == "p2p" ? 2 : 18;
+  m_maxFrame = std::max (m_maxFrame, p->GetSize () - overhead);
+}
+
+void
+Ns3TcpSegmentationOffloadTestCase::Ipv4Tx (Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+  m_maxIp = std::max (m_maxIp, p->GetSize ());
+  if (m_device == "simple")
+    {
+      m_maxFrame = std::max (m_maxFrame, p->GetSize ());
+    }
+}
+
+void
+Ns3TcpSegmentationOffloadTestCase::Ipv6Tx (Ptr<const Packet> p, Ptr<Ipv6> ipv6, uint32_t interface)
+{
+  m_maxIp = std::max (m_maxIp, p->GetSize ());
+  if (m_device == "simple")
+    {
+      m_maxFrame = std::max (m_maxFrame, p->GetSize ());
+    }
+}
+
+void
+Ns3TcpSegmentationOffloadTestCase::SinkRx (Ptr<const Packet> p, const Address &address)
+{
+  m_maxRx = std::max (m_maxRx, p->GetSize ());
+}
+
+void
+Ns3TcpSegmentationOffloadTestCase::DoRun (void)
+{
+  const uint32_t segmentSize = 1400;
+  const uint32_t totalBytes = 2000000;
+  const uint16_t port = 50000;
+
+  Config::SetDefault ("ns3::TcpSocket::SegmentSize", UintegerValue (segmentSize));
+  Config::SetDefault ("ns3::TcpSocket::SndBufSize", UintegerValue (1 << 20));
+  Config::SetDefault ("ns3::TcpSocket::RcvBufSize", UintegerValue (1 << 20));
+  Config::SetDefault ("ns3::TcpSocketBase::SegmentationOffloadSize", UintegerValue (65000));
+
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  NetDeviceContainer devices;
+  if (m_device == "p2p")
+    {
+      PointToPointHelper pointToPoint;
+      pointToPoint.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+      pointToPoint.SetDeviceAttribute ("ReceiveCoalescing", BooleanValue (m_coalescing));
+      pointToPoint.SetChannelAttribute ("Delay", StringValue ("5ms"));
+      devices = pointToPoint.Install (nodes);
+      devices.Get (0)->TraceConnectWithoutContext ("PhyTxBegin",
+        MakeCallback (&Ns3TcpSegmentationOffloadTestCase::PhyTx, this));
+    }
+  else if (m_device == "csma")
+    {
+      CsmaHelper csma;
+      csma.SetChannelAttribute ("DataRate", StringValue ("100Mbps"));
+      csma.SetChannelAttribute ("Delay", StringValue ("5ms"));
+      csma.SetDeviceAttribute ("ReceiveCoalescing", BooleanValue (m_coalescing));
+      devices = csma.Install (nodes);
+      devices.Get (0)->TraceConnectWithoutContext ("PhyTxBegin",
+        MakeCallback (&Ns3TcpSegmentationOffloadTestCase::PhyTx, this));
+    }
+  else
+    {
+      SimpleNetDeviceHelper simple;
+      simple.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+      simple.SetChannelAttribute ("Delay", StringValue ("5ms"));
+      simple.SetNetDevicePointToPointMode (true);
+      devices = simple.Install (nodes);
+      for (uint32_t i = 0; i < devices.GetN (); i++)
+        {
+          devices.Get (i)->SetMtu (1500);
+        }
+    }
+
+  if (m_errorRate > 0)
+    {
+      Ptr<RateErrorModel> errorModel = CreateObject<RateErrorModel> ();
+      errorModel->SetUnit (RateErrorModel::ERROR_UNIT_PACKET);
+      errorModel->SetRate (m_errorRate);
+      devices.Get (1)->SetAttribute ("ReceiveErrorModel", PointerValue (errorModel));
+    }
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+
+  Address sinkAddress;
+  Address anyAddress;
+  if (m_ipv6)
+    {
+      Ipv6AddressHelper address;
+      address.SetBase ("2001:db8::", Ipv6Prefix (64));
+      Ipv6InterfaceContainer interfaces = address.Assign (devices);
+      sinkAddress = Inet6SocketAddress (interfaces.GetAddress (1, 1), port);
+      anyAddress = Inet6SocketAddress (Ipv6Address::GetAny (), port);
+      nodes.Get (0)->GetObject<Ipv6L3Protocol> ()->TraceConnectWithoutContext ("Tx",
+        MakeCallback (&Ns3TcpSegmentationOffloadTestCase::Ipv6Tx, this));
+    }
+  else
+    {
+      Ipv4AddressHelper address;
+      address.SetBase ("10.1.1.0", "255.255.255.0");
+      Ipv4InterfaceContainer interfaces = address.Assign (devices);
+      sinkAddress = InetSocketAddress (interfaces.GetAddress (1), port);
+      anyAddress = InetSocketAddress (Ipv4Address::GetAny (), port);
+      nodes.Get (0)->GetObject<Ipv4L3Protocol> ()->TraceConnectWithoutContext ("Tx",
+        MakeCallback (&Ns3TcpSegmentationOffloadTestCase::Ipv4Tx, this));
+    }
+
+  BulkSendHelper source ("ns3::TcpSocketFactory", sinkAddress);
+  source.SetAttribute ("MaxBytes", UintegerValue (totalBytes));
+  ApplicationContainer sourceApps = source.Install (nodes.Get (0));
+  sourceApps.Start (Seconds (1.0));
+
+  PacketSinkHelper sink ("ns3::TcpSocketFactory", anyAddress);
+  ApplicationContainer sinkApps = sink.Install (nodes.Get (1));
+  sinkApps.Start (Seconds (0.0));
+  Ptr<PacketSink> packetSink = DynamicCast<PacketSink> (sinkApps.Get (0));
+  packetSink->TraceConnectWithoutContext ("Rx", MakeCallback (&Ns3TcpSegmentationOffloadTestCase::SinkRx, this));
+
+  Simulator::Stop (Seconds (20));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  Config::SetDefault ("ns3::TcpSocketBase::SegmentationOffloadSize", UintegerValue (0));
+
+  NS_TEST_ASSERT_MSG_EQ (packetSink->GetTotalRx (), totalBytes, "Not all the data was received");
+  NS_TEST_ASSERT_MSG_GT (m_maxFrame, 0, "No frame was sent");
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (m_maxFrame, 1500, "A frame larger than the MTU was sent");
+  if (m_device == "simple")
+    {
+      NS_TEST_ASSERT_MSG_LT_OR_EQ (m_maxIp, 1500, "The network layer did not split the super-segments");
+      NS_TEST_ASSERT_MSG_LT_OR_EQ (m_maxRx, segmentSize, "Segments were coalesced without device support");
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_GT (m_maxIp, 1500, "No super-segment was handed down to the device");
+      if (m_coalescing)
+        {
+          NS_TEST_ASSERT_MSG_GT (m_maxRx, segmentSize, "No segments were coalesced");
+        }
+      else
+        {
+          NS_TEST_ASSERT_MSG_LT_OR_EQ (m_maxRx, segmentSize, "Segments were coalesced while disabled");
+        }
+    }
+}
+
+/**
+ * \ingroup system-tests-tcp
+ *
+ * TestSuite for TCP segmentation offload and receive coalescing.
+ */
+class Ns3TcpSegmentationOffloadTestSuite : public TestSuite
+{
+public:
+  Ns3TcpSegmentationOffloadTestSuite ();
+};
+
+Ns3TcpSegmentationOffloadTestSuite::Ns3TcpSegmentationOffloadTestSuite ()
+  : TestSuite ("ns3-tcp-segmentation-offload", SYSTEM)
+{
+  AddTestCase (new Ns3TcpSegmentationOffloadTestCase ("p2p", false, true, 0), TestCase::QUICK);
+  AddTestCase (new Ns3TcpSegmentationOffloadTestCase ("p2p", false, false, 0), TestCase::QUICK);
+  AddTestCase (new Ns3TcpSegmentationOffloadTestCase ("p2p", false, true, 0.001), TestCase::QUICK);
+  AddTestCase (new Ns3TcpSegmentationOffloadTestCase ("p2p", true, true, 0), TestCase::QUICK);
+  AddTestCase (new Ns3TcpSegmentationOffloadTestCase ("csma", false, true, 0), TestCase::QUICK);
+  AddTestCase (new Ns3TcpSegmentationOffloadTestCase ("csma", true, true, 0.001), TestCase::QUICK);
+  AddTestCase (new Ns3TcpSegmentationOffloadTestCase ("simple", false, true, 0), TestCase::QUICK);
+  AddTestCase (new Ns3TcpSegmentationOffloadTestCase ("simple", true, true, 0), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static Ns3TcpSegmentationOffloadTestSuite g_ns3TcpSegmentationOffloadTestSuite;
@@ -229,6 +229,12 @@ VisualSimulatorImpl::GetContext (void) const
   return m_simulator->GetContext ();
 }
 
+void
+VisualSimulatorImpl::SetContext (uint32_t context)
+{
+  m_simulator->SetContext (context);
+}
+
 uint64_t
 VisualSimulatorImpl::GetEventCount (void) const
 {
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+## -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+"""
+Run the bql-latency-benchmark example for FqCoDel and FqCobalt, with and
+without byte queue limits, at 1, 10 and 100 Gb/s, and print the ping RTT
+statistics (in ms) and the goodput as a CSV table.
+
+The simulated duration shrinks as the rate grows, so that every run
+simulates a comparable number of packets.  Each configuration is run with
+the RngRun values 1 to --runs, so that the results are reproducible.
+
+Usage (from the top-level directory, after building the examples):
+
+    ./utils/bql-benchmark.py [--runs 3] [--output results.csv]
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+# Bottleneck rate and simulated duration, in seconds
+RATES = [("1Gbps", 2.0), ("10Gbps", 0.5), ("100Gbps", 0.1)]
+QUEUE_DISCS = ["FqCoDel", "FqCobalt"]
+
+
+def run_one(ns3, queue_disc, bql, bandwidth, duration, run, extra_args):
+    program = ("bql-latency-benchmark --csv=1 --queueDiscType=%s --bql=%d "
+               "--bandwidth=%s --simDuration=%g --warmup=%g --RngRun=%d %s"
+               % (queue_disc, bql, bandwidth, duration, duration / 10, run,
+                  " ".join(extra_args)))
+    output = subprocess.run([ns3, "run", program, "--no-build", "--quiet"],
+                            check=True, stdout=subprocess.PIPE,
+                            universal_newlines=True).stdout
+    # The last two lines hold the names of the columns and the results
+    return output.strip().splitlines()[-2:]
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--runs", type=int, default=1,
+                        help="number of runs (RngRun values) per configuration")
+    parser.add_argument("--output", help="also write the results to this file")
+    parser.add_argument("extra", nargs="*",
+                        help="additional arguments for the example, "
+                             "such as --netdevicesQueueSize=1000")
+    args = parser.parse_args(argv)
+
+    ns3 = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir, "ns3")
+    lines = []
+    for bandwidth, duration in RATES:
+        for queue_disc in QUEUE_DISCS:
+            for bql in (0, 1):
+                for run in range(1, args.runs + 1):
+                    header, line = run_one(ns3, queue_disc, bql, bandwidth, duration, run, args.extra)
+                    if not lines:
+                        lines.append(header)
+                        print(header)
+                    lines.append(line)
+                    print(line)
+                    sys.stdout.flush()
+
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write("\n".join(lines) + "\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))